@@ -0,0 +1,17 @@
+#include "SpoutBatch.h"
+
+void FSpoutFrameBatch::Execute(TConstArrayView<FSpoutStreamRef> Streams)
+{
+	for (const FSpoutStreamRef& Stream : Streams)
+		Stream->Process_RenderThread(*this);
+
+	for (ISpoutSubmitQueue* Queue : SubmitQueues)
+		Queue->Submit();
+
+	for (const FSpoutStreamRef& Stream : Streams)
+		Stream->PostSubmit_RenderThread(*this);
+
+	NumStreams += Streams.Num();
+	NumSubmits += SubmitQueues.Num();
+	SubmitQueues.Reset();
+}
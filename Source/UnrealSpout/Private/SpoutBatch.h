@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FRHICommandListImmediate;
+class FSpoutFrameBatch;
+
+/** A device queue that needs an explicit submit after copies were recorded on it (e.g. an 11on12 context). */
+class ISpoutSubmitQueue
+{
+public:
+	virtual ~ISpoutSubmitQueue() = default;
+
+	/** Hands recorded work to the GPU. Must not wait for it to complete. */
+	virtual void Submit() = 0;
+};
+
+/** A sender or receiver serviced by the per-frame Spout batch on the render thread. */
+class ISpoutStream
+{
+public:
+	virtual ~ISpoutStream() = default;
+
+	/** Records this stream's copy. Must not flush; call Batch.RequestSubmit instead. */
+	virtual void Process_RenderThread(FSpoutFrameBatch& Batch) = 0;
+
+	/** Runs after every requested queue has been submitted once, e.g. to publish sender info. */
+	virtual void PostSubmit_RenderThread(FSpoutFrameBatch& Batch) {}
+};
+
+using FSpoutStreamRef = TSharedRef<ISpoutStream, ESPMode::ThreadSafe>;
+
+/**
+ * One frame's worth of Spout work. Every stream records its copy, each distinct
+ * submit queue is submitted exactly once, then every stream gets its post-submit call.
+ * So the number of submits per frame depends on the number of queues, not streams.
+ */
+class FSpoutFrameBatch
+{
+public:
+	explicit FSpoutFrameBatch(FRHICommandListImmediate* InRHICmdList = nullptr)
+		: RHICmdList(InRHICmdList)
+	{}
+
+	/** Asks for Queue to be submitted once after all streams have recorded. */
+	void RequestSubmit(ISpoutSubmitQueue* Queue)
+	{
+		if (Queue)
+			SubmitQueues.AddUnique(Queue);
+	}
+
+	/** Null when the batch runs outside the render thread (e.g. with stub streams). */
+	FRHICommandListImmediate* GetRHICmdList() const { return RHICmdList; }
+
+	void Execute(TConstArrayView<FSpoutStreamRef> Streams);
+
+	int32 GetNumStreams() const { return NumStreams; }
+	int32 GetNumSubmits() const { return NumSubmits; }
+
+private:
+	FRHICommandListImmediate* RHICmdList;
+	TArray<ISpoutSubmitQueue*, TInlineAllocator<4>> SubmitQueues;
+	int32 NumStreams = 0;
+	int32 NumSubmits = 0;
+};
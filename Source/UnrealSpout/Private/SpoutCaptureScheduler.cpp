@@ -0,0 +1,112 @@
+#include "SpoutCaptureScheduler.h"
+
+namespace
+{
+	/** Fractional golden ratio: successive multiples are spread evenly over [0, 1). */
+	constexpr double GoldenFraction = 0.6180339887498949;
+}
+
+int32 FSpoutCaptureScheduler::Add(const FSpoutCaptureSettings& Settings)
+{
+	FEntry Entry;
+	Entry.Settings = Settings;
+	Entry.Order = NextOrder++;
+	ResolvePhase(Entry);
+	return Entries.Add(MoveTemp(Entry));
+}
+
+void FSpoutCaptureScheduler::Update(int32 Handle, const FSpoutCaptureSettings& Settings)
+{
+	if (!Entries.IsValidIndex(Handle))
+		return;
+
+	FEntry& Entry = Entries[Handle];
+	if (Entry.Settings == Settings)
+		return;
+
+	Entry.Settings = Settings;
+	Entry.bStarted = false;
+	ResolvePhase(Entry);
+}
+
+void FSpoutCaptureScheduler::Remove(int32 Handle)
+{
+	if (Entries.IsValidIndex(Handle))
+		Entries.RemoveAt(Handle);
+}
+
+void FSpoutCaptureScheduler::ResolvePhase(FEntry& Entry) const
+{
+	Entry.Phase = Entry.Settings.bAutoPhase
+		? FMath::Frac(Entry.Order * GoldenFraction)
+		: FMath::Clamp(static_cast<double>(Entry.Settings.PhaseOffset), 0.0, 1.0 - UE_DOUBLE_KINDA_SMALL_NUMBER);
+}
+
+void FSpoutCaptureScheduler::BeginFrame(uint64 Frame, double Time, int32 MaxCapturesPerFrame)
+{
+	struct FDue
+	{
+		double Lateness;
+		int32 Order;
+		int32 Handle;
+	};
+	TArray<FDue, TInlineAllocator<16>> Due;
+
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		FEntry& Entry = *It;
+		Entry.bCapture = false;
+
+		const int32 EveryNth = FMath::Max(Entry.Settings.EveryNth, 1);
+		const uint64 PhaseFrames = static_cast<uint64>(Entry.Phase * EveryNth);
+		if ((Frame + PhaseFrames) % EveryNth != 0)
+			continue;
+
+		double Lateness = 0.0;
+		if (Entry.Settings.TargetFps > 0.0f)
+		{
+			const double Period = 1.0 / Entry.Settings.TargetFps;
+			if (!Entry.bStarted)
+			{
+				// Without an EveryNth divider the phase moves the first due time instead.
+				Entry.NextDue = Time + (EveryNth > 1 ? 0.0 : Entry.Phase * Period);
+				Entry.bStarted = true;
+			}
+
+			if (Time + DueTolerance < Entry.NextDue)
+				continue;
+
+			Lateness = Time - Entry.NextDue;
+		}
+
+		Due.Add({ Lateness, Entry.Order, It.GetIndex() });
+	}
+
+	NumDue = Due.Num();
+
+	// Most overdue first; registration order keeps ties deterministic.
+	Due.Sort([](const FDue& A, const FDue& B)
+	{
+		return A.Lateness != B.Lateness ? A.Lateness > B.Lateness : A.Order < B.Order;
+	});
+
+	NumCaptures = MaxCapturesPerFrame > 0 ? FMath::Min(MaxCapturesPerFrame, Due.Num()) : Due.Num();
+	for (int32 i = 0; i < NumCaptures; ++i)
+	{
+		FEntry& Entry = Entries[Due[i].Handle];
+		Entry.bCapture = true;
+
+		if (Entry.Settings.TargetFps > 0.0f)
+		{
+			// Stay on the phase grid; after a hitch skip the missed slots rather than burst through them.
+			const double Period = 1.0 / Entry.Settings.TargetFps;
+			const double Missed = FMath::Max(0.0, FMath::FloorToDouble((Time + DueTolerance - Entry.NextDue) / Period));
+			Entry.NextDue += Period * (Missed + 1.0);
+		}
+	}
+}
+
+bool FSpoutCaptureScheduler::ShouldCapture(int32 Handle) const
+{
+	return Entries.IsValidIndex(Handle) && Entries[Handle].bCapture;
+}
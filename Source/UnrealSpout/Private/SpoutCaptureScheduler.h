@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/SparseArray.h"
+#include "SpoutTypes.h"
+
+/**
+ * Decides, once per game frame, which senders capture. Each sender has its own rate
+ * (TargetFps), frame divider (EveryNth) and phase; senders left on auto phase are
+ * spread over the period with a golden-ratio sequence so equal-rate senders do not
+ * all land on the same frame. An optional per-frame cap defers the surplus to later
+ * frames, most overdue first.
+ *
+ * Engine independent and deterministic: frame number and time are passed in.
+ */
+class FSpoutCaptureScheduler
+{
+public:
+	/** Due times within this many seconds count as reached, absorbing frame-time jitter. */
+	static constexpr double DueTolerance = 0.001;
+
+	int32 Add(const FSpoutCaptureSettings& Settings);
+	void Update(int32 Handle, const FSpoutCaptureSettings& Settings);
+	void Remove(int32 Handle);
+
+	/** Schedules frame Frame at Time (seconds). MaxCapturesPerFrame 0 = no cap. */
+	void BeginFrame(uint64 Frame, double Time, int32 MaxCapturesPerFrame = 0);
+
+	/** Whether Handle captures in the frame passed to the last BeginFrame. */
+	bool ShouldCapture(int32 Handle) const;
+
+	int32 Num() const { return Entries.Num(); }
+
+	/** Senders that were due in the last frame, and how many of them were let through. */
+	int32 GetNumDue() const { return NumDue; }
+	int32 GetNumCaptures() const { return NumCaptures; }
+
+private:
+	struct FEntry
+	{
+		FSpoutCaptureSettings Settings;
+		/** Fraction of the period, [0, 1). */
+		double Phase = 0.0;
+		double NextDue = 0.0;
+		bool bStarted = false;
+		bool bCapture = false;
+		/** Registration order, feeds the auto phase sequence and breaks ties. */
+		int32 Order = 0;
+	};
+
+	void ResolvePhase(FEntry& Entry) const;
+
+	TSparseArray<FEntry> Entries;
+	int32 NextOrder = 0;
+	int32 NumDue = 0;
+	int32 NumCaptures = 0;
+};
@@ -0,0 +1,103 @@
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/OutputDevice.h"
+
+#include "SpoutCaptureScheduler.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace
+{
+	constexpr double FrameRate = 60.0;
+	const float Rates[] = { 5.0f, 10.0f, 15.0f, 20.0f, 30.0f };
+
+	struct FSchedulerRun
+	{
+		double Seconds = 0.0;
+		int32 MaxPerFrame = 0;
+		uint64 Captures = 0;
+		/** Largest gap between achieved and requested rate over all rate-limited senders, in fps. */
+		double WorstRateError = 0.0;
+	};
+
+	/**
+	 * Runs NumSenders senders with random rates and dividers for Frames frames of a 60 Hz
+	 * clock whose frame time jitters by up to 10%, timing only the scheduler.
+	 */
+	FSchedulerRun RunScheduler(int32 NumSenders, int32 Frames, bool bAutoPhase, int32 MaxCapturesPerFrame)
+	{
+		FSpoutCaptureScheduler Scheduler;
+		FRandomStream Random(NumSenders);
+		TArray<FSpoutCaptureSettings> Settings;
+		TArray<int32> Handles;
+		for (int32 i = 0; i < NumSenders; ++i)
+		{
+			FSpoutCaptureSettings& Sender = Settings.AddDefaulted_GetRef();
+			Sender.TargetFps = Rates[Random.RandRange(0, UE_ARRAY_COUNT(Rates) - 1)];
+			Sender.EveryNth = Random.RandRange(0, 3) == 0 ? 2 : 1;
+			Sender.bAutoPhase = bAutoPhase;
+			Handles.Add(Scheduler.Add(Sender));
+		}
+
+		TArray<uint64> PerSender;
+		PerSender.SetNumZeroed(NumSenders);
+		FSchedulerRun Run;
+		double Time = 0.0;
+		for (int32 Frame = 0; Frame < Frames; ++Frame)
+		{
+			const double Start = FPlatformTime::Seconds();
+			Scheduler.BeginFrame(Frame, Time, MaxCapturesPerFrame);
+			Run.Seconds += FPlatformTime::Seconds() - Start;
+
+			int32 Captured = 0;
+			for (int32 i = 0; i < NumSenders; ++i)
+			{
+				if (Scheduler.ShouldCapture(Handles[i]))
+				{
+					++PerSender[i];
+					++Captured;
+				}
+			}
+			Run.MaxPerFrame = FMath::Max(Run.MaxPerFrame, Captured);
+			Run.Captures += Captured;
+			Time += (1.0 + Random.FRandRange(-0.1f, 0.1f)) / FrameRate;
+		}
+
+		for (int32 i = 0; i < NumSenders; ++i)
+		{
+			// A divider caps the reachable rate, so only compare where it doesn't.
+			const double Reachable = FrameRate / Settings[i].EveryNth;
+			if (Settings[i].TargetFps < Reachable)
+				Run.WorstRateError = FMath::Max(Run.WorstRateError, FMath::Abs(PerSender[i] / Time - Settings[i].TargetFps));
+		}
+		return Run;
+	}
+
+	void BenchmarkCaptureScheduler(const TArray<FString>& Args, FOutputDevice& Ar)
+	{
+		const int32 Frames = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 36000;
+
+		for (const int32 NumSenders : { 4, 16, 64 })
+		{
+			for (const bool bAutoPhase : { false, true })
+			{
+				for (const int32 Cap : { 0, 4 })
+				{
+					const FSchedulerRun Run = RunScheduler(NumSenders, Frames, bAutoPhase, Cap);
+					Ar.Logf(TEXT("  %2d senders  %s  cap %d  %7.1f ns/frame  %5.2f captures/frame  max %2d  worst rate error %5.2f fps"),
+						NumSenders, bAutoPhase ? TEXT("auto phase ") : TEXT("fixed phase"), Cap, Run.Seconds / Frames * 1.0e9,
+						static_cast<double>(Run.Captures) / Frames, Run.MaxPerFrame, Run.WorstRateError);
+				}
+			}
+		}
+	}
+
+	FAutoConsoleCommandWithArgsAndOutputDevice BenchmarkCaptureSchedulerCommand(
+		TEXT("Spout.BenchmarkCaptureScheduler"),
+		TEXT("Schedules 4, 16 and 64 senders at random rates against a jittery 60 Hz clock, with fixed and auto phase, with and without a cap of 4 captures per frame, and reports the scheduling cost, how many captures land on one frame and how far the achieved rates drift. Optional argument: frames per run (default 36000)."),
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&BenchmarkCaptureScheduler));
+}
+
+#endif
@@ -0,0 +1,123 @@
+#include "SpoutConsumerTable.h"
+
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+
+#include "SpoutSharedAtomics.h"
+#include "SpoutSharedMemoryRegion.h"
+
+using namespace SpoutSharedAtomics;
+
+FSpoutConsumerTable::FSpoutConsumerTable(TUniquePtr<ISpoutSharedMemoryRegion> InRegion)
+	: Region(MoveTemp(InRegion))
+{
+	check(Region.IsValid() && Region->IsWritable() && Region->GetSize() >= sizeof(FSpoutConsumerTableLayout));
+
+	// Whoever maps a zero-filled region first stamps the header; slots are valid as zeros.
+	FSpoutConsumerTableLayout& Layout = GetLayout();
+	if (FPlatformAtomics::AtomicRead(AsAtomic(Layout.Magic)) == 0)
+	{
+		Layout.Version = FSpoutConsumerTableLayout::CurrentVersion;
+		Layout.SlotCount = FSpoutConsumerTableLayout::NumSlots;
+		FPlatformAtomics::InterlockedCompareExchange(AsAtomic(Layout.Magic), static_cast<int32>(FSpoutConsumerTableLayout::ExpectedMagic), 0);
+	}
+}
+
+FSpoutConsumerTable::~FSpoutConsumerTable() = default;
+
+TUniquePtr<FSpoutConsumerTable> FSpoutConsumerTable::OpenOrCreate(const ANSICHAR* SenderName)
+{
+	if (!SenderName || !SenderName[0])
+		return nullptr;
+
+	const FString RegionName = GetRegionName(SenderName);
+	TUniquePtr<ISpoutSharedMemoryRegion> Region = SpoutSharedMemory::Create(TCHAR_TO_ANSI(*RegionName), sizeof(FSpoutConsumerTableLayout));
+	if (!Region.IsValid())
+		return nullptr;
+
+	return MakeUnique<FSpoutConsumerTable>(MoveTemp(Region));
+}
+
+FString FSpoutConsumerTable::GetRegionName(const ANSICHAR* SenderName)
+{
+	return FString(ANSI_TO_TCHAR(SenderName)) + TEXT("_consumers");
+}
+
+int64 FSpoutConsumerTable::NowMs()
+{
+	return static_cast<int64>(FPlatformTime::Seconds() * 1000.0);
+}
+
+int64 FSpoutConsumerTable::MakeConsumerId()
+{
+	static volatile int32 Counter = 0;
+	const int64 Pid = static_cast<int64>(FPlatformProcess::GetCurrentProcessId());
+	return (Pid << 32) | static_cast<uint32>(FPlatformAtomics::InterlockedIncrement(&Counter));
+}
+
+FSpoutConsumerTableLayout& FSpoutConsumerTable::GetLayout() const
+{
+	return *reinterpret_cast<FSpoutConsumerTableLayout*>(Region->GetData());
+}
+
+int32 FSpoutConsumerTable::Register(int64 ConsumerId, int64 Now, int64 TimeoutMs)
+{
+	check(ConsumerId != 0);
+	FSpoutConsumerTableLayout& Layout = GetLayout();
+
+	for (int32 Slot = 0; Slot < FSpoutConsumerTableLayout::NumSlots; ++Slot)
+	{
+		FSpoutConsumerTableLayout::FSlot& Entry = Layout.Slots[Slot];
+		const int64 Owner = FPlatformAtomics::AtomicRead(AsAtomic(Entry.OwnerId));
+		const bool bDead = Owner != 0 && Now - FPlatformAtomics::AtomicRead(AsAtomic(Entry.HeartbeatMs)) > TimeoutMs;
+
+		if (Owner != 0 && !bDead)
+			continue;
+
+		// A concurrent reclaim between the claim and the heartbeat store is caught by the
+		// next Heartbeat(), which fails and makes the consumer register again.
+		if (FPlatformAtomics::InterlockedCompareExchange(AsAtomic(Entry.OwnerId), ConsumerId, Owner) == Owner)
+		{
+			FPlatformAtomics::AtomicStore(AsAtomic(Entry.HeartbeatMs), Now);
+			return Slot;
+		}
+	}
+	return INDEX_NONE;
+}
+
+bool FSpoutConsumerTable::Heartbeat(int32 Slot, int64 ConsumerId, int64 Now)
+{
+	if (Slot < 0 || Slot >= FSpoutConsumerTableLayout::NumSlots)
+		return false;
+
+	FSpoutConsumerTableLayout::FSlot& Entry = GetLayout().Slots[Slot];
+	if (FPlatformAtomics::AtomicRead(AsAtomic(Entry.OwnerId)) != ConsumerId)
+		return false;
+
+	FPlatformAtomics::AtomicStore(AsAtomic(Entry.HeartbeatMs), Now);
+	return true;
+}
+
+void FSpoutConsumerTable::Unregister(int32 Slot, int64 ConsumerId)
+{
+	if (Slot < 0 || Slot >= FSpoutConsumerTableLayout::NumSlots)
+		return;
+
+	FPlatformAtomics::InterlockedCompareExchange(AsAtomic(GetLayout().Slots[Slot].OwnerId), 0, ConsumerId);
+}
+
+int32 FSpoutConsumerTable::CountLive(int64 Now, int64 TimeoutMs) const
+{
+	const FSpoutConsumerTableLayout& Layout = GetLayout();
+
+	int32 Live = 0;
+	for (const FSpoutConsumerTableLayout::FSlot& Entry : Layout.Slots)
+	{
+		if (FPlatformAtomics::AtomicRead(AsAtomic(Entry.OwnerId)) != 0
+			&& Now - FPlatformAtomics::AtomicRead(AsAtomic(Entry.HeartbeatMs)) <= TimeoutMs)
+		{
+			++Live;
+		}
+	}
+	return Live;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ISpoutSharedMemoryRegion;
+
+/** Shared-memory layout of a sender's consumer table. Plain data, no Windows types. */
+struct FSpoutConsumerTableLayout
+{
+	static constexpr uint32 ExpectedMagic = 0x4E435355; // 'USCN'
+	static constexpr uint32 CurrentVersion = 1;
+	static constexpr int32 NumSlots = 32;
+
+	struct FSlot
+	{
+		/** Consumer that owns the slot, 0 when free. Claimed with compare-exchange. */
+		int64 OwnerId;
+		/** Owner's last heartbeat, in FSpoutConsumerTable::NowMs() time. */
+		int64 HeartbeatMs;
+	};
+
+	uint32 Magic;
+	uint32 Version;
+	uint32 SlotCount;
+	uint32 Reserved;
+	FSlot Slots[NumSlots];
+};
+
+static_assert(STRUCT_OFFSET(FSpoutConsumerTableLayout, Slots) % 8 == 0, "Consumer slots must be 8-byte aligned for 64-bit atomics");
+
+/**
+ * Per-sender table in shared memory where receivers announce themselves, so a sender
+ * can tell whether anyone is watching. Receivers claim a slot and refresh its heartbeat;
+ * a slot whose heartbeat is older than the timeout counts as dead and can be reclaimed,
+ * which covers receivers that crashed without unregistering.
+ *
+ * Lock-free: slots are claimed with 64-bit compare-exchange and heartbeats are single
+ * 64-bit atomic stores. Works on any ISpoutSharedMemoryRegion, including the POSIX one.
+ * Timestamps are passed in so the protocol can be driven by a fake clock.
+ */
+class FSpoutConsumerTable
+{
+public:
+	/** Heartbeats older than this mark a consumer as gone. */
+	static constexpr int64 DefaultTimeoutMs = 2000;
+
+	/** Region must hold at least a full FSpoutConsumerTableLayout and be writable. */
+	explicit FSpoutConsumerTable(TUniquePtr<ISpoutSharedMemoryRegion> InRegion);
+	~FSpoutConsumerTable();
+
+	/** Opens the table for SenderName, creating it if neither side has yet. Null on failure. */
+	static TUniquePtr<FSpoutConsumerTable> OpenOrCreate(const ANSICHAR* SenderName);
+
+	/** Shared-memory name of SenderName's table. */
+	static FString GetRegionName(const ANSICHAR* SenderName);
+
+	/** Monotonic milliseconds, comparable between processes on the same machine. */
+	static int64 NowMs();
+
+	/** Id unique to this process and call, never 0. */
+	static int64 MakeConsumerId();
+
+	/** Claims a free or dead slot for ConsumerId. Returns the slot, or INDEX_NONE if the table is full. */
+	int32 Register(int64 ConsumerId, int64 Now, int64 TimeoutMs = DefaultTimeoutMs);
+
+	/** Refreshes the slot. False if it was reclaimed by someone else, in which case register again. */
+	bool Heartbeat(int32 Slot, int64 ConsumerId, int64 Now);
+
+	/** Frees the slot if ConsumerId still owns it. */
+	void Unregister(int32 Slot, int64 ConsumerId);
+
+	/** Consumers whose heartbeat is within TimeoutMs of Now. */
+	int32 CountLive(int64 Now, int64 TimeoutMs = DefaultTimeoutMs) const;
+
+private:
+	FSpoutConsumerTableLayout& GetLayout() const;
+
+	TUniquePtr<ISpoutSharedMemoryRegion> Region;
+};
@@ -0,0 +1,150 @@
+#include "SpoutConversion.h"
+
+namespace
+{
+	FLinearColor LoadClamped(TConstArrayView<FLinearColor> Src, FIntPoint SrcSize, float TexelX, float TexelY)
+	{
+		const int32 X = FMath::Clamp(FMath::FloorToInt32(TexelX), 0, SrcSize.X - 1);
+		const int32 Y = FMath::Clamp(FMath::FloorToInt32(TexelY), 0, SrcSize.Y - 1);
+		return Src[Y * SrcSize.X + X];
+	}
+
+	/** Clamp-addressed bilinear filter, as the hardware does it: texel centres at half-integer positions. */
+	FLinearColor SampleBilinear(TConstArrayView<FLinearColor> Src, FIntPoint SrcSize, float U, float V)
+	{
+		const float PX = U * SrcSize.X - 0.5f;
+		const float PY = V * SrcSize.Y - 0.5f;
+		const float X0 = FMath::FloorToFloat(PX);
+		const float Y0 = FMath::FloorToFloat(PY);
+		const float FX = PX - X0;
+		const float FY = PY - Y0;
+
+		// +0.5 lands LoadClamped on the texel whose centre is at X0 / X0 + 1.
+		const FLinearColor C00 = LoadClamped(Src, SrcSize, X0 + 0.5f, Y0 + 0.5f);
+		const FLinearColor C10 = LoadClamped(Src, SrcSize, X0 + 1.5f, Y0 + 0.5f);
+		const FLinearColor C01 = LoadClamped(Src, SrcSize, X0 + 0.5f, Y0 + 1.5f);
+		const FLinearColor C11 = LoadClamped(Src, SrcSize, X0 + 1.5f, Y0 + 1.5f);
+
+		return FMath::Lerp(FMath::Lerp(C00, C10, FX), FMath::Lerp(C01, C11, FX), FY);
+	}
+
+	FLinearColor SampleBox(TConstArrayView<FLinearColor> Src, FIntPoint SrcSize, FIntPoint DstSize, const FIntRect& SrcRect, float U, float V)
+	{
+		const float FootprintX = float(SrcRect.Width()) / DstSize.X;
+		const float FootprintY = float(SrcRect.Height()) / DstSize.Y;
+		const int32 TapsX = FMath::Clamp(FMath::CeilToInt32(FootprintX), 1, SpoutConversion::MaxBoxTaps);
+		const int32 TapsY = FMath::Clamp(FMath::CeilToInt32(FootprintY), 1, SpoutConversion::MaxBoxTaps);
+		const float StartX = U * SrcSize.X - FootprintX * 0.5f;
+		const float StartY = V * SrcSize.Y - FootprintY * 0.5f;
+		const float StepX = FootprintX / TapsX;
+		const float StepY = FootprintY / TapsY;
+
+		FLinearColor Sum = FLinearColor::Transparent;
+		for (int32 Y = 0; Y < TapsY; ++Y)
+		{
+			for (int32 X = 0; X < TapsX; ++X)
+			{
+				Sum += LoadClamped(Src, SrcSize, StartX + (X + 0.5f) * StepX, StartY + (Y + 0.5f) * StepY);
+			}
+		}
+		return Sum / float(TapsX * TapsY);
+	}
+}
+
+float SpoutConversion::SRGBToLinear(float Value)
+{
+	return Value <= 0.04045f ? Value / 12.92f : FMath::Pow((Value + 0.055f) / 1.055f, 2.4f);
+}
+
+float SpoutConversion::LinearToSRGB(float Value)
+{
+	return Value <= 0.0031308f ? Value * 12.92f : 1.055f * FMath::Pow(Value, 1.0f / 2.4f) - 0.055f;
+}
+
+FLinearColor SpoutConversion::ConvertPixel(TConstArrayView<FLinearColor> Src, FIntPoint SrcSize, FIntPoint DstSize, int32 X, int32 Y, const FSpoutConversionSettings& Settings, FIntRect SrcRect)
+{
+	check(Src.Num() >= SrcSize.X * SrcSize.Y && SrcSize.X > 0 && SrcSize.Y > 0);
+	check(DstSize.X > 0 && DstSize.Y > 0);
+
+	if (SrcRect.IsEmpty())
+		SrcRect = FIntRect(FIntPoint::ZeroValue, SrcSize);
+
+	// SV_Position is the pixel centre.
+	float U = (X + 0.5f) / DstSize.X;
+	float V = (Y + 0.5f) / DstSize.Y;
+	if (Settings.bFlipVertically)
+	{
+		V = 1.0f - V;
+	}
+	U = FMath::Lerp(float(SrcRect.Min.X) / SrcSize.X, float(SrcRect.Max.X) / SrcSize.X, U);
+	V = FMath::Lerp(float(SrcRect.Min.Y) / SrcSize.Y, float(SrcRect.Max.Y) / SrcSize.Y, V);
+
+	FLinearColor Color;
+	switch (Settings.Filter)
+	{
+	case ESpoutResampleFilter::Box:
+		Color = SampleBox(Src, SrcSize, DstSize, SrcRect, U, V);
+		break;
+	case ESpoutResampleFilter::Bilinear:
+		Color = SampleBilinear(Src, SrcSize, U, V);
+		break;
+	default:
+		Color = LoadClamped(Src, SrcSize, U * SrcSize.X, V * SrcSize.Y);
+		break;
+	}
+
+	if (Settings.bSwapRedBlue)
+	{
+		Swap(Color.R, Color.B);
+	}
+
+	if (Settings.ColorConversion == ESpoutColorConversion::SRGBToLinear)
+	{
+		Color.R = SRGBToLinear(FMath::Clamp(Color.R, 0.0f, 1.0f));
+		Color.G = SRGBToLinear(FMath::Clamp(Color.G, 0.0f, 1.0f));
+		Color.B = SRGBToLinear(FMath::Clamp(Color.B, 0.0f, 1.0f));
+	}
+	else if (Settings.ColorConversion == ESpoutColorConversion::LinearToSRGB)
+	{
+		Color.R = LinearToSRGB(FMath::Clamp(Color.R, 0.0f, 1.0f));
+		Color.G = LinearToSRGB(FMath::Clamp(Color.G, 0.0f, 1.0f));
+		Color.B = LinearToSRGB(FMath::Clamp(Color.B, 0.0f, 1.0f));
+	}
+
+	return Color;
+}
+
+void SpoutConversion::ConvertReference(TConstArrayView<FLinearColor> Src, FIntPoint SrcSize, TArrayView<FLinearColor> Dst, FIntPoint DstSize, const FSpoutConversionSettings& Settings, FIntRect SrcRect)
+{
+	check(Dst.Num() >= DstSize.X * DstSize.Y);
+
+	for (int32 Y = 0; Y < DstSize.Y; ++Y)
+	{
+		for (int32 X = 0; X < DstSize.X; ++X)
+		{
+			Dst[Y * DstSize.X + X] = ConvertPixel(Src, SrcSize, DstSize, X, Y, Settings, SrcRect);
+		}
+	}
+}
+
+FIntPoint SpoutConversion::ResolveOutputSize(FIntPoint SrcSize, int32 RequestedWidth, int32 RequestedHeight)
+{
+	int32 Width = FMath::Max(RequestedWidth, 0);
+	int32 Height = FMath::Max(RequestedHeight, 0);
+
+	if (Width == 0 && Height == 0)
+	{
+		Width = SrcSize.X;
+		Height = SrcSize.Y;
+	}
+	else if (Width == 0)
+	{
+		Width = SrcSize.Y > 0 ? FMath::RoundToInt32(double(Height) * SrcSize.X / SrcSize.Y) : Height;
+	}
+	else if (Height == 0)
+	{
+		Height = SrcSize.X > 0 ? FMath::RoundToInt32(double(Width) * SrcSize.Y / SrcSize.X) : Width;
+	}
+
+	return FIntPoint(FMath::Max(Width, 1), FMath::Max(Height, 1));
+}
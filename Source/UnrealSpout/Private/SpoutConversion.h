@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpoutTypes.h"
+
+/**
+ * CPU reference for the conversion pass in SpoutReceiverCopyShader.usf. Same math, same
+ * sampling positions, so GPU output can be checked against it texel for texel (within
+ * filtering precision). Engine independent: works on plain FLinearColor buffers.
+ */
+namespace SpoutConversion
+{
+	/** Upper bound on box filter taps per axis; matches MAX_BOX_TAPS in the shader. */
+	constexpr int32 MaxBoxTaps = 8;
+
+	float SRGBToLinear(float Value);
+	float LinearToSRGB(float Value);
+
+	/**
+	 * Colour of output pixel (X, Y). Src is row-major, SrcSize.X * SrcSize.Y texels; only
+	 * SrcRect of it is mapped onto the output (all of it if empty).
+	 */
+	FLinearColor ConvertPixel(TConstArrayView<FLinearColor> Src, FIntPoint SrcSize, FIntPoint DstSize, int32 X, int32 Y, const FSpoutConversionSettings& Settings, FIntRect SrcRect = FIntRect());
+
+	/**
+	 * Output extent for a requested size. Zero in both keeps the source size; zero in one
+	 * derives it from the other with the source aspect ratio. Never returns less than 1x1.
+	 */
+	FIntPoint ResolveOutputSize(FIntPoint SrcSize, int32 RequestedWidth, int32 RequestedHeight);
+
+	/** Converts a whole image. Dst must hold DstSize.X * DstSize.Y texels. */
+	void ConvertReference(TConstArrayView<FLinearColor> Src, FIntPoint SrcSize, TArrayView<FLinearColor> Dst, FIntPoint DstSize, const FSpoutConversionSettings& Settings, FIntRect SrcRect = FIntRect());
+}
@@ -1,7 +1,124 @@
 #include "SpoutCopyViewExtension.h"
-#include "ViewportSpoutSender.h"
-#include "SpoutSenderActorComponent.h"
+#include "SpoutShaders.h"
 #include "Engine/TextureRenderTarget2D.h"
+#include "RenderingThread.h"
+#include "TextureResource.h"
+#include "Framework/Application/SlateApplication.h"
+#include "PostProcess/PostProcessMaterialInputs.h"
+#include "Rendering/SlateRenderer.h"
+#include "ScreenPass.h"
+
+void FSpoutCopyViewExtension::BindBackBuffer(SWindow* Window)
+{
+   check(IsInGameThread());
+   BackBufferWindow = Window;
+
+   if (!BackBufferHandle.IsValid() && FSlateApplication::IsInitialized())
+   {
+      if (FSlateRenderer* Renderer = FSlateApplication::Get().GetRenderer())
+      {
+         BackBufferHandle = Renderer->OnBackBufferReadyToPresent().AddSP(this, &FSpoutCopyViewExtension::OnBackBufferReady_RenderThread);
+      }
+   }
+}
+
+void FSpoutCopyViewExtension::UnbindBackBuffer()
+{
+   check(IsInGameThread());
+   BackBufferWindow = nullptr;
+
+   if (BackBufferHandle.IsValid() && FSlateApplication::IsInitialized())
+   {
+      if (FSlateRenderer* Renderer = FSlateApplication::Get().GetRenderer())
+      {
+         Renderer->OnBackBufferReadyToPresent().Remove(BackBufferHandle);
+      }
+   }
+   BackBufferHandle.Reset();
+}
+
+void FSpoutCopyViewExtension::SetTargets(const FTargets& Targets)
+{
+   check(IsInGameThread());
+
+   // The resources' RHI textures are only safe to read on the render thread.
+   ENQUEUE_RENDER_COMMAND(SpoutViewSetTargets)(
+      [Self = StaticCastSharedRef<FSpoutCopyViewExtension>(AsShared()), Targets](FRHICommandListImmediate&)
+      {
+         FRenderTargets& Render = Self->RenderTargets;
+         Render.bPublishing = Targets.bPublishing;
+         Render.Source = Targets.Source;
+         Render.View = Targets.ViewRT ? Targets.ViewRT->GetRenderTargetTexture() : nullptr;
+         Render.Output = Targets.OutputRT ? Targets.OutputRT->GetRenderTargetTexture() : nullptr;
+         Render.OutputConversion = Targets.OutputConversion;
+      });
+}
+
+bool FSpoutCopyViewExtension::Grab(FRDGBuilder& GraphBuilder, const FScreenPassTexture& Input) const
+{
+   if (!RenderTargets.bPublishing || !RenderTargets.View.IsValid() || !Input.IsValid())
+      return false;
+
+   // A draw rather than a copy: the source's view rect, size and format all may differ from ViewRT.
+   FRDGTextureRef View = RegisterExternalTexture(GraphBuilder, RenderTargets.View, TEXT("SpoutView"));
+   AddSpoutConversionPass(GraphBuilder, Input.Texture, View, FSpoutConversionSettings(), Input.ViewRect);
+
+   AddOutputPass(GraphBuilder, View);
+   return true;
+}
+
+void FSpoutCopyViewExtension::SubscribeToPostProcessingPass(
+    EPostProcessingPass Pass,
+    const FSceneView& InView,
+    FAfterPassCallbackDelegateArray& InOutPassCallbacks,
+    bool bIsPassEnabled)
+{
+   if (Pass != EPostProcessingPass::Tonemap || !bIsPassEnabled)
+      return;
+
+   if (!RenderTargets.bPublishing || RenderTargets.Source != ESpoutViewportSource::PostTonemap)
+      return;
+
+   InOutPassCallbacks.Add(FAfterPassCallbackDelegate::CreateRaw(this, &FSpoutCopyViewExtension::AfterTonemap_RenderThread));
+}
+
+FScreenPassTexture FSpoutCopyViewExtension::AfterTonemap_RenderThread(
+    FRDGBuilder& GraphBuilder,
+    const FSceneView& View,
+    const FPostProcessMaterialInputs& Inputs)
+{
+   // Only the player's main view; scene captures and secondary views keep their own output.
+   if (!View.bIsSceneCapture && !View.bIsReflectionCapture && View.Family && View.Family->Views.Num() > 0 && View.Family->Views[0] == &View)
+   {
+      const FScreenPassTexture SceneColor = FScreenPassTexture::CopyFromSlice(GraphBuilder, Inputs.GetInput(EPostProcessMaterialInput::SceneColor));
+      Grab(GraphBuilder, SceneColor);
+   }
+
+   return Inputs.ReturnUntouchedSceneColorForPostProcessing(GraphBuilder);
+}
+
+void FSpoutCopyViewExtension::OnBackBufferReady_RenderThread(SWindow& Window, const FTextureRHIRef& BackBuffer)
+{
+   if (&Window != BackBufferWindow.load() || !BackBuffer.IsValid())
+      return;
+
+   FRDGBuilder GraphBuilder(FRHICommandListImmediate::Get());
+   // Lands in ViewRT after this frame's Spout batch, so it goes out with the next one.
+   FRDGTextureRef Src = RegisterExternalTexture(GraphBuilder, BackBuffer, TEXT("SpoutBackBuffer"));
+   Grab(GraphBuilder, FScreenPassTexture(Src));
+   GraphBuilder.Execute();
+}
+
+FRDGTextureRef FSpoutCopyViewExtension::AddOutputPass(FRDGBuilder& GraphBuilder, FRDGTextureRef Src) const
+{
+   // Reduce to the published size/format first so the sender's copy into its shared texture moves fewer bytes.
+   if (!RenderTargets.Output.IsValid())
+      return Src;
+
+   FRDGTextureRef Reduced = RegisterExternalTexture(GraphBuilder, RenderTargets.Output, TEXT("SpoutOutput"));
+   AddSpoutConversionPass(GraphBuilder, Src, Reduced, RenderTargets.OutputConversion);
+   return Reduced;
+}
 
 void FSpoutCopyViewExtension::PostRenderBasePassDeferred_RenderThread(
     FRDGBuilder& GraphBuilder,
@@ -9,54 +126,30 @@ void FSpoutCopyViewExtension::PostRenderBasePassDeferred_RenderThread(
     const FRenderTargetBindingSlots&,
     TRDGUniformBufferRef<FSceneTextureUniformParameters>)
 {
-   if (!Owner || !Owner->IsValidLowLevel())
+   // The other sources fill ViewRT from their own hooks. The sender component copies
+   // OutputRT (or ViewRT) into its ring in the Spout batch; nothing here touches a shared slot.
+   if (!RenderTargets.bPublishing || RenderTargets.Source != ESpoutViewportSource::SceneCapture)
       return;
 
-   UTextureRenderTarget2D* ViewRT            = Owner->GetCaptureRenderTarget();
-   USpoutSenderActorComponent* SpoutSender   = Owner->GetSpoutSender();
-   if (!ViewRT || !SpoutSender)
+   if (!RenderTargets.View.IsValid() || !RenderTargets.Output.IsValid())
       return;
 
-   FTextureRHIRef   SrcRHI = ViewRT->GetRenderTargetResource()->GetRenderTargetTexture();
-   FTextureRHIRef DstRHI = SpoutSender->GetSharedTextureRHI();
-   if (!SrcRHI.IsValid() || !DstRHI.IsValid())
-      return;
-
-   FRDGTextureRef Src = RegisterExternalTexture(GraphBuilder, SrcRHI, TEXT("SpoutSrc"));
-   FRDGTextureRef Dst = RegisterExternalTexture(
-       GraphBuilder,
-       DstRHI,
-       TEXT("SpoutDst"),
-       ERDGTextureFlags::SkipTracking | ERDGTextureFlags::MultiFrame);
-
-   AddCopyTexturePass(GraphBuilder, Src, Dst);
+   FRDGTextureRef Src = RegisterExternalTexture(GraphBuilder, RenderTargets.View, TEXT("SpoutSrc"));
+   AddOutputPass(GraphBuilder, Src);
 }
 
 void FSpoutCopyViewExtension::PostRenderBasePassMobile_RenderThread(
     FRHICommandList& RHICmdList,
     FSceneView&)
 {
-   if (!Owner || !Owner->IsValidLowLevel())
-      return;
-
-   UTextureRenderTarget2D* ViewRT            = Owner->GetCaptureRenderTarget();
-   USpoutSenderActorComponent* SpoutSender   = Owner->GetSpoutSender();
-   if (!ViewRT || !SpoutSender)
+   if (!RenderTargets.bPublishing || RenderTargets.Source != ESpoutViewportSource::SceneCapture)
       return;
 
-   FTextureRHIRef   SrcRHI = ViewRT->GetRenderTargetResource()->GetRenderTargetTexture();
-   FTextureRHIRef DstRHI = SpoutSender->GetSharedTextureRHI();
-   if (!SrcRHI.IsValid() || !DstRHI.IsValid())
+   if (!RenderTargets.View.IsValid() || !RenderTargets.Output.IsValid())
       return;
 
    FRDGBuilder GraphBuilder(static_cast<FRHICommandListImmediate&>(RHICmdList));
-   FRDGTextureRef Src = RegisterExternalTexture(GraphBuilder, SrcRHI, TEXT("SpoutSrc"));
-   FRDGTextureRef Dst = RegisterExternalTexture(
-       GraphBuilder,
-       DstRHI,
-       TEXT("SpoutDst"),
-       ERDGTextureFlags::SkipTracking | ERDGTextureFlags::MultiFrame);
-
-   AddCopyTexturePass(GraphBuilder, Src, Dst);
+   FRDGTextureRef Src = RegisterExternalTexture(GraphBuilder, RenderTargets.View, TEXT("SpoutSrc"));
+   AddOutputPass(GraphBuilder, Src);
    GraphBuilder.Execute();
 }
\ No newline at end of file
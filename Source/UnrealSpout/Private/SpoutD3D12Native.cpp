@@ -0,0 +1,76 @@
+#include "SpoutD3D12Native.h"
+
+#include "ID3D12DynamicRHI.h"
+#include "RHICommandList.h"
+
+#include "SpoutFrameSync.h"
+
+namespace
+{
+	/** ID3D12Fence whose value is the frame number, signalled behind the copy on the RHI's queue. */
+	class FSpoutD3D12FenceFrameSync final : public ISpoutFrameSync
+	{
+	public:
+		explicit FSpoutD3D12FenceFrameSync(ID3D12Fence* InFence)
+			: Fence(InFence)
+		{}
+
+		virtual ~FSpoutD3D12FenceFrameSync() override
+		{
+			Fence->Release();
+		}
+
+		virtual void Signal(uint64 Frame) override
+		{
+			check(IsInRenderingThread());
+			GetID3D12DynamicRHI()->RHISignalManualFence(FRHICommandListImmediate::Get(), Fence, Frame);
+		}
+
+		virtual uint64 GetCompletedFrame() override
+		{
+			return Fence->GetCompletedValue();
+		}
+
+		virtual ESpoutSyncMode GetMode() const override { return ESpoutSyncMode::Fence; }
+
+	private:
+		ID3D12Fence* Fence;
+	};
+
+	ID3D12Device* GetRHIDevice()
+	{
+		return static_cast<ID3D12Device*>(GDynamicRHI->RHIGetNativeDevice());
+	}
+}
+
+FTextureRHIRef SpoutD3D12Native::OpenSharedTexture(void* SharedHandle, EPixelFormat Format)
+{
+	ID3D12Device* Device = GetRHIDevice();
+	if (!Device || !SharedHandle)
+		return nullptr;
+
+	ID3D12Resource* Resource = nullptr;
+	if (FAILED(Device->OpenSharedHandle(static_cast<HANDLE>(SharedHandle), IID_PPV_ARGS(&Resource))) || !Resource)
+		return nullptr;
+
+	FTextureRHIRef Texture = GetID3D12DynamicRHI()->RHICreateTexture2DFromResource(
+		Format, ETextureCreateFlags::Shared, FClearValueBinding::None, Resource);
+
+	// The RHI texture holds its own reference.
+	Resource->Release();
+	return Texture;
+}
+
+TUniquePtr<ISpoutFrameSync> SpoutD3D12Native::CreateFenceFrameSync()
+{
+	ID3D12Device* Device = GetRHIDevice();
+	if (!Device)
+		return nullptr;
+
+	// Local: only the sender polls it; receivers see a slot once the ring has published it.
+	ID3D12Fence* Fence = nullptr;
+	if (FAILED(Device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&Fence))))
+		return nullptr;
+
+	return MakeUnique<FSpoutD3D12FenceFrameSync>(Fence);
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RHIResources.h"
+
+class ISpoutFrameSync;
+
+/**
+ * Helpers for the native D3D12 share path, which keeps the per-frame copy on the RHI's
+ * own D3D12 queue instead of going through 11on12. The shared textures themselves are
+ * still created as DX11 shared resources, so legacy receivers keep opening them.
+ */
+namespace SpoutD3D12Native
+{
+	/** Opens a DX11 shared handle on the RHI's D3D12 device as an RHI texture. Null if the driver cannot. */
+	FTextureRHIRef OpenSharedTexture(void* SharedHandle, EPixelFormat Format);
+
+	/**
+	 * Frame sync on a local ID3D12Fence, signalled on the RHI's command list. Signal()
+	 * must be called on the render thread. Null if the fence could not be created.
+	 */
+	TUniquePtr<ISpoutFrameSync> CreateFenceFrameSync();
+}
@@ -0,0 +1,73 @@
+#include "SpoutFormats.h"
+
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <dxgiformat.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+
+EPixelFormat SpoutFormats::FromDXGI(uint32 DXGIFormat)
+{
+	switch (static_cast<DXGI_FORMAT>(DXGIFormat))
+	{
+	case DXGI_FORMAT_B8G8R8A8_TYPELESS:
+	case DXGI_FORMAT_B8G8R8A8_UNORM:
+	case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+		return PF_B8G8R8A8;
+	case DXGI_FORMAT_R8G8B8A8_TYPELESS:
+	case DXGI_FORMAT_R8G8B8A8_UNORM:
+	case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+		return PF_R8G8B8A8;
+	case DXGI_FORMAT_R10G10B10A2_TYPELESS:
+	case DXGI_FORMAT_R10G10B10A2_UNORM:
+		return PF_A2B10G10R10;
+	case DXGI_FORMAT_R11G11B10_FLOAT:
+		return PF_FloatR11G11B10;
+	case DXGI_FORMAT_R16G16B16A16_TYPELESS:
+	case DXGI_FORMAT_R16G16B16A16_FLOAT:
+		return PF_FloatRGBA;
+	case DXGI_FORMAT_R16G16B16A16_UNORM:
+		return PF_A16B16G16R16;
+	case DXGI_FORMAT_R32G32B32A32_TYPELESS:
+	case DXGI_FORMAT_R32G32B32A32_FLOAT:
+		return PF_A32B32G32R32F;
+	default:
+		return PF_Unknown;
+	}
+}
+
+uint32 SpoutFormats::ToDXGI(EPixelFormat Format)
+{
+	switch (Format)
+	{
+	case PF_B8G8R8A8:        return DXGI_FORMAT_B8G8R8A8_UNORM;
+	case PF_R8G8B8A8:        return DXGI_FORMAT_R8G8B8A8_UNORM;
+	case PF_A2B10G10R10:     return DXGI_FORMAT_R10G10B10A2_UNORM;
+	case PF_FloatR11G11B10:  return DXGI_FORMAT_R11G11B10_FLOAT;
+	case PF_FloatRGBA:       return DXGI_FORMAT_R16G16B16A16_FLOAT;
+	case PF_A16B16G16R16:    return DXGI_FORMAT_R16G16B16A16_UNORM;
+	case PF_A32B32G32R32F:   return DXGI_FORMAT_R32G32B32A32_FLOAT;
+	default:                 return DXGI_FORMAT_UNKNOWN;
+	}
+}
+
+uint32 SpoutFormats::ToTypedDXGI(uint32 DXGIFormat)
+{
+	switch (static_cast<DXGI_FORMAT>(DXGIFormat))
+	{
+	case DXGI_FORMAT_B8G8R8A8_TYPELESS:     return DXGI_FORMAT_B8G8R8A8_UNORM;
+	case DXGI_FORMAT_R8G8B8A8_TYPELESS:     return DXGI_FORMAT_R8G8B8A8_UNORM;
+	case DXGI_FORMAT_R10G10B10A2_TYPELESS:  return DXGI_FORMAT_R10G10B10A2_UNORM;
+	case DXGI_FORMAT_R16G16B16A16_TYPELESS: return DXGI_FORMAT_R16G16B16A16_FLOAT;
+	case DXGI_FORMAT_R32G32B32A32_TYPELESS: return DXGI_FORMAT_R32G32B32A32_FLOAT;
+	default:                                return DXGIFormat;
+	}
+}
+
+EPixelFormat SpoutFormats::ToPixelFormat(ESpoutOutputFormat Format)
+{
+	switch (Format)
+	{
+	case ESpoutOutputFormat::BGRA8:   return PF_B8G8R8A8;
+	case ESpoutOutputFormat::RGB10A2: return PF_A2B10G10R10;
+	default:                          return PF_FloatRGBA;
+	}
+}
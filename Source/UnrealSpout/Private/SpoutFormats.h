@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PixelFormat.h"
+#include "SpoutTypes.h"
+
+/**
+ * DXGI <-> EPixelFormat mapping shared by senders and receivers. DXGI values are passed
+ * as uint32 so this header does not pull in Windows headers; they are what Spout stores
+ * in SharedTextureInfo::format.
+ */
+namespace SpoutFormats
+{
+	/** Unreal format able to hold the DXGI format bit for bit, or PF_Unknown if Spout streams in that format are not supported. */
+	EPixelFormat FromDXGI(uint32 DXGIFormat);
+
+	/** Typed DXGI format to advertise for an Unreal format, or 0 (DXGI_FORMAT_UNKNOWN). */
+	uint32 ToDXGI(EPixelFormat Format);
+
+	/** Resolves a typeless format to its UNORM/FLOAT variant; typed formats are returned unchanged. Spout receivers cannot open typeless textures. */
+	uint32 ToTypedDXGI(uint32 DXGIFormat);
+
+	EPixelFormat ToPixelFormat(ESpoutOutputFormat Format);
+}
@@ -0,0 +1,42 @@
+#include "SpoutFramePoller.h"
+
+#include "SpoutSenderInfoLayout.h"
+#include "SpoutSharedAtomics.h"
+#include "SpoutSharedMemoryRegion.h"
+
+namespace
+{
+	uint32 ReadShared(const uint8* Record, SIZE_T Offset)
+	{
+		return SpoutSharedAtomics::Load(*reinterpret_cast<const uint32*>(Record + Offset));
+	}
+}
+
+FSpoutFramePoller::FSpoutFramePoller(TUniquePtr<ISpoutSharedMemoryRegion> InRegion)
+	: Region(MoveTemp(InRegion))
+{
+	check(Region.IsValid() && Region->GetSize() >= sizeof(FSpoutSharedTextureInfoLayout));
+}
+
+FSpoutFramePoller::~FSpoutFramePoller() = default;
+
+FSpoutFramePoller::EResult FSpoutFramePoller::Poll(uint32& OutFrame) const
+{
+	constexpr SIZE_T ExtOffset = STRUCT_OFFSET(FSpoutSharedTextureInfoLayout, Description);
+	const uint8* Record = Region->GetData();
+
+	if (ReadShared(Record, ExtOffset + STRUCT_OFFSET(FSpoutSenderInfoExt, Magic)) != FSpoutSenderInfoExt::ExpectedMagic
+		|| ReadShared(Record, ExtOffset + STRUCT_OFFSET(FSpoutSenderInfoExt, Version)) < 2)
+	{
+		return EResult::Unsupported;
+	}
+
+	OutFrame = ReadShared(Record, SpoutSenderInfoLayout::FrameNumberOffset);
+	return bHasConsumed && OutFrame == ConsumedFrame ? EResult::Unchanged : EResult::NewFrame;
+}
+
+void FSpoutFramePoller::MarkConsumed(uint32 Frame)
+{
+	ConsumedFrame = Frame;
+	bHasConsumed = true;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ISpoutSharedMemoryRegion;
+
+/**
+ * Watches the frame number a sender publishes in its shared record, so a receiver
+ * only copies when there is something new. Reads are lock-free: the frame number is
+ * a naturally aligned 32-bit field, so it never tears.
+ *
+ * Works on anything exposing the record through ISpoutSharedMemoryRegion, including
+ * the POSIX stand-in.
+ */
+class FSpoutFramePoller
+{
+public:
+	enum class EResult : uint8
+	{
+		NewFrame,
+		Unchanged,
+		/** The sender does not publish frame numbers; copy every tick. */
+		Unsupported,
+	};
+
+	/** Region must hold at least a full FSpoutSharedTextureInfoLayout. */
+	explicit FSpoutFramePoller(TUniquePtr<ISpoutSharedMemoryRegion> InRegion);
+	~FSpoutFramePoller();
+
+	/** Compares the published frame against the last one consumed. */
+	EResult Poll(uint32& OutFrame) const;
+
+	/** Records the frame as copied; Poll reports Unchanged until the sender publishes another. */
+	void MarkConsumed(uint32 Frame);
+
+	/** Forgets the consumed frame so the next Poll reports NewFrame again. */
+	void Reset() { bHasConsumed = false; }
+
+private:
+	TUniquePtr<ISpoutSharedMemoryRegion> Region;
+	uint32 ConsumedFrame = 0;
+	bool bHasConsumed = false;
+};
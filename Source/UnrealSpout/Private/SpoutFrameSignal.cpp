@@ -0,0 +1,245 @@
+#include "SpoutFrameSignal.h"
+
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+
+#include "SpoutSharedAtomics.h"
+#include "SpoutSharedMemoryRegion.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <windows.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+#elif PLATFORM_LINUX
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace SpoutSharedAtomics;
+
+namespace
+{
+	/** How often (s) waiters without a wake-up primitive look at the sequence. */
+	constexpr float PollIntervalSeconds = 0.001f;
+
+	uint32 LoadSequence(const FSpoutFrameSignalLayout& Layout)
+	{
+		return Load(Layout.Sequence);
+	}
+
+	void InitLayout(FSpoutFrameSignalLayout& Layout)
+	{
+		if (Load(Layout.Magic) == FSpoutFrameSignalLayout::ExpectedMagic)
+			return;
+
+		Layout.Version = FSpoutFrameSignalLayout::CurrentVersion;
+		Store(Layout.Magic, FSpoutFrameSignalLayout::ExpectedMagic);
+	}
+
+	/** Sleeps in small steps until the sequence moves, bInterrupted is set or TimeoutMs passes. */
+	void PollSequence(const FSpoutFrameSignalLayout& Layout, uint32 Sequence, uint32 TimeoutMs, const std::atomic<bool>& bInterrupted)
+	{
+		const double EndTime = FPlatformTime::Seconds() + TimeoutMs / 1000.0;
+		while (LoadSequence(Layout) == Sequence && !bInterrupted && FPlatformTime::Seconds() < EndTime)
+			FPlatformProcess::Sleep(PollIntervalSeconds);
+	}
+
+#if PLATFORM_WINDOWS
+	FString GetEventName(const FString& BaseName, int64 WaiterId)
+	{
+		return FString::Printf(TEXT("%s_%lld"), *BaseName, WaiterId);
+	}
+#elif PLATFORM_LINUX
+	// Shared, not FUTEX_PRIVATE_FLAG: the word is mapped by other processes.
+	void FutexWakeAll(uint32* Word)
+	{
+		syscall(SYS_futex, Word, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+	}
+
+	void FutexWait(uint32* Word, uint32 Expected, uint32 TimeoutMs)
+	{
+		timespec Timeout;
+		Timeout.tv_sec = TimeoutMs / 1000;
+		Timeout.tv_nsec = static_cast<long>(TimeoutMs % 1000) * 1000000L;
+
+		// Returns at once if the word no longer holds Expected; EINTR and timeouts are fine too.
+		syscall(SYS_futex, Word, FUTEX_WAIT, Expected, &Timeout, nullptr, 0);
+	}
+#endif
+}
+
+/* ---------------------------------------------------------------- Sender */
+
+FSpoutFrameSignalSender::FSpoutFrameSignalSender(const ANSICHAR* SenderName, TUniquePtr<ISpoutSharedMemoryRegion> InRegion)
+	: BaseName(GetRegionName(SenderName))
+	, Region(MoveTemp(InRegion))
+{
+	check(Region.IsValid() && Region->IsWritable() && Region->GetSize() >= sizeof(FSpoutFrameSignalLayout));
+
+	InitLayout(GetLayout());
+}
+
+FSpoutFrameSignalSender::~FSpoutFrameSignalSender()
+{
+#if PLATFORM_WINDOWS
+	for (void* Event : Events)
+	{
+		if (Event)
+			CloseHandle(Event);
+	}
+#endif
+}
+
+TUniquePtr<FSpoutFrameSignalSender> FSpoutFrameSignalSender::Create(const ANSICHAR* SenderName)
+{
+	if (!SenderName || !SenderName[0])
+		return nullptr;
+
+	TUniquePtr<ISpoutSharedMemoryRegion> Region = SpoutSharedMemory::Create(TCHAR_TO_ANSI(*GetRegionName(SenderName)), sizeof(FSpoutFrameSignalLayout));
+	if (!Region.IsValid())
+		return nullptr;
+
+	return MakeUnique<FSpoutFrameSignalSender>(SenderName, MoveTemp(Region));
+}
+
+FString FSpoutFrameSignalSender::GetRegionName(const ANSICHAR* SenderName)
+{
+	return FString(ANSI_TO_TCHAR(SenderName)) + TEXT("_frameready");
+}
+
+FSpoutFrameSignalLayout& FSpoutFrameSignalSender::GetLayout() const
+{
+	return *reinterpret_cast<FSpoutFrameSignalLayout*>(Region->GetData());
+}
+
+void FSpoutFrameSignalSender::Notify()
+{
+	FSpoutFrameSignalLayout& Layout = GetLayout();
+	FPlatformAtomics::InterlockedIncrement(AsAtomic(Layout.Sequence));
+
+#if PLATFORM_WINDOWS
+	for (int32 i = 0; i < FSpoutFrameSignalLayout::MaxWaiters; ++i)
+	{
+		const int64 Owner = FPlatformAtomics::AtomicRead(&Layout.Waiters[i]);
+		if (Owner != EventOwners[i])
+		{
+			// The slot changed hands. A waiter creates its event before claiming a slot, so a
+			// failed open means it has gone already; we retry once the slot changes again.
+			if (Events[i])
+				CloseHandle(Events[i]);
+			Events[i] = Owner ? OpenEventW(EVENT_MODIFY_STATE, FALSE, *GetEventName(BaseName, Owner)) : nullptr;
+			EventOwners[i] = Owner;
+		}
+
+		if (Events[i])
+			SetEvent(Events[i]);
+	}
+#elif PLATFORM_LINUX
+	FutexWakeAll(&Layout.Sequence);
+#endif
+}
+
+/* ---------------------------------------------------------------- Waiter */
+
+FSpoutFrameSignalWaiter::FSpoutFrameSignalWaiter(const ANSICHAR* SenderName, TUniquePtr<ISpoutSharedMemoryRegion> InRegion, int64 InWaiterId)
+	: Region(MoveTemp(InRegion))
+	, WaiterId(InWaiterId)
+{
+	check(Region.IsValid() && Region->IsWritable() && Region->GetSize() >= sizeof(FSpoutFrameSignalLayout));
+	check(WaiterId != 0);
+
+	FSpoutFrameSignalLayout& Layout = GetLayout();
+	InitLayout(Layout);
+
+#if PLATFORM_WINDOWS
+	Event = CreateEventW(nullptr, FALSE, FALSE, *GetEventName(FSpoutFrameSignalSender::GetRegionName(SenderName), WaiterId));
+	if (!Event)
+		return;
+
+	for (int32 i = 0; i < FSpoutFrameSignalLayout::MaxWaiters; ++i)
+	{
+		if (FPlatformAtomics::InterlockedCompareExchange(&Layout.Waiters[i], WaiterId, 0) == 0)
+		{
+			Slot = i;
+			break;
+		}
+	}
+#endif
+}
+
+FSpoutFrameSignalWaiter::~FSpoutFrameSignalWaiter()
+{
+#if PLATFORM_WINDOWS
+	if (Slot != INDEX_NONE)
+		FPlatformAtomics::InterlockedCompareExchange(&GetLayout().Waiters[Slot], 0, WaiterId);
+	if (Event)
+		CloseHandle(Event);
+#endif
+}
+
+TUniquePtr<FSpoutFrameSignalWaiter> FSpoutFrameSignalWaiter::Create(const ANSICHAR* SenderName, int64 WaiterId)
+{
+	if (!SenderName || !SenderName[0])
+		return nullptr;
+
+	TUniquePtr<ISpoutSharedMemoryRegion> Region = SpoutSharedMemory::Create(TCHAR_TO_ANSI(*FSpoutFrameSignalSender::GetRegionName(SenderName)), sizeof(FSpoutFrameSignalLayout));
+	if (!Region.IsValid())
+		return nullptr;
+
+	return MakeUnique<FSpoutFrameSignalWaiter>(SenderName, MoveTemp(Region), WaiterId);
+}
+
+FSpoutFrameSignalLayout& FSpoutFrameSignalWaiter::GetLayout() const
+{
+	return *reinterpret_cast<FSpoutFrameSignalLayout*>(Region->GetData());
+}
+
+uint32 FSpoutFrameSignalWaiter::GetSequence() const
+{
+	return LoadSequence(GetLayout());
+}
+
+bool FSpoutFrameSignalWaiter::Wait(uint32& InOutSequence, uint32 TimeoutMs)
+{
+	FSpoutFrameSignalLayout& Layout = GetLayout();
+
+	uint32 Sequence = LoadSequence(Layout);
+	if (Sequence == InOutSequence && !bInterrupted)
+	{
+#if PLATFORM_WINDOWS
+		// Auto-reset: a SetEvent since our last wait is still pending, so none is lost between
+		// the check above and here.
+		if (Slot != INDEX_NONE)
+			WaitForSingleObject(Event, TimeoutMs);
+		else
+			PollSequence(Layout, InOutSequence, TimeoutMs, bInterrupted);
+#elif PLATFORM_LINUX
+		FutexWait(&Layout.Sequence, InOutSequence, TimeoutMs);
+#else
+		PollSequence(Layout, InOutSequence, TimeoutMs, bInterrupted);
+#endif
+		Sequence = LoadSequence(Layout);
+	}
+
+	if (Sequence == InOutSequence)
+		return false;
+
+	InOutSequence = Sequence;
+	return true;
+}
+
+void FSpoutFrameSignalWaiter::Interrupt()
+{
+	bInterrupted = true;
+
+#if PLATFORM_WINDOWS
+	if (Event)
+		SetEvent(Event);
+#elif PLATFORM_LINUX
+	// Wakes the other waiters on this sender too; they see an unchanged sequence and go back to sleep.
+	FutexWakeAll(&GetLayout().Sequence);
+#endif
+}
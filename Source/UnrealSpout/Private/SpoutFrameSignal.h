@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <atomic>
+
+class ISpoutSharedMemoryRegion;
+
+/** Shared-memory layout of a sender's frame-ready signal. Plain data, no Windows types. */
+struct FSpoutFrameSignalLayout
+{
+	static constexpr uint32 ExpectedMagic = 0x52465355; // 'USFR'
+	static constexpr uint32 CurrentVersion = 1;
+	static constexpr int32 MaxWaiters = 32;
+
+	uint32 Magic;
+	uint32 Version;
+	/** Bumped for every frame the sender publishes. Waiters sleep on it as a futex where there is one. */
+	uint32 Sequence;
+	uint32 Reserved;
+	/** Waiters with a named event of their own ("<sender>_frameready_<id>"), 0 when free. Claimed with compare-exchange. */
+	int64 Waiters[MaxWaiters];
+};
+
+static_assert(STRUCT_OFFSET(FSpoutFrameSignalLayout, Waiters) % 8 == 0, "Frame signal waiters must be 8-byte aligned for 64-bit atomics");
+
+/**
+ * Lets receivers sleep until a sender publishes a frame instead of polling every tick. The
+ * sender bumps a sequence in "<sender>_frameready" and wakes everyone waiting on it: a futex
+ * wake on Linux; on Windows a SetEvent on each waiter's auto-reset named event, listed in the
+ * same region. Elsewhere waiters poll the sequence every millisecond.
+ *
+ * A wake may be spurious or, on Windows, missed by a waiter that crashed and restarted under
+ * a full table; waiters always compare the sequence and wait with a timeout.
+ */
+class FSpoutFrameSignalSender
+{
+public:
+	/** Region must hold a full FSpoutFrameSignalLayout and be writable. */
+	FSpoutFrameSignalSender(const ANSICHAR* SenderName, TUniquePtr<ISpoutSharedMemoryRegion> InRegion);
+	~FSpoutFrameSignalSender();
+
+	/** Opens or creates SenderName's signal. Null on failure. */
+	static TUniquePtr<FSpoutFrameSignalSender> Create(const ANSICHAR* SenderName);
+
+	/** Shared-memory name of SenderName's signal. */
+	static FString GetRegionName(const ANSICHAR* SenderName);
+
+	/** Marks a new frame and wakes every waiter. Never blocks. */
+	void Notify();
+
+private:
+	FSpoutFrameSignalLayout& GetLayout() const;
+
+	FString BaseName;
+	TUniquePtr<ISpoutSharedMemoryRegion> Region;
+
+	/** Windows: events opened per waiter slot, and the waiter each was opened for. */
+	void* Events[FSpoutFrameSignalLayout::MaxWaiters] = {};
+	int64 EventOwners[FSpoutFrameSignalLayout::MaxWaiters] = {};
+};
+
+class FSpoutFrameSignalWaiter
+{
+public:
+	/** Region must hold a full FSpoutFrameSignalLayout and be writable. WaiterId is unique and never 0. */
+	FSpoutFrameSignalWaiter(const ANSICHAR* SenderName, TUniquePtr<ISpoutSharedMemoryRegion> InRegion, int64 InWaiterId);
+
+	/** Leaves the waiter table. */
+	~FSpoutFrameSignalWaiter();
+
+	/** Opens or creates SenderName's signal; a receiver may start before its sender. Null on failure. */
+	static TUniquePtr<FSpoutFrameSignalWaiter> Create(const ANSICHAR* SenderName, int64 WaiterId);
+
+	/** Current frame sequence. */
+	uint32 GetSequence() const;
+
+	/**
+	 * Sleeps until the sequence differs from InOutSequence, Interrupt is called or TimeoutMs
+	 * passes. Returns true and updates InOutSequence if the sender published meanwhile.
+	 */
+	bool Wait(uint32& InOutSequence, uint32 TimeoutMs);
+
+	/** Wakes a Wait on another thread and makes later ones return at once; for shutting a worker down. */
+	void Interrupt();
+
+private:
+	FSpoutFrameSignalLayout& GetLayout() const;
+
+	TUniquePtr<ISpoutSharedMemoryRegion> Region;
+	const int64 WaiterId;
+	std::atomic<bool> bInterrupted { false };
+
+	/** Windows: our auto-reset event and the table slot that advertises it; null/INDEX_NONE elsewhere or when the table was full. */
+	void* Event = nullptr;
+	int32 Slot = INDEX_NONE;
+};
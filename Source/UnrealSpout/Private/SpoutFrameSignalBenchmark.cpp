@@ -0,0 +1,87 @@
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/OutputDevice.h"
+
+#include "SpoutConsumerTable.h"
+#include "SpoutFrameSignal.h"
+#include "SpoutSharedMemoryRegion.h"
+
+#include <atomic>
+#include <thread>
+
+#if !UE_BUILD_SHIPPING
+
+namespace
+{
+	/** Tick the polling baseline is quantised to: a receiver looking once per 60 Hz frame. */
+	constexpr double TickSeconds = 1.0 / 60.0;
+
+	void BenchmarkFrameSignal(const TArray<FString>& Args, FOutputDevice& Ar)
+	{
+		const int32 Frames = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 200;
+
+		const FString SenderName = FString::Printf(TEXT("UnrealSpoutSignalBenchmark_%u"), FPlatformProcess::GetCurrentProcessId());
+		const auto SenderAnsi = StringCast<ANSICHAR>(*SenderName);
+		TUniquePtr<FSpoutFrameSignalSender> Sender = FSpoutFrameSignalSender::Create(SenderAnsi.Get());
+		TUniquePtr<FSpoutFrameSignalWaiter> Waiter = FSpoutFrameSignalWaiter::Create(SenderAnsi.Get(), FSpoutConsumerTable::MakeConsumerId());
+		if (!Sender.IsValid() || !Waiter.IsValid())
+		{
+			Ar.Log(TEXT("Spout frame signal: could not create the shared memory region."));
+			return;
+		}
+
+		// Frames at random points within a tick; the waiter thread timestamps each wake-up.
+		std::atomic<double> SentAt { 0.0 };
+		std::atomic<bool> bStop { false };
+		double TotalLatency = 0.0, WorstLatency = 0.0;
+		int32 Received = 0;
+
+		std::thread WaiterThread([&]()
+		{
+			uint32 Sequence = Waiter->GetSequence();
+			while (!bStop)
+			{
+				if (!Waiter->Wait(Sequence, 100))
+					continue;
+
+				const double Latency = FPlatformTime::Seconds() - SentAt.load();
+				TotalLatency += Latency;
+				WorstLatency = FMath::Max(WorstLatency, Latency);
+				++Received;
+			}
+		});
+
+		FRandomStream Random(1);
+		for (int32 i = 0; i < Frames; ++i)
+		{
+			FPlatformProcess::Sleep(static_cast<float>(Random.FRandRange(0.0, TickSeconds)));
+			SentAt = FPlatformTime::Seconds();
+			Sender->Notify();
+			// Let the waiter take this frame before the next, so each latency is for one frame.
+			FPlatformProcess::Sleep(0.002f);
+		}
+
+		bStop = true;
+		Waiter->Interrupt();
+		WaiterThread.join();
+
+		// A tick-polling receiver sees a frame at the next tick: on average half a tick late, at worst a whole one.
+		Ar.Logf(TEXT("  signal: %d/%d frames  mean %7.1f us  worst %7.1f us"),
+			Received, Frames, Received ? TotalLatency / Received * 1.0e6 : 0.0, WorstLatency * 1.0e6);
+		Ar.Logf(TEXT("  60 Hz tick polling: mean %7.1f us  worst %7.1f us"), TickSeconds / 2.0 * 1.0e6, TickSeconds * 1.0e6);
+
+		Waiter.Reset();
+		Sender.Reset();
+		SpoutSharedMemory::Remove(TCHAR_TO_ANSI(*FSpoutFrameSignalSender::GetRegionName(SenderAnsi.Get())));
+	}
+
+	FAutoConsoleCommandWithArgsAndOutputDevice BenchmarkFrameSignalCommand(
+		TEXT("Spout.BenchmarkFrameSignal"),
+		TEXT("Signals frames at random points within a 60 Hz tick on a private Spout frame-ready signal and times how long a waiting thread takes to wake, against the latency of polling once per tick. Optional argument: frames (default 200)."),
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&BenchmarkFrameSignal));
+}
+
+#endif
@@ -0,0 +1,163 @@
+#include "SpoutFrameSync.h"
+
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <d3d11_4.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+
+namespace
+{
+	/** ID3D11Fence whose value is the frame number. Needs a D3D11.4 device. */
+	class FSpoutFenceFrameSync final : public ISpoutFrameSync
+	{
+	public:
+		static TUniquePtr<ISpoutFrameSync> TryCreate(ID3D11Device* Device, ID3D11DeviceContext* Context)
+		{
+			ID3D11Device5* Device5 = nullptr;
+			ID3D11DeviceContext4* Context4 = nullptr;
+			ID3D11Fence* Fence = nullptr;
+
+			if (FAILED(Device->QueryInterface(__uuidof(ID3D11Device5), (void**)&Device5)))
+				return nullptr;
+
+			if (FAILED(Context->QueryInterface(__uuidof(ID3D11DeviceContext4), (void**)&Context4))
+				|| FAILED(Device5->CreateFence(0, D3D11_FENCE_FLAG_NONE, __uuidof(ID3D11Fence), (void**)&Fence)))
+			{
+				if (Context4)
+					Context4->Release();
+				Device5->Release();
+				return nullptr;
+			}
+
+			Device5->Release();
+			return MakeUnique<FSpoutFenceFrameSync>(Context4, Fence);
+		}
+
+		FSpoutFenceFrameSync(ID3D11DeviceContext4* InContext, ID3D11Fence* InFence)
+			: Context(InContext)
+			, Fence(InFence)
+		{}
+
+		virtual ~FSpoutFenceFrameSync() override
+		{
+			Fence->Release();
+			Context->Release();
+		}
+
+		virtual void Signal(uint64 Frame) override
+		{
+			Context->Signal(Fence, Frame);
+		}
+
+		virtual uint64 GetCompletedFrame() override
+		{
+			return Fence->GetCompletedValue();
+		}
+
+		virtual ESpoutSyncMode GetMode() const override { return ESpoutSyncMode::Fence; }
+
+	private:
+		ID3D11DeviceContext4* Context;
+		ID3D11Fence* Fence;
+	};
+
+	/** CPU-visible event queries, one per frame in flight, polled with DONOTFLUSH. */
+	class FSpoutEventQueryFrameSync final : public ISpoutFrameSync
+	{
+	public:
+		FSpoutEventQueryFrameSync(ID3D11Device* InDevice, ID3D11DeviceContext* InContext)
+			: Device(InDevice)
+			, Context(InContext)
+		{
+			Device->AddRef();
+			Context->AddRef();
+		}
+
+		virtual ~FSpoutEventQueryFrameSync() override
+		{
+			for (FPending& Entry : Pending)
+				Entry.Query->Release();
+			for (ID3D11Query* Query : FreeQueries)
+				Query->Release();
+
+			Context->Release();
+			Device->Release();
+		}
+
+		virtual void Signal(uint64 Frame) override
+		{
+			ID3D11Query* Query = nullptr;
+			if (FreeQueries.Num() > 0)
+			{
+				Query = FreeQueries.Pop(EAllowShrinking::No);
+			}
+			else
+			{
+				D3D11_QUERY_DESC Desc = {};
+				Desc.Query = D3D11_QUERY_EVENT;
+				if (FAILED(Device->CreateQuery(&Desc, &Query)))
+				{
+					// Without a query we can only treat the frame as done.
+					Completed = FMath::Max(Completed, Frame);
+					return;
+				}
+			}
+
+			Context->End(Query);
+			Pending.Add({ Query, Frame });
+		}
+
+		virtual uint64 GetCompletedFrame() override
+		{
+			// Queries retire in order, so stop at the first one still in flight.
+			int32 NumDone = 0;
+			for (; NumDone < Pending.Num(); ++NumDone)
+			{
+				BOOL bDone = FALSE;
+				if (Context->GetData(Pending[NumDone].Query, &bDone, sizeof(bDone), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK || !bDone)
+					break;
+
+				Completed = Pending[NumDone].Frame;
+				FreeQueries.Add(Pending[NumDone].Query);
+			}
+
+			if (NumDone > 0)
+				Pending.RemoveAt(0, NumDone, EAllowShrinking::No);
+
+			return Completed;
+		}
+
+		virtual ESpoutSyncMode GetMode() const override { return ESpoutSyncMode::EventQuery; }
+
+	private:
+		struct FPending
+		{
+			ID3D11Query* Query;
+			uint64 Frame;
+		};
+
+		ID3D11Device* Device;
+		ID3D11DeviceContext* Context;
+		TArray<FPending, TInlineAllocator<4>> Pending;
+		TArray<ID3D11Query*, TInlineAllocator<4>> FreeQueries;
+		uint64 Completed = 0;
+	};
+}
+
+TUniquePtr<ISpoutFrameSync> SpoutFrameSync::Create(ESpoutSyncMode Mode, ID3D11Device* Device, ID3D11DeviceContext* Context)
+{
+	if (!Device || !Context)
+		return MakeUnique<FSpoutNoFrameSync>();
+
+	if (Mode == ESpoutSyncMode::Fence)
+	{
+		if (TUniquePtr<ISpoutFrameSync> Fence = FSpoutFenceFrameSync::TryCreate(Device, Context))
+			return Fence;
+
+		Mode = ESpoutSyncMode::EventQuery;
+	}
+
+	if (Mode == ESpoutSyncMode::EventQuery)
+		return MakeUnique<FSpoutEventQueryFrameSync>(Device, Context);
+
+	return MakeUnique<FSpoutNoFrameSync>();
+}
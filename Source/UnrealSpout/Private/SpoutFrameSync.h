@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpoutTypes.h"
+
+struct ID3D11Device;
+struct ID3D11DeviceContext;
+
+/**
+ * Tracks when the GPU has finished the work queued for a frame, without flushing.
+ *
+ * The producer calls Signal(N) right after queuing the commands for frame N, then
+ * polls GetCompletedFrame() on later ticks. Frame numbers must be strictly increasing;
+ * a completed frame implies every earlier frame is complete too.
+ */
+class ISpoutFrameSync
+{
+public:
+	virtual ~ISpoutFrameSync() = default;
+
+	/** Queues a marker for Frame behind the commands already recorded on the context. */
+	virtual void Signal(uint64 Frame) = 0;
+
+	/** Highest frame whose marker the GPU has passed. Never blocks. */
+	virtual uint64 GetCompletedFrame() = 0;
+
+	virtual ESpoutSyncMode GetMode() const = 0;
+};
+
+/** Treats every signalled frame as complete. Used when the caller synchronises some other way. */
+class FSpoutNoFrameSync final : public ISpoutFrameSync
+{
+public:
+	virtual void Signal(uint64 Frame) override { LastSignalled = Frame; }
+	virtual uint64 GetCompletedFrame() override { return LastSignalled; }
+	virtual ESpoutSyncMode GetMode() const override { return ESpoutSyncMode::None; }
+
+private:
+	uint64 LastSignalled = 0;
+};
+
+/**
+ * Completes frames only when told to, standing in for a GPU fence, so the ring's Pending to
+ * Published ordering can be driven step by step without a device. Single thread.
+ */
+class FSpoutScriptedFrameSync final : public ISpoutFrameSync
+{
+public:
+	virtual void Signal(uint64 Frame) override
+	{
+		check(Frame > LastSignalled);
+		LastSignalled = Frame;
+	}
+
+	virtual uint64 GetCompletedFrame() override { return Completed; }
+	virtual ESpoutSyncMode GetMode() const override { return ESpoutSyncMode::Fence; }
+
+	/** Completes every signalled frame up to Frame. Frames never go back to incomplete. */
+	void Complete(uint64 Frame) { Completed = FMath::Max(Completed, FMath::Min(Frame, LastSignalled)); }
+
+	uint64 GetLastSignalled() const { return LastSignalled; }
+
+private:
+	uint64 LastSignalled = 0;
+	uint64 Completed = 0;
+};
+
+namespace SpoutFrameSync
+{
+	/**
+	 * Creates the requested sync for the given device context, falling back from
+	 * Fence to EventQuery to None when the device does not support it.
+	 */
+	TUniquePtr<ISpoutFrameSync> Create(ESpoutSyncMode Mode, ID3D11Device* Device, ID3D11DeviceContext* Context);
+}
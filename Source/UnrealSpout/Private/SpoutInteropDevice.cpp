@@ -0,0 +1,180 @@
+#include "SpoutInteropDevice.h"
+
+#include "DynamicRHI.h"
+#include "Misc/ScopeLock.h"
+
+#include "SpoutFrameSync.h"
+#include "SpoutStats.h"
+
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <d3d11on12.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+
+namespace
+{
+	/** Builds the 11on12 device on top of the RHI's D3D12 device. */
+	class FSpoutD3D11On12DeviceFactory final : public ISpoutInteropDeviceFactory
+	{
+	public:
+		virtual bool Create(FSpoutInteropDeviceHandles& Out) override
+		{
+			ID3D12Device* D3D12Device = static_cast<ID3D12Device*>(GDynamicRHI->RHIGetNativeDevice());
+			if (!D3D12Device)
+				return false;
+
+			FSpoutInteropDeviceHandles Handles;
+			if (FAILED(D3D11On12CreateDevice(
+				D3D12Device,
+				D3D11_CREATE_DEVICE_BGRA_SUPPORT,
+				nullptr,
+				0,
+				nullptr,
+				0,
+				0,
+				&Handles.Device,
+				&Handles.Context,
+				nullptr)))
+			{
+				return false;
+			}
+
+			if (FAILED(Handles.Device->QueryInterface(__uuidof(ID3D11On12Device), (void**)&Handles.On12Device)))
+			{
+				Destroy(Handles);
+				return false;
+			}
+
+			Out = Handles;
+			return true;
+		}
+
+		virtual void Destroy(FSpoutInteropDeviceHandles& Handles) override
+		{
+			if (Handles.Context)
+			{
+				// Nothing may still reference wrapped resources once the last stream is gone.
+				Handles.Context->ClearState();
+				Handles.Context->Flush();
+				Handles.Context->Release();
+				Handles.Context = nullptr;
+			}
+
+			if (Handles.On12Device)
+			{
+				Handles.On12Device->Release();
+				Handles.On12Device = nullptr;
+			}
+
+			if (Handles.Device)
+			{
+				Handles.Device->Release();
+				Handles.Device = nullptr;
+			}
+		}
+
+		virtual void ExecuteCopies(const FSpoutInteropDeviceHandles& Handles, TConstArrayView<ID3D11Resource*> Wrapped, TConstArrayView<FSpoutInteropCopy> Copies) override
+		{
+			if (Wrapped.Num() > 0)
+				Handles.On12Device->AcquireWrappedResources(Wrapped.GetData(), Wrapped.Num());
+
+			for (const FSpoutInteropCopy& Copy : Copies)
+				Handles.Context->CopyResource(Copy.Dst, Copy.Src);
+
+			if (Wrapped.Num() > 0)
+				Handles.On12Device->ReleaseWrappedResources(Wrapped.GetData(), Wrapped.Num());
+
+			// Signal behind the release, so a completed frame also means the resources are back in their D3D12 state.
+			for (const FSpoutInteropCopy& Copy : Copies)
+			{
+				if (Copy.Sync)
+					Copy.Sync->Signal(Copy.Frame);
+			}
+		}
+
+		virtual void Flush(const FSpoutInteropDeviceHandles& Handles) override
+		{
+			Handles.Context->Flush();
+		}
+	};
+
+	FCriticalSection InstanceLock;
+	TWeakPtr<FSpoutInteropDevice, ESPMode::ThreadSafe> Instance;
+	FSpoutInteropDeviceFactoryPtr Factory;
+}
+
+TSharedPtr<FSpoutInteropDevice, ESPMode::ThreadSafe> FSpoutInteropDevice::Acquire()
+{
+	FScopeLock Lock(&InstanceLock);
+
+	if (TSharedPtr<FSpoutInteropDevice, ESPMode::ThreadSafe> Existing = Instance.Pin())
+		return Existing;
+
+	if (!Factory.IsValid())
+		Factory = MakeShared<FSpoutD3D11On12DeviceFactory, ESPMode::ThreadSafe>();
+
+	FSpoutInteropDeviceHandles Handles;
+	if (!Factory->Create(Handles))
+		return nullptr;
+
+	TSharedPtr<FSpoutInteropDevice, ESPMode::ThreadSafe> Created(new FSpoutInteropDevice(Factory, Handles));
+	Instance = Created;
+	return Created;
+}
+
+void FSpoutInteropDevice::SetFactory(FSpoutInteropDeviceFactoryPtr InFactory)
+{
+	FScopeLock Lock(&InstanceLock);
+	Factory = MoveTemp(InFactory);
+}
+
+bool FSpoutInteropDevice::IsAlive()
+{
+	FScopeLock Lock(&InstanceLock);
+	return Instance.IsValid();
+}
+
+FSpoutInteropDevice::FSpoutInteropDevice(FSpoutInteropDeviceFactoryPtr InFactory, const FSpoutInteropDeviceHandles& InHandles)
+	: Factory(MoveTemp(InFactory))
+	, Handles(InHandles)
+{}
+
+FSpoutInteropDevice::~FSpoutInteropDevice()
+{
+	Factory->Destroy(Handles);
+}
+
+void FSpoutInteropDevice::QueueCopy(ID3D11Resource* Dst, ID3D11Resource* Src, ID3D11Resource* Wrapped, ISpoutFrameSync* Sync, uint64 Frame)
+{
+	check(IsInRenderingThread());
+	check(Dst && Src);
+
+	Dst->AddRef();
+	Src->AddRef();
+	PendingCopies.Add({ Dst, Src, Sync, Frame });
+
+	if (Wrapped)
+		PendingWrapped.AddUnique(Wrapped);
+}
+
+void FSpoutInteropDevice::Submit()
+{
+	if (PendingCopies.Num() > 0)
+	{
+		Factory->ExecuteCopies(Handles, PendingWrapped, PendingCopies);
+
+		// One acquire and one release call, each transitioning every wrapped resource.
+		INC_DWORD_STAT_BY(STAT_SpoutWrappedCalls, PendingWrapped.Num() > 0 ? 2 : 0);
+		INC_DWORD_STAT_BY(STAT_SpoutWrappedTransitions, PendingWrapped.Num() * 2);
+
+		for (FSpoutInteropCopy& Copy : PendingCopies)
+		{
+			Copy.Dst->Release();
+			Copy.Src->Release();
+		}
+		PendingCopies.Reset();
+		PendingWrapped.Reset();
+	}
+
+	Factory->Flush(Handles);
+	INC_DWORD_STAT(STAT_SpoutInteropFlushes);
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpoutBatch.h"
+
+struct ID3D11Device;
+struct ID3D11DeviceContext;
+struct ID3D11On12Device;
+struct ID3D11Resource;
+class ISpoutFrameSync;
+
+/** The COM objects an interop device is made of. */
+struct FSpoutInteropDeviceHandles
+{
+	ID3D11Device* Device = nullptr;
+	ID3D11DeviceContext* Context = nullptr;
+	ID3D11On12Device* On12Device = nullptr;
+};
+
+/** A copy deferred to the batch's submit, and the frame to signal once it is recorded. */
+struct FSpoutInteropCopy
+{
+	ID3D11Resource* Dst = nullptr;
+	ID3D11Resource* Src = nullptr;
+	ISpoutFrameSync* Sync = nullptr;
+	uint64 Frame = 0;
+};
+
+/**
+ * Creates and destroys the D3D11On12 device behind FSpoutInteropDevice. Split out so
+ * the sharing and lifetime rules do not depend on a real D3D12 device.
+ */
+class ISpoutInteropDeviceFactory
+{
+public:
+	virtual ~ISpoutInteropDeviceFactory() = default;
+
+	/** Returns false, leaving Out untouched, if no device could be created. */
+	virtual bool Create(FSpoutInteropDeviceHandles& Out) = 0;
+
+	virtual void Destroy(FSpoutInteropDeviceHandles& Handles) = 0;
+
+	/**
+	 * Acquires every wrapped resource in one call, records the copies, releases them all
+	 * in one call, then records each copy's sync signal.
+	 */
+	virtual void ExecuteCopies(const FSpoutInteropDeviceHandles& Handles, TConstArrayView<ID3D11Resource*> Wrapped, TConstArrayView<FSpoutInteropCopy> Copies) = 0;
+
+	/** Submits the immediate context's recorded work without waiting for it. */
+	virtual void Flush(const FSpoutInteropDeviceHandles& Handles) = 0;
+};
+
+using FSpoutInteropDeviceFactoryPtr = TSharedPtr<ISpoutInteropDeviceFactory, ESPMode::ThreadSafe>;
+
+/**
+ * Process-wide D3D11On12 device and immediate context shared by every Spout sender and
+ * receiver on the D3D12 RHI, instead of one translation-layer device per component.
+ *
+ * Acquire() hands out references to a single instance: the first call creates it, the
+ * last reference going away destroys it, and the next Acquire() creates a fresh one.
+ * As an ISpoutSubmitQueue it is flushed once per batch for all streams together, and
+ * copies touching wrapped D3D12 resources are deferred to that submit so every wrapped
+ * resource is acquired and released once per frame rather than once per stream.
+ *
+ * The immediate context is not thread safe: record on it from the render thread only.
+ * The device itself may be used from any thread.
+ */
+class FSpoutInteropDevice final : public ISpoutSubmitQueue
+{
+public:
+	/** Shared instance, created on demand. Null if the factory failed. Any thread. */
+	static TSharedPtr<FSpoutInteropDevice, ESPMode::ThreadSafe> Acquire();
+
+	/**
+	 * Factory used by the next Acquire() that has to create a device; null restores the
+	 * D3D12 one. A live instance keeps the factory it was created with.
+	 */
+	static void SetFactory(FSpoutInteropDeviceFactoryPtr InFactory);
+
+	/** Whether an instance currently exists. */
+	static bool IsAlive();
+
+	virtual ~FSpoutInteropDevice() override;
+
+	ID3D11Device* GetDevice() const { return Handles.Device; }
+	ID3D11DeviceContext* GetContext() const { return Handles.Context; }
+	ID3D11On12Device* GetOn12Device() const { return Handles.On12Device; }
+
+	/**
+	 * Defers a copy to this batch's Submit(). Wrapped is whichever of Dst/Src is a wrapped
+	 * D3D12 resource (or null). Sync->Signal(Frame) is recorded after the release.
+	 * Dst and Src are referenced until then. Render thread only; also request the submit.
+	 */
+	void QueueCopy(ID3D11Resource* Dst, ID3D11Resource* Src, ID3D11Resource* Wrapped, ISpoutFrameSync* Sync, uint64 Frame);
+
+	/* -------- ISpoutSubmitQueue -------- */
+	virtual void Submit() override;
+
+private:
+	FSpoutInteropDevice(FSpoutInteropDeviceFactoryPtr InFactory, const FSpoutInteropDeviceHandles& InHandles);
+
+	FSpoutInteropDeviceFactoryPtr Factory;
+	FSpoutInteropDeviceHandles Handles;
+
+	TArray<ID3D11Resource*, TInlineAllocator<8>> PendingWrapped;
+	TArray<FSpoutInteropCopy, TInlineAllocator<8>> PendingCopies;
+};
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Small fixed-capacity least-recently-used cache. Lookups are a linear scan, which
+ * beats hashing at the handful of entries Spout needs (one per shared texture a
+ * sender rotates through), and nothing allocates after construction.
+ *
+ * OnEvict runs for every entry that leaves the cache, whether pushed out by Add,
+ * removed explicitly or dropped by Empty, so it can release whatever the value owns.
+ */
+template <typename KeyType, typename ValueType>
+class TSpoutLruCache
+{
+public:
+	struct FStats
+	{
+		uint64 Hits = 0;
+		uint64 Misses = 0;
+		uint64 Evictions = 0;
+	};
+
+	using FOnEvict = TFunction<void(const KeyType&, ValueType&)>;
+
+	explicit TSpoutLruCache(int32 InCapacity, FOnEvict InOnEvict = nullptr)
+		: Capacity(FMath::Max(1, InCapacity))
+		, OnEvict(MoveTemp(InOnEvict))
+	{
+		Entries.Reserve(Capacity);
+	}
+
+	~TSpoutLruCache()
+	{
+		Empty();
+	}
+
+	/** Returns the cached value and marks it most recently used, or null on a miss. */
+	ValueType* Find(const KeyType& Key)
+	{
+		for (FEntry& Entry : Entries)
+		{
+			if (Entry.Key == Key)
+			{
+				Entry.LastUse = ++UseClock;
+				++Stats.Hits;
+				return &Entry.Value;
+			}
+		}
+		++Stats.Misses;
+		return nullptr;
+	}
+
+	/** Inserts a value for a key that is not cached yet, evicting the least recently used entry if full. */
+	ValueType& Add(const KeyType& Key, ValueType Value)
+	{
+		if (Entries.Num() >= Capacity)
+		{
+			int32 Oldest = 0;
+			for (int32 i = 1; i < Entries.Num(); ++i)
+			{
+				if (Entries[i].LastUse < Entries[Oldest].LastUse)
+					Oldest = i;
+			}
+			EvictAt(Oldest);
+		}
+
+		FEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.Key = Key;
+		Entry.Value = MoveTemp(Value);
+		Entry.LastUse = ++UseClock;
+		return Entry.Value;
+	}
+
+	/** Evicts every entry the predicate accepts. Returns how many were removed. */
+	template <typename PredicateType>
+	int32 RemoveIf(PredicateType Predicate)
+	{
+		int32 NumRemoved = 0;
+		for (int32 i = Entries.Num() - 1; i >= 0; --i)
+		{
+			if (Predicate(Entries[i].Key, Entries[i].Value))
+			{
+				EvictAt(i);
+				++NumRemoved;
+			}
+		}
+		return NumRemoved;
+	}
+
+	void Empty()
+	{
+		while (Entries.Num() > 0)
+			EvictAt(Entries.Num() - 1);
+	}
+
+	int32 Num() const { return Entries.Num(); }
+	int32 GetCapacity() const { return Capacity; }
+	const FStats& GetStats() const { return Stats; }
+
+private:
+	struct FEntry
+	{
+		KeyType Key;
+		ValueType Value;
+		uint64 LastUse = 0;
+	};
+
+	void EvictAt(int32 Index)
+	{
+		if (OnEvict)
+			OnEvict(Entries[Index].Key, Entries[Index].Value);
+
+		Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		++Stats.Evictions;
+	}
+
+	int32 Capacity;
+	FOnEvict OnEvict;
+	TArray<FEntry> Entries;
+	uint64 UseClock = 0;
+	FStats Stats;
+};
@@ -0,0 +1,318 @@
+#include "SpoutMemoryShare.h"
+
+#include "HAL/PlatformMisc.h"
+
+#include "SpoutSharedAtomics.h"
+#include "SpoutSharedMemoryRegion.h"
+#include "SpoutStats.h"
+
+using namespace SpoutSharedAtomics;
+
+namespace
+{
+	FString GetPayloadName(const FString& BaseName, uint32 PayloadId)
+	{
+		return FString::Printf(TEXT("%s_%u"), *BaseName, PayloadId);
+	}
+
+	FSpoutMemorySharePayloadLayout& GetPayloadLayout(const ISpoutSharedMemoryRegion& Payload)
+	{
+		return *reinterpret_cast<FSpoutMemorySharePayloadLayout*>(Payload.GetData());
+	}
+
+	uint8* GetBufferData(const ISpoutSharedMemoryRegion& Payload, int32 Buffer, uint64 BufferSize)
+	{
+		return Payload.GetData() + FSpoutMemorySharePayloadLayout::HeaderSize + Buffer * BufferSize;
+	}
+
+	/** Payload buffers grow in whole pages, so small size changes do not replace the region. */
+	constexpr uint64 BufferGranularity = 64 * 1024;
+}
+
+/* ---------------------------------------------------------------- Writer */
+
+FSpoutMemoryShareWriter::FSpoutMemoryShareWriter(const ANSICHAR* SenderName, TUniquePtr<ISpoutSharedMemoryRegion> InControl)
+	: BaseName(FSpoutMemoryShareReader::GetControlName(SenderName))
+	, Control(MoveTemp(InControl))
+{
+	check(Control.IsValid() && Control->IsWritable() && Control->GetSize() >= sizeof(FSpoutMemoryShareLayout));
+
+	FSpoutMemoryShareLayout& Layout = GetLayout();
+	if (Load(Layout.Magic) != FSpoutMemoryShareLayout::ExpectedMagic)
+	{
+		Layout.Version = FSpoutMemoryShareLayout::CurrentVersion;
+		Store(Layout.Magic, FSpoutMemoryShareLayout::ExpectedMagic);
+	}
+
+	// Taking over from an earlier sender: carry on its counters so readers see newer
+	// frames, and leave its payload name alone. A sender that died mid-publish left
+	// the sequence odd; close it.
+	FrameNumber = Load(Layout.FrameNumber);
+	PayloadId = Load(Layout.PayloadId);
+	const uint64 Sequence = Load(Layout.Sequence);
+	if (Sequence & 1)
+		Store(Layout.Sequence, Sequence + 1);
+}
+
+FSpoutMemoryShareWriter::~FSpoutMemoryShareWriter()
+{
+	// Readers see "no frame" from now on; views they hold keep their mapping.
+	FSpoutMemoryShareLayout& Layout = GetLayout();
+	const uint64 Sequence = Load(Layout.Sequence);
+	Store(Layout.Sequence, Sequence + 1);
+	Store(Layout.Width, 0);
+	Store(Layout.Height, 0);
+	Store(Layout.Sequence, Sequence + 2);
+
+	// On POSIX the names would otherwise outlive the process. Readers still mapping the
+	// control block see the stream end and open the name again to find the next sender.
+	RemovePayload();
+	Control.Reset();
+	SpoutSharedMemory::Remove(TCHAR_TO_ANSI(*BaseName));
+}
+
+TUniquePtr<FSpoutMemoryShareWriter> FSpoutMemoryShareWriter::Create(const ANSICHAR* SenderName)
+{
+	if (!SenderName || !SenderName[0])
+		return nullptr;
+
+	const FString ControlName = FSpoutMemoryShareReader::GetControlName(SenderName);
+	TUniquePtr<ISpoutSharedMemoryRegion> Region = SpoutSharedMemory::Create(TCHAR_TO_ANSI(*ControlName), sizeof(FSpoutMemoryShareLayout));
+	if (!Region.IsValid())
+		return nullptr;
+
+	return MakeUnique<FSpoutMemoryShareWriter>(SenderName, MoveTemp(Region));
+}
+
+FSpoutMemoryShareLayout& FSpoutMemoryShareWriter::GetLayout() const
+{
+	return *reinterpret_cast<FSpoutMemoryShareLayout*>(Control->GetData());
+}
+
+bool FSpoutMemoryShareWriter::EnsurePayload(uint64 Bytes)
+{
+	if (Payload.IsValid() && Bytes <= BufferSize)
+		return true;
+
+	const uint64 NewBufferSize = Align(Bytes, BufferGranularity);
+	const SIZE_T RegionSize = FSpoutMemorySharePayloadLayout::HeaderSize + FSpoutMemoryShareLayout::NumBuffers * NewBufferSize;
+
+	// A fresh id per payload: regions cannot grow while mapped, and a name still held
+	// open elsewhere (e.g. by a reader of a crashed sender) maps at its old size or fails.
+	for (int32 Attempt = 0; Attempt < 8; ++Attempt)
+	{
+		const uint32 NewId = PayloadId + 1 + Attempt;
+		TUniquePtr<ISpoutSharedMemoryRegion> NewPayload = SpoutSharedMemory::Create(TCHAR_TO_ANSI(*GetPayloadName(BaseName, NewId)), RegionSize);
+		if (!NewPayload.IsValid())
+			continue;
+
+		RemovePayload();
+		Payload = MoveTemp(NewPayload);
+		PayloadId = NewId;
+		BufferSize = NewBufferSize;
+		PublishedBuffer = INDEX_NONE;
+
+		FSpoutMemorySharePayloadLayout& PayloadLayout = GetPayloadLayout(*Payload);
+		for (uint64& BufferSequence : PayloadLayout.BufferSequences)
+			Store(BufferSequence, 0);
+
+		return true;
+	}
+	return false;
+}
+
+void FSpoutMemoryShareWriter::RemovePayload()
+{
+	if (!Payload.IsValid())
+		return;
+
+	Payload.Reset();
+	SpoutSharedMemory::Remove(TCHAR_TO_ANSI(*GetPayloadName(BaseName, PayloadId)));
+}
+
+uint8* FSpoutMemoryShareWriter::BeginFrame(uint32 Width, uint32 Height, uint32 DXGIFormat, uint32 RowPitch)
+{
+	check(WritingBuffer == INDEX_NONE);
+	if (Width == 0 || Height == 0 || !EnsurePayload(static_cast<uint64>(RowPitch) * Height))
+		return nullptr;
+
+	// Always the buffer readers were not pointed at last.
+	WritingBuffer = PublishedBuffer == INDEX_NONE ? 0 : (PublishedBuffer + 1) % FSpoutMemoryShareLayout::NumBuffers;
+	PendingWidth = Width;
+	PendingHeight = Height;
+	PendingFormat = DXGIFormat;
+	PendingRowPitch = RowPitch;
+
+	uint64& BufferSequence = GetPayloadLayout(*Payload).BufferSequences[WritingBuffer];
+	Store(BufferSequence, Load(BufferSequence) + 1);
+	FPlatformMisc::MemoryBarrier();
+
+	return GetBufferData(*Payload, WritingBuffer, BufferSize);
+}
+
+void FSpoutMemoryShareWriter::EndFrame()
+{
+	check(WritingBuffer != INDEX_NONE);
+
+	FPlatformMisc::MemoryBarrier();
+	uint64& BufferSequenceRef = GetPayloadLayout(*Payload).BufferSequences[WritingBuffer];
+	const uint64 BufferSequence = Load(BufferSequenceRef) + 1;
+	Store(BufferSequenceRef, BufferSequence);
+
+	FSpoutMemoryShareLayout& Layout = GetLayout();
+	const uint64 Sequence = Load(Layout.Sequence);
+	Store(Layout.Sequence, Sequence + 1);
+
+	Store(Layout.FrameNumber, ++FrameNumber);
+	Store(Layout.Width, PendingWidth);
+	Store(Layout.Height, PendingHeight);
+	Store(Layout.DXGIFormat, PendingFormat);
+	Store(Layout.RowPitch, PendingRowPitch);
+	Store(Layout.Buffer, static_cast<uint32>(WritingBuffer));
+	Store(Layout.PayloadId, PayloadId);
+	Store(Layout.BufferSize, BufferSize);
+	Store(Layout.BufferSequence, BufferSequence);
+
+	Store(Layout.Sequence, Sequence + 2);
+
+	PublishedBuffer = WritingBuffer;
+	WritingBuffer = INDEX_NONE;
+
+	INC_DWORD_STAT(STAT_SpoutMemoryShareFrames);
+}
+
+bool FSpoutMemoryShareWriter::WriteFrame(const void* Src, uint32 SrcPitch, uint32 Width, uint32 Height, uint32 DXGIFormat, uint32 RowBytes)
+{
+	uint8* Dst = BeginFrame(Width, Height, DXGIFormat, RowBytes);
+	if (!Dst)
+		return false;
+
+	if (SrcPitch == RowBytes)
+	{
+		FMemory::Memcpy(Dst, Src, static_cast<SIZE_T>(RowBytes) * Height);
+	}
+	else
+	{
+		for (uint32 Y = 0; Y < Height; ++Y)
+			FMemory::Memcpy(Dst + static_cast<SIZE_T>(Y) * RowBytes, static_cast<const uint8*>(Src) + static_cast<SIZE_T>(Y) * SrcPitch, RowBytes);
+	}
+
+	EndFrame();
+	return true;
+}
+
+/* ---------------------------------------------------------------- Reader */
+
+FSpoutMemoryShareReader::FSpoutMemoryShareReader(const ANSICHAR* SenderName, TUniquePtr<ISpoutSharedMemoryRegion> InControl)
+	: BaseName(GetControlName(SenderName))
+	, Control(MoveTemp(InControl))
+{
+	check(Control.IsValid() && Control->GetSize() >= sizeof(FSpoutMemoryShareLayout));
+}
+
+FSpoutMemoryShareReader::~FSpoutMemoryShareReader() = default;
+
+TUniquePtr<FSpoutMemoryShareReader> FSpoutMemoryShareReader::Open(const ANSICHAR* SenderName)
+{
+	if (!SenderName || !SenderName[0])
+		return nullptr;
+
+	const FString ControlName = GetControlName(SenderName);
+	TUniquePtr<ISpoutSharedMemoryRegion> Region = SpoutSharedMemory::Open(TCHAR_TO_ANSI(*ControlName), sizeof(FSpoutMemoryShareLayout), ESpoutSharedMemoryAccess::ReadOnly);
+	if (!Region.IsValid())
+		return nullptr;
+
+	return MakeUnique<FSpoutMemoryShareReader>(SenderName, MoveTemp(Region));
+}
+
+FString FSpoutMemoryShareReader::GetControlName(const ANSICHAR* SenderName)
+{
+	return FString(ANSI_TO_TCHAR(SenderName)) + TEXT("_memshare");
+}
+
+const FSpoutMemoryShareLayout& FSpoutMemoryShareReader::GetLayout() const
+{
+	return *reinterpret_cast<const FSpoutMemoryShareLayout*>(Control->GetData());
+}
+
+FSpoutMemoryShareReader::EResult FSpoutMemoryShareReader::AcquireFrame(FSpoutMemoryShareFrame& OutFrame)
+{
+	const FSpoutMemoryShareLayout& Layout = GetLayout();
+	if (Load(Layout.Magic) != FSpoutMemoryShareLayout::ExpectedMagic || Load(Layout.Version) != FSpoutMemoryShareLayout::CurrentVersion)
+		return EResult::NoFrame;
+
+	// Seqlock read of the frame description; a publish takes a handful of stores, so a
+	// few retries are plenty.
+	FSpoutMemoryShareFrame Frame;
+	uint32 FramePayloadId = 0;
+	uint64 FrameBufferSize = 0;
+	bool bConsistent = false;
+	for (int32 Attempt = 0; Attempt < 4 && !bConsistent; ++Attempt)
+	{
+		const uint64 Sequence = Load(Layout.Sequence);
+		if (Sequence & 1)
+			continue;
+
+		Frame.FrameNumber = Load(Layout.FrameNumber);
+		Frame.Width = Load(Layout.Width);
+		Frame.Height = Load(Layout.Height);
+		Frame.DXGIFormat = Load(Layout.DXGIFormat);
+		Frame.RowPitch = Load(Layout.RowPitch);
+		Frame.Buffer = static_cast<int32>(Load(Layout.Buffer));
+		FramePayloadId = Load(Layout.PayloadId);
+		FrameBufferSize = Load(Layout.BufferSize);
+		Frame.BufferSequence = Load(Layout.BufferSequence);
+
+		bConsistent = Load(Layout.Sequence) == Sequence;
+	}
+
+	// No size after frames were published: the writer ended the stream.
+	if (bConsistent && Frame.Width == 0 && Frame.FrameNumber != 0)
+		return EResult::Ended;
+
+	if (!bConsistent || Frame.Width == 0 || Frame.Height == 0 || Frame.Buffer < 0 || Frame.Buffer >= FSpoutMemoryShareLayout::NumBuffers)
+		return EResult::NoFrame;
+
+	if (Frame.FrameNumber == LastFrame)
+		return EResult::Unchanged;
+
+	if (static_cast<uint64>(Frame.RowPitch) * Frame.Height > FrameBufferSize)
+		return EResult::NoFrame;
+
+	if (!Payload.IsValid() || PayloadId != FramePayloadId || Payload->GetSize() < FSpoutMemorySharePayloadLayout::HeaderSize + FSpoutMemoryShareLayout::NumBuffers * FrameBufferSize)
+	{
+		// Frames already handed out keep the old mapping alive through their own reference.
+		const SIZE_T RegionSize = FSpoutMemorySharePayloadLayout::HeaderSize + FSpoutMemoryShareLayout::NumBuffers * FrameBufferSize;
+		TUniquePtr<ISpoutSharedMemoryRegion> NewPayload = SpoutSharedMemory::Open(TCHAR_TO_ANSI(*GetPayloadName(BaseName, FramePayloadId)), RegionSize, ESpoutSharedMemoryAccess::ReadOnly);
+		if (!NewPayload.IsValid())
+			return EResult::NoFrame;
+
+		Payload = TSharedPtr<ISpoutSharedMemoryRegion, ESPMode::ThreadSafe>(NewPayload.Release());
+		PayloadId = FramePayloadId;
+	}
+
+	Frame.Payload = Payload;
+	Frame.Data = GetBufferData(*Payload, Frame.Buffer, FrameBufferSize);
+
+	// Already being overwritten: a newer frame is about to be published.
+	if (!IsIntact(Frame))
+		return EResult::NoFrame;
+
+	LastFrame = Frame.FrameNumber;
+	OutFrame = MoveTemp(Frame);
+	return EResult::NewFrame;
+}
+
+bool FSpoutMemoryShareReader::IsIntact(const FSpoutMemoryShareFrame& Frame)
+{
+	if (!Frame.Payload.IsValid() || Frame.Buffer == INDEX_NONE)
+		return false;
+
+	// Orders the caller's reads of Data before the check.
+	FPlatformMisc::MemoryBarrier();
+	const bool bIntact = Load(GetPayloadLayout(*Frame.Payload).BufferSequences[Frame.Buffer]) == Frame.BufferSequence;
+	if (!bIntact)
+		INC_DWORD_STAT(STAT_SpoutMemoryShareTorn);
+
+	return bIntact;
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ISpoutSharedMemoryRegion;
+
+/** Shared-memory layout of a memory-share sender's control block. Plain data, no Windows types. */
+struct FSpoutMemoryShareLayout
+{
+	static constexpr uint32 ExpectedMagic = 0x4D4D5355; // 'USMM'
+	static constexpr uint32 CurrentVersion = 1;
+	static constexpr int32 NumBuffers = 2;
+
+	uint32 Magic;
+	uint32 Version;
+
+	/** Seqlock over the frame description below: odd while the sender publishes. */
+	uint64 Sequence;
+
+	/** Frames published so far; 0 before the first one. */
+	uint64 FrameNumber;
+	/** 0 while there is no frame to read, e.g. after the sender stopped. */
+	uint32 Width;
+	uint32 Height;
+	/** DXGI_FORMAT of the pixels, as in Spout's SharedTextureInfo. */
+	uint32 DXGIFormat;
+	uint32 RowPitch;
+	/** Payload buffer holding the frame. */
+	uint32 Buffer;
+	/** Names the payload region; changes when the payload grows or a new sender takes over. */
+	uint32 PayloadId;
+	/** Bytes per payload buffer. */
+	uint64 BufferSize;
+	/** The buffer's sequence when the frame was published; the pixels are intact while it still matches. */
+	uint64 BufferSequence;
+};
+
+/** Start of a payload region. The buffers follow at HeaderSize, BufferSize bytes each. */
+struct FSpoutMemorySharePayloadLayout
+{
+	/** Keeps the buffers cache-line aligned. */
+	static constexpr SIZE_T HeaderSize = 64;
+
+	/** Per-buffer seqlocks, odd while the sender writes that buffer's pixels. */
+	uint64 BufferSequences[FSpoutMemoryShareLayout::NumBuffers];
+};
+
+static_assert(STRUCT_OFFSET(FSpoutMemoryShareLayout, Sequence) % 8 == 0, "Memory-share sequences must be 8-byte aligned for 64-bit atomics");
+static_assert(sizeof(FSpoutMemorySharePayloadLayout) <= FSpoutMemorySharePayloadLayout::HeaderSize, "Payload header overlaps the first buffer");
+
+/** A published frame as seen by a reader. */
+struct FSpoutMemoryShareFrame
+{
+	/** Points into shared memory: RowPitch * Height bytes. Only valid while IsIntact says so. */
+	const uint8* Data = nullptr;
+	uint64 FrameNumber = 0;
+	uint32 Width = 0;
+	uint32 Height = 0;
+	uint32 DXGIFormat = 0;
+	uint32 RowPitch = 0;
+
+	/** Keeps the mapping Data points into alive, also on other threads. */
+	TSharedPtr<ISpoutSharedMemoryRegion, ESPMode::ThreadSafe> Payload;
+	int32 Buffer = INDEX_NONE;
+	uint64 BufferSequence = 0;
+};
+
+/**
+ * CPU transport for hosts without GPU texture sharing: the sender copies each frame into
+ * one of two buffers in shared memory and publishes it through a seqlock, so neither side
+ * ever takes a lock. Readers get a zero-copy view of the newest frame and check afterwards
+ * that the sender did not start overwriting it meanwhile.
+ *
+ * The control block lives at "<sender>_memshare"; the payload at "<sender>_memshare_<id>",
+ * replaced with a bigger one when frames outgrow it. Works on any ISpoutSharedMemoryRegion
+ * backend, the POSIX one included. One writer per sender name; FSpoutSenderRegistry hands
+ * out the process's one.
+ */
+class FSpoutMemoryShareWriter
+{
+public:
+	/** Control must hold a full FSpoutMemoryShareLayout and be writable. */
+	FSpoutMemoryShareWriter(const ANSICHAR* SenderName, TUniquePtr<ISpoutSharedMemoryRegion> InControl);
+
+	/** Marks the stream as ended and removes the payload and control block names. */
+	~FSpoutMemoryShareWriter();
+
+	/** Creates or takes over SenderName's control block. Null on failure. */
+	static TUniquePtr<FSpoutMemoryShareWriter> Create(const ANSICHAR* SenderName);
+
+	/**
+	 * Buffer for the next frame, RowPitch * Height bytes, which readers are not looking at.
+	 * Fill it and call EndFrame. Null if the payload could not be (re)allocated.
+	 */
+	uint8* BeginFrame(uint32 Width, uint32 Height, uint32 DXGIFormat, uint32 RowPitch);
+
+	/** Publishes the frame started by BeginFrame. */
+	void EndFrame();
+
+	/** BeginFrame, a row-by-row copy from Src, EndFrame. */
+	bool WriteFrame(const void* Src, uint32 SrcPitch, uint32 Width, uint32 Height, uint32 DXGIFormat, uint32 RowBytes);
+
+	uint64 GetFrameNumber() const { return FrameNumber; }
+
+private:
+	FSpoutMemoryShareLayout& GetLayout() const;
+	bool EnsurePayload(uint64 Bytes);
+	void RemovePayload();
+
+	FString BaseName;
+	TUniquePtr<ISpoutSharedMemoryRegion> Control;
+	TUniquePtr<ISpoutSharedMemoryRegion> Payload;
+	uint32 PayloadId = 0;
+	uint64 BufferSize = 0;
+
+	/** Last published state, mirrored so publishing never reads shared memory back */
+	uint64 FrameNumber = 0;
+	int32 PublishedBuffer = INDEX_NONE;
+
+	/** Frame between BeginFrame and EndFrame */
+	int32 WritingBuffer = INDEX_NONE;
+	uint32 PendingWidth = 0;
+	uint32 PendingHeight = 0;
+	uint32 PendingFormat = 0;
+	uint32 PendingRowPitch = 0;
+};
+
+class FSpoutMemoryShareReader
+{
+public:
+	enum class EResult : uint8
+	{
+		NewFrame,
+		/** The newest frame is the one acquired last. */
+		Unchanged,
+		/** The sender has not published a frame or is mid-write; try again later. */
+		NoFrame,
+		/** The sender stopped. Its control block may be gone: Open the name again to follow a new sender. */
+		Ended,
+	};
+
+	/** Control must hold a full FSpoutMemoryShareLayout. */
+	FSpoutMemoryShareReader(const ANSICHAR* SenderName, TUniquePtr<ISpoutSharedMemoryRegion> InControl);
+	~FSpoutMemoryShareReader();
+
+	/** Maps SenderName's control block read-only, or returns null if no memory-share sender created it. */
+	static TUniquePtr<FSpoutMemoryShareReader> Open(const ANSICHAR* SenderName);
+
+	/** Shared-memory name of SenderName's control block. */
+	static FString GetControlName(const ANSICHAR* SenderName);
+
+	/**
+	 * Zero-copy view of the newest frame if it is newer than the last one acquired. Read
+	 * OutFrame.Data, then call IsIntact: if it returns false the data may be torn.
+	 */
+	EResult AcquireFrame(FSpoutMemoryShareFrame& OutFrame);
+
+	/** Whether the sender has left the frame's buffer alone so far. Any thread. */
+	static bool IsIntact(const FSpoutMemoryShareFrame& Frame);
+
+	/** Forgets the last frame acquired, so the newest one is reported as new again. */
+	void Reset() { LastFrame = 0; }
+
+private:
+	const FSpoutMemoryShareLayout& GetLayout() const;
+
+	FString BaseName;
+	TUniquePtr<ISpoutSharedMemoryRegion> Control;
+	TSharedPtr<ISpoutSharedMemoryRegion, ESPMode::ThreadSafe> Payload;
+	uint32 PayloadId = 0;
+	uint64 LastFrame = 0;
+};
@@ -0,0 +1,81 @@
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/OutputDevice.h"
+
+#include "SpoutMemoryShare.h"
+#include "SpoutSharedMemoryRegion.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace
+{
+	/** DXGI_FORMAT_R8G8B8A8_UNORM; the transport does not look at the format. */
+	constexpr uint32 BenchmarkFormat = 28;
+
+	void BenchmarkMemoryShare(const TArray<FString>& Args, FOutputDevice& Ar)
+	{
+		const FString SenderName = FString::Printf(TEXT("UnrealSpoutBenchmark_%u"), FPlatformProcess::GetCurrentProcessId());
+		TUniquePtr<FSpoutMemoryShareWriter> Writer = FSpoutMemoryShareWriter::Create(TCHAR_TO_ANSI(*SenderName));
+		TUniquePtr<FSpoutMemoryShareReader> Reader = FSpoutMemoryShareReader::Open(TCHAR_TO_ANSI(*SenderName));
+		if (!Writer.IsValid() || !Reader.IsValid())
+		{
+			Ar.Log(TEXT("Spout memory share: could not create the shared memory regions."));
+			return;
+		}
+
+		const FIntPoint Sizes[] = { { 640, 360 }, { 1920, 1080 }, { 3840, 2160 } };
+		const int32 NumFrames = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 60;
+
+		TArray<uint8> Source;
+		TArray<uint8> Received;
+		for (const FIntPoint& Size : Sizes)
+		{
+			const uint32 RowBytes = Size.X * 4;
+			Source.SetNumUninitialized(RowBytes * Size.Y);
+			Received.SetNumUninitialized(RowBytes * Size.Y);
+			FMemory::Memset(Source.GetData(), 0x5A, Source.Num());
+
+			double WriteSeconds = 0.0;
+			double ReadSeconds = 0.0;
+			int32 Torn = 0;
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				const double Start = FPlatformTime::Seconds();
+				Writer->WriteFrame(Source.GetData(), RowBytes, Size.X, Size.Y, BenchmarkFormat, RowBytes);
+				const double Written = FPlatformTime::Seconds();
+
+				FSpoutMemoryShareFrame Shared;
+				if (Reader->AcquireFrame(Shared) == FSpoutMemoryShareReader::EResult::NewFrame)
+				{
+					FMemory::Memcpy(Received.GetData(), Shared.Data, Received.Num());
+					Torn += FSpoutMemoryShareReader::IsIntact(Shared) ? 0 : 1;
+				}
+				const double Read = FPlatformTime::Seconds();
+
+				WriteSeconds += Written - Start;
+				ReadSeconds += Read - Written;
+			}
+
+			const double Bytes = static_cast<double>(Source.Num()) * NumFrames;
+			Ar.Logf(TEXT("  %4dx%-4d  publish %6.2f GB/s (%.3f ms)  acquire+copy %6.2f GB/s (%.3f ms)  torn %d"),
+				Size.X, Size.Y,
+				Bytes / WriteSeconds / 1.0e9, WriteSeconds * 1000.0 / NumFrames,
+				Bytes / ReadSeconds / 1.0e9, ReadSeconds * 1000.0 / NumFrames,
+				Torn);
+		}
+
+		// The control block is left for a sender that takes over; nobody will for this name.
+		Reader.Reset();
+		Writer.Reset();
+		SpoutSharedMemory::Remove(TCHAR_TO_ANSI(*FSpoutMemoryShareReader::GetControlName(TCHAR_TO_ANSI(*SenderName))));
+	}
+
+	FAutoConsoleCommandWithArgsAndOutputDevice BenchmarkMemoryShareCommand(
+		TEXT("Spout.BenchmarkMemoryShare"),
+		TEXT("Publishes and reads back RGBA8 frames at 640x360, 1080p and 4K through a private Spout memory share. Optional argument: frames per size (default 60)."),
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&BenchmarkMemoryShare));
+}
+
+#endif
@@ -0,0 +1,331 @@
+#include "SpoutPixelKernels.h"
+#include "SpoutPixelKernelsPrivate.h"
+
+#include <atomic>
+
+namespace SpoutPixelKernels::Private
+{
+	namespace
+	{
+		float HalfToFloat(uint16 Half)
+		{
+			const uint32 Sign = static_cast<uint32>(Half & 0x8000) << 16;
+			const uint32 Exponent = (Half >> 10) & 0x1F;
+			uint32 Mantissa = Half & 0x3FF;
+
+			uint32 Bits;
+			if (Exponent == 0x1F)
+			{
+				Bits = Sign | 0x7F800000 | (Mantissa << 13);
+			}
+			else if (Exponent != 0)
+			{
+				Bits = Sign | ((Exponent + 112) << 23) | (Mantissa << 13);
+			}
+			else if (Mantissa == 0)
+			{
+				Bits = Sign;
+			}
+			else
+			{
+				// Subnormal half: normalise it for the float.
+				uint32 Shift = 0;
+				while ((Mantissa & 0x400) == 0)
+				{
+					Mantissa <<= 1;
+					++Shift;
+				}
+				Bits = Sign | ((113 - Shift) << 23) | ((Mantissa & 0x3FF) << 13);
+			}
+
+			float Value;
+			FMemory::Memcpy(&Value, &Bits, sizeof(Value));
+			return Value;
+		}
+
+		/** Round to nearest even, as F16C's _MM_FROUND_TO_NEAREST_INT does. */
+		uint16 FloatToHalf(float Value)
+		{
+			uint32 Bits;
+			FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+
+			const uint16 Sign = static_cast<uint16>((Bits >> 16) & 0x8000);
+			const uint32 Abs = Bits & 0x7FFFFFFF;
+
+			if (Abs >= 0x7F800000)
+				return Sign | (Abs > 0x7F800000 ? 0x7E00 : 0x7C00);
+
+			// Rounds to infinity.
+			if (Abs >= 0x477FF000)
+				return Sign | 0x7C00;
+
+			if (Abs < 0x38800000)
+			{
+				// Subnormal or zero half.
+				if (Abs < 0x33000000)
+					return Sign;
+
+				const uint32 Shift = 126 - (Abs >> 23);
+				const uint32 Mantissa = (Abs & 0x7FFFFF) | 0x800000;
+				const uint32 Half = Mantissa >> Shift;
+				const uint32 Rest = Mantissa & ((1u << Shift) - 1);
+				const uint32 Midpoint = 1u << (Shift - 1);
+				return Sign | static_cast<uint16>(Half + (Rest > Midpoint || (Rest == Midpoint && (Half & 1))));
+			}
+
+			const uint32 Half = ((Abs >> 13) - (112 << 10));
+			const uint32 Rest = Abs & 0x1FFF;
+			return Sign | static_cast<uint16>(Half + (Rest > 0x1000 || (Rest == 0x1000 && (Half & 1))));
+		}
+
+		uint8 Unorm8FromFloat(float Value)
+		{
+			// Same order of operations as the SIMD variants, so all of them agree bit for bit.
+			Value = Value > 0.0f ? Value : 0.0f;
+			Value = Value < 1.0f ? Value : 1.0f;
+			return static_cast<uint8>(Value * 255.0f + 0.5f);
+		}
+
+		uint32 LoadPixel(const uint8* Src)
+		{
+			uint32 Pixel;
+			FMemory::Memcpy(&Pixel, Src, sizeof(Pixel));
+			return Pixel;
+		}
+
+		void StorePixel(uint8* Dst, uint32 Pixel)
+		{
+			FMemory::Memcpy(Dst, &Pixel, sizeof(Pixel));
+		}
+	}
+
+	namespace Scalar
+	{
+		void Copy32(void* Dst, const void* Src, int32 NumPixels)
+		{
+			if (Dst != Src)
+				FMemory::Memmove(Dst, Src, static_cast<SIZE_T>(NumPixels) * 4);
+		}
+
+		void SwizzleRB(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint8* D = static_cast<uint8*>(Dst);
+			const uint8* S = static_cast<const uint8*>(Src);
+			for (int32 i = 0; i < NumPixels; ++i, D += 4, S += 4)
+			{
+				const uint32 Pixel = LoadPixel(S);
+				StorePixel(D, (Pixel & 0xFF00FF00) | ((Pixel >> 16) & 0xFF) | ((Pixel & 0xFF) << 16));
+			}
+		}
+
+		void RGBToRGBA(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint8* D = static_cast<uint8*>(Dst);
+			const uint8* S = static_cast<const uint8*>(Src);
+			for (int32 i = 0; i < NumPixels; ++i, D += 4, S += 3)
+			{
+				D[0] = S[0];
+				D[1] = S[1];
+				D[2] = S[2];
+				D[3] = 0xFF;
+			}
+		}
+
+		void RGBAToRGB(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint8* D = static_cast<uint8*>(Dst);
+			const uint8* S = static_cast<const uint8*>(Src);
+			for (int32 i = 0; i < NumPixels; ++i, D += 3, S += 4)
+			{
+				D[0] = S[0];
+				D[1] = S[1];
+				D[2] = S[2];
+			}
+		}
+
+		void HalfToUnorm8(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint8* D = static_cast<uint8*>(Dst);
+			const uint16* S = static_cast<const uint16*>(Src);
+			for (int32 i = 0; i < NumPixels * 4; ++i)
+				D[i] = Unorm8FromFloat(HalfToFloat(S[i]));
+		}
+
+		void Unorm8ToHalf(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint16* D = static_cast<uint16*>(Dst);
+			const uint8* S = static_cast<const uint8*>(Src);
+			for (int32 i = 0; i < NumPixels * 4; ++i)
+				D[i] = FloatToHalf(static_cast<float>(S[i]) * (1.0f / 255.0f));
+		}
+
+		void UnpackRGB10A2(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint8* D = static_cast<uint8*>(Dst);
+			const uint8* S = static_cast<const uint8*>(Src);
+			for (int32 i = 0; i < NumPixels; ++i, D += 4, S += 4)
+			{
+				const uint32 Pixel = LoadPixel(S);
+				StorePixel(D,
+					((Pixel >> 2) & 0xFF)
+					| (((Pixel >> 12) & 0xFF) << 8)
+					| (((Pixel >> 22) & 0xFF) << 16)
+					| (((Pixel >> 30) * 85) << 24));
+			}
+		}
+
+		void PackRGB10A2(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint8* D = static_cast<uint8*>(Dst);
+			const uint8* S = static_cast<const uint8*>(Src);
+			for (int32 i = 0; i < NumPixels; ++i, D += 4, S += 4)
+			{
+				const uint32 R = S[0], G = S[1], B = S[2], A = S[3];
+				StorePixel(D,
+					((R << 2) | (R >> 6))
+					| (((G << 2) | (G >> 6)) << 10)
+					| (((B << 2) | (B >> 6)) << 20)
+					| ((A >> 6) << 30));
+			}
+		}
+
+		void Premultiply(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint8* D = static_cast<uint8*>(Dst);
+			const uint8* S = static_cast<const uint8*>(Src);
+			for (int32 i = 0; i < NumPixels; ++i, D += 4, S += 4)
+			{
+				const uint32 A = S[3];
+				for (int32 c = 0; c < 3; ++c)
+				{
+					// Exact round(C * A / 255) without a division.
+					const uint32 T = S[c] * A + 128;
+					D[c] = static_cast<uint8>((T + (T >> 8)) >> 8);
+				}
+				D[3] = static_cast<uint8>(A);
+			}
+		}
+	}
+
+	namespace
+	{
+		struct FKernelTables
+		{
+			FKernelTable Tables[static_cast<int32>(EIsa::Num)];
+
+			FKernelTables()
+			{
+				FKernelTable& ScalarTable = Tables[static_cast<int32>(EIsa::Scalar)];
+				ScalarTable[static_cast<int32>(EKernel::Copy32)] = &Scalar::Copy32;
+				ScalarTable[static_cast<int32>(EKernel::SwizzleRB)] = &Scalar::SwizzleRB;
+				ScalarTable[static_cast<int32>(EKernel::RGBToRGBA)] = &Scalar::RGBToRGBA;
+				ScalarTable[static_cast<int32>(EKernel::RGBAToRGB)] = &Scalar::RGBAToRGB;
+				ScalarTable[static_cast<int32>(EKernel::HalfToUnorm8)] = &Scalar::HalfToUnorm8;
+				ScalarTable[static_cast<int32>(EKernel::Unorm8ToHalf)] = &Scalar::Unorm8ToHalf;
+				ScalarTable[static_cast<int32>(EKernel::UnpackRGB10A2)] = &Scalar::UnpackRGB10A2;
+				ScalarTable[static_cast<int32>(EKernel::PackRGB10A2)] = &Scalar::PackRGB10A2;
+				ScalarTable[static_cast<int32>(EKernel::Premultiply)] = &Scalar::Premultiply;
+
+				// Each level starts from the one below and replaces what it has a variant for.
+				void (*Fill[])(FKernelTable&) = { nullptr, &FillSSE4, &FillAVX2, &FillAVX512 };
+				for (int32 Isa = 1; Isa < static_cast<int32>(EIsa::Num); ++Isa)
+				{
+					FMemory::Memcpy(Tables[Isa], Tables[Isa - 1], sizeof(FKernelTable));
+					Fill[Isa](Tables[Isa]);
+				}
+			}
+		};
+
+		const FKernelTables& GetTables()
+		{
+			static const FKernelTables KernelTables;
+			return KernelTables;
+		}
+
+		EIsa GetSupportedIsaCached()
+		{
+			static const EIsa Supported = DetectIsa();
+			return Supported;
+		}
+
+		std::atomic<uint8> MaxIsa { static_cast<uint8>(EIsa::AVX512) };
+	}
+}
+
+namespace SpoutPixelKernels
+{
+	using namespace Private;
+
+	EIsa GetSupportedIsa()
+	{
+		return GetSupportedIsaCached();
+	}
+
+	EIsa GetActiveIsa()
+	{
+		return static_cast<EIsa>(FMath::Min(static_cast<uint8>(GetSupportedIsaCached()), MaxIsa.load(std::memory_order_relaxed)));
+	}
+
+	void SetMaxIsa(EIsa InMaxIsa)
+	{
+		MaxIsa.store(static_cast<uint8>(InMaxIsa), std::memory_order_relaxed);
+	}
+
+	FRowKernel GetKernel(EKernel Kernel, EIsa Isa)
+	{
+		check(Kernel < EKernel::Num);
+		const EIsa Usable = static_cast<EIsa>(FMath::Min(static_cast<uint8>(Isa), static_cast<uint8>(GetSupportedIsaCached())));
+		return GetTables().Tables[static_cast<int32>(Usable)][static_cast<int32>(Kernel)];
+	}
+
+	int32 GetSrcBytesPerPixel(EKernel Kernel)
+	{
+		switch (Kernel)
+		{
+		case EKernel::RGBToRGBA:		return 3;
+		case EKernel::HalfToUnorm8:		return 8;
+		default:						return 4;
+		}
+	}
+
+	int32 GetDstBytesPerPixel(EKernel Kernel)
+	{
+		switch (Kernel)
+		{
+		case EKernel::RGBAToRGB:		return 3;
+		case EKernel::Unorm8ToHalf:		return 8;
+		default:						return 4;
+		}
+	}
+
+	void ConvertImage(EKernel Kernel, void* Dst, int32 DstPitch, const void* Src, int32 SrcPitch, int32 Width, int32 Height, bool bFlipVertically)
+	{
+		const FRowKernel Row = GetKernel(Kernel);
+		check(!bFlipVertically || Dst != Src);
+
+		for (int32 Y = 0; Y < Height; ++Y)
+		{
+			const int32 SrcY = bFlipVertically ? Height - 1 - Y : Y;
+			Row(static_cast<uint8*>(Dst) + static_cast<SIZE_T>(Y) * DstPitch,
+				static_cast<const uint8*>(Src) + static_cast<SIZE_T>(SrcY) * SrcPitch,
+				Width);
+		}
+	}
+
+	const TCHAR* GetName(EKernel Kernel)
+	{
+		static const TCHAR* Names[] = {
+			TEXT("Copy32"), TEXT("SwizzleRB"), TEXT("RGBToRGBA"), TEXT("RGBAToRGB"), TEXT("HalfToUnorm8"),
+			TEXT("Unorm8ToHalf"), TEXT("UnpackRGB10A2"), TEXT("PackRGB10A2"), TEXT("Premultiply")
+		};
+		static_assert(UE_ARRAY_COUNT(Names) == static_cast<int32>(EKernel::Num), "Name every kernel");
+		return Kernel < EKernel::Num ? Names[static_cast<int32>(Kernel)] : TEXT("?");
+	}
+
+	const TCHAR* GetName(EIsa Isa)
+	{
+		static const TCHAR* Names[] = { TEXT("Scalar"), TEXT("SSE4"), TEXT("AVX2"), TEXT("AVX512") };
+		static_assert(UE_ARRAY_COUNT(Names) == static_cast<int32>(EIsa::Num), "Name every instruction set");
+		return Isa < EIsa::Num ? Names[static_cast<int32>(Isa)] : TEXT("?");
+	}
+}
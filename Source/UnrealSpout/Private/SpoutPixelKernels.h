@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * CPU pixel conversions for CPU-path senders and readbacks, with one implementation per
+ * instruction set (scalar, SSE4.1, AVX2 + F16C, AVX-512) picked at runtime for the CPU
+ * the process runs on. Each kernel converts one row of NumPixels pixels; kernels whose
+ * pixel size does not change also work in place. ConvertImage runs a kernel over pitched
+ * images and can flip them vertically on the way.
+ *
+ * Engine independent.
+ */
+namespace SpoutPixelKernels
+{
+	enum class EIsa : uint8
+	{
+		Scalar,
+		SSE4,
+		/** AVX2 with F16C */
+		AVX2,
+		/** AVX-512 F and BW */
+		AVX512,
+		Num
+	};
+
+	enum class EKernel : uint8
+	{
+		/** 4-byte pixels copied as they are. */
+		Copy32,
+		/** RGBA8 <-> BGRA8. */
+		SwizzleRB,
+		/** RGB8 -> RGBA8 with opaque alpha. */
+		RGBToRGBA,
+		/** RGBA8 -> RGB8, alpha dropped. */
+		RGBAToRGB,
+		/** RGBA16F -> RGBA8 unorm, clamped to [0, 1] and rounded. */
+		HalfToUnorm8,
+		/** RGBA8 unorm -> RGBA16F. */
+		Unorm8ToHalf,
+		/** R10G10B10A2 unorm -> RGBA8. Exact inverse of PackRGB10A2. */
+		UnpackRGB10A2,
+		/** RGBA8 -> R10G10B10A2 unorm, widening by bit replication. */
+		PackRGB10A2,
+		/** RGBA8 colour multiplied by alpha, rounded; alpha unchanged. */
+		Premultiply,
+		Num
+	};
+
+	using FRowKernel = void (*)(void* Dst, const void* Src, int32 NumPixels);
+
+	/** Best instruction set the CPU and OS support. */
+	EIsa GetSupportedIsa();
+
+	/** Instruction set kernels run with: the supported one, unless capped by SetMaxIsa. */
+	EIsa GetActiveIsa();
+
+	/** Caps the instruction set, e.g. to compare variants. Do not call while kernels run. */
+	void SetMaxIsa(EIsa MaxIsa);
+
+	/** Kernel for Isa; kernels without a variant for it use the next lower one. */
+	FRowKernel GetKernel(EKernel Kernel, EIsa Isa);
+
+	inline FRowKernel GetKernel(EKernel Kernel) { return GetKernel(Kernel, GetActiveIsa()); }
+
+	int32 GetSrcBytesPerPixel(EKernel Kernel);
+	int32 GetDstBytesPerPixel(EKernel Kernel);
+
+	/** Converts Width x Height pixels between pitched images. Flipping needs Dst and Src to be different images. */
+	void ConvertImage(EKernel Kernel, void* Dst, int32 DstPitch, const void* Src, int32 SrcPitch, int32 Width, int32 Height, bool bFlipVertically = false);
+
+	const TCHAR* GetName(EKernel Kernel);
+	const TCHAR* GetName(EIsa Isa);
+}
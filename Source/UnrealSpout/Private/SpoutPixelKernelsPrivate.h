@@ -0,0 +1,43 @@
+#pragma once
+
+#include "SpoutPixelKernels.h"
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+	#define SPOUT_PIXEL_KERNELS_X86 1
+#else
+	#define SPOUT_PIXEL_KERNELS_X86 0
+#endif
+
+/** Lets a function use an instruction set the rest of the file is not compiled for. MSVC needs nothing. */
+#if defined(__clang__) || defined(__GNUC__)
+	#define SPOUT_TARGET(Isa) __attribute__((target(Isa)))
+#else
+	#define SPOUT_TARGET(Isa)
+#endif
+
+namespace SpoutPixelKernels::Private
+{
+	using FKernelTable = FRowKernel[static_cast<int32>(EKernel::Num)];
+
+	/** Reference implementations; the SIMD variants use them for the pixels left over. */
+	namespace Scalar
+	{
+		void Copy32(void* Dst, const void* Src, int32 NumPixels);
+		void SwizzleRB(void* Dst, const void* Src, int32 NumPixels);
+		void RGBToRGBA(void* Dst, const void* Src, int32 NumPixels);
+		void RGBAToRGB(void* Dst, const void* Src, int32 NumPixels);
+		void HalfToUnorm8(void* Dst, const void* Src, int32 NumPixels);
+		void Unorm8ToHalf(void* Dst, const void* Src, int32 NumPixels);
+		void UnpackRGB10A2(void* Dst, const void* Src, int32 NumPixels);
+		void PackRGB10A2(void* Dst, const void* Src, int32 NumPixels);
+		void Premultiply(void* Dst, const void* Src, int32 NumPixels);
+	}
+
+	/** Overwrite the entries the instruction set has its own variant for. */
+	void FillSSE4(FKernelTable& Table);
+	void FillAVX2(FKernelTable& Table);
+	void FillAVX512(FKernelTable& Table);
+
+	/** CPUID/XGETBV probe. */
+	EIsa DetectIsa();
+}
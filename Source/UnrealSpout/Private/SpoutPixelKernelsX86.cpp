@@ -0,0 +1,505 @@
+#include "SpoutPixelKernelsPrivate.h"
+
+#if SPOUT_PIXEL_KERNELS_X86
+
+#include <immintrin.h>
+#if defined(__clang__) || defined(__GNUC__)
+	#include <cpuid.h>
+#else
+	#include <intrin.h>
+#endif
+
+namespace SpoutPixelKernels::Private
+{
+	namespace
+	{
+		void Cpuid(int32 Leaf, int32 SubLeaf, int32 Out[4])
+		{
+#if defined(__clang__) || defined(__GNUC__)
+			uint32 A, B, C, D;
+			__cpuid_count(Leaf, SubLeaf, A, B, C, D);
+			Out[0] = A; Out[1] = B; Out[2] = C; Out[3] = D;
+#else
+			__cpuidex(Out, Leaf, SubLeaf);
+#endif
+		}
+
+		/** XCR0: which register states the OS saves on context switch. */
+		uint64 ReadXcr0()
+		{
+#if defined(__clang__) || defined(__GNUC__)
+			uint32 Lo, Hi;
+			__asm__ volatile("xgetbv" : "=a"(Lo), "=d"(Hi) : "c"(0));
+			return (static_cast<uint64>(Hi) << 32) | Lo;
+#else
+			return _xgetbv(0);
+#endif
+		}
+	}
+
+	EIsa DetectIsa()
+	{
+		int32 Regs[4];
+		Cpuid(0, 0, Regs);
+		const int32 MaxLeaf = Regs[0];
+
+		Cpuid(1, 0, Regs);
+		const uint32 Ecx1 = Regs[2];
+		const bool bSSSE3 = (Ecx1 & (1u << 9)) != 0;
+		const bool bSSE41 = (Ecx1 & (1u << 19)) != 0;
+		if (!bSSSE3 || !bSSE41)
+			return EIsa::Scalar;
+
+		const bool bOSXSave = (Ecx1 & (1u << 27)) != 0;
+		const bool bAVX = (Ecx1 & (1u << 28)) != 0;
+		const bool bF16C = (Ecx1 & (1u << 29)) != 0;
+		if (!bOSXSave || !bAVX || !bF16C || MaxLeaf < 7)
+			return EIsa::SSE4;
+
+		// The OS must save the YMM (and for AVX-512 the opmask and ZMM) registers.
+		const uint64 Xcr0 = ReadXcr0();
+		if ((Xcr0 & 0x6) != 0x6)
+			return EIsa::SSE4;
+
+		Cpuid(7, 0, Regs);
+		const uint32 Ebx7 = Regs[1];
+		if ((Ebx7 & (1u << 5)) == 0)
+			return EIsa::SSE4;
+
+		const bool bAVX512F = (Ebx7 & (1u << 16)) != 0;
+		const bool bAVX512BW = (Ebx7 & (1u << 30)) != 0;
+		if (!bAVX512F || !bAVX512BW || (Xcr0 & 0xE6) != 0xE6)
+			return EIsa::AVX2;
+
+		return EIsa::AVX512;
+	}
+
+	/* ---------------------------------------------------------------- SSE4.1 */
+
+	namespace SSE4
+	{
+		SPOUT_TARGET("ssse3,sse4.1")
+		void SwizzleRB(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint8* D = static_cast<uint8*>(Dst);
+			const uint8* S = static_cast<const uint8*>(Src);
+			const __m128i Shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+			int32 i = 0;
+			for (; i + 4 <= NumPixels; i += 4)
+			{
+				const __m128i Pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(S + i * 4));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(D + i * 4), _mm_shuffle_epi8(Pixels, Shuffle));
+			}
+			Scalar::SwizzleRB(D + i * 4, S + i * 4, NumPixels - i);
+		}
+
+		SPOUT_TARGET("ssse3,sse4.1")
+		void RGBToRGBA(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint8* D = static_cast<uint8*>(Dst);
+			const uint8* S = static_cast<const uint8*>(Src);
+			const __m128i Shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+			const __m128i Alpha = _mm_set1_epi32(static_cast<int32>(0xFF000000));
+
+			// Each 16-byte load uses 12; stop while 16 bytes can still be read.
+			int32 i = 0;
+			for (; i + 6 <= NumPixels; i += 4)
+			{
+				const __m128i Pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(S + i * 3));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(D + i * 4), _mm_or_si128(_mm_shuffle_epi8(Pixels, Shuffle), Alpha));
+			}
+			Scalar::RGBToRGBA(D + i * 4, S + i * 3, NumPixels - i);
+		}
+
+		SPOUT_TARGET("ssse3,sse4.1")
+		void RGBAToRGB(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint8* D = static_cast<uint8*>(Dst);
+			const uint8* S = static_cast<const uint8*>(Src);
+			const __m128i Shuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+
+			int32 i = 0;
+			for (; i + 4 <= NumPixels; i += 4)
+			{
+				const __m128i Packed = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(S + i * 4)), Shuffle);
+
+				// 12 bytes out: never write past the end of the row.
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(D + i * 3), Packed);
+				const int32 Tail = _mm_cvtsi128_si32(_mm_srli_si128(Packed, 8));
+				FMemory::Memcpy(D + i * 3 + 8, &Tail, 4);
+			}
+			Scalar::RGBAToRGB(D + i * 3, S + i * 4, NumPixels - i);
+		}
+
+		SPOUT_TARGET("ssse3,sse4.1")
+		void UnpackRGB10A2(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint8* D = static_cast<uint8*>(Dst);
+			const uint8* S = static_cast<const uint8*>(Src);
+			const __m128i Byte = _mm_set1_epi32(0xFF);
+			const __m128i AlphaScale = _mm_set1_epi32(85);
+
+			int32 i = 0;
+			for (; i + 4 <= NumPixels; i += 4)
+			{
+				const __m128i P = _mm_loadu_si128(reinterpret_cast<const __m128i*>(S + i * 4));
+				const __m128i R = _mm_and_si128(_mm_srli_epi32(P, 2), Byte);
+				const __m128i G = _mm_and_si128(_mm_srli_epi32(P, 12), Byte);
+				const __m128i B = _mm_and_si128(_mm_srli_epi32(P, 22), Byte);
+				const __m128i A = _mm_mullo_epi32(_mm_srli_epi32(P, 30), AlphaScale);
+				const __m128i Out = _mm_or_si128(_mm_or_si128(R, _mm_slli_epi32(G, 8)), _mm_or_si128(_mm_slli_epi32(B, 16), _mm_slli_epi32(A, 24)));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(D + i * 4), Out);
+			}
+			Scalar::UnpackRGB10A2(D + i * 4, S + i * 4, NumPixels - i);
+		}
+
+		SPOUT_TARGET("ssse3,sse4.1")
+		void PackRGB10A2(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint8* D = static_cast<uint8*>(Dst);
+			const uint8* S = static_cast<const uint8*>(Src);
+			const __m128i Byte = _mm_set1_epi32(0xFF);
+
+			int32 i = 0;
+			for (; i + 4 <= NumPixels; i += 4)
+			{
+				const __m128i P = _mm_loadu_si128(reinterpret_cast<const __m128i*>(S + i * 4));
+				const __m128i R = _mm_and_si128(P, Byte);
+				const __m128i G = _mm_and_si128(_mm_srli_epi32(P, 8), Byte);
+				const __m128i B = _mm_and_si128(_mm_srli_epi32(P, 16), Byte);
+				const __m128i A = _mm_srli_epi32(P, 30);
+				const __m128i R10 = _mm_or_si128(_mm_slli_epi32(R, 2), _mm_srli_epi32(R, 6));
+				const __m128i G10 = _mm_or_si128(_mm_slli_epi32(G, 2), _mm_srli_epi32(G, 6));
+				const __m128i B10 = _mm_or_si128(_mm_slli_epi32(B, 2), _mm_srli_epi32(B, 6));
+				const __m128i Out = _mm_or_si128(_mm_or_si128(R10, _mm_slli_epi32(G10, 10)), _mm_or_si128(_mm_slli_epi32(B10, 20), _mm_slli_epi32(A, 30)));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(D + i * 4), Out);
+			}
+			Scalar::PackRGB10A2(D + i * 4, S + i * 4, NumPixels - i);
+		}
+
+		SPOUT_TARGET("ssse3,sse4.1")
+		void Premultiply(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint8* D = static_cast<uint8*>(Dst);
+			const uint8* S = static_cast<const uint8*>(Src);
+			const __m128i AlphaLo = _mm_setr_epi8(3, -1, 3, -1, 3, -1, 3, -1, 7, -1, 7, -1, 7, -1, 7, -1);
+			const __m128i AlphaHi = _mm_setr_epi8(11, -1, 11, -1, 11, -1, 11, -1, 15, -1, 15, -1, 15, -1, 15, -1);
+			const __m128i AlphaMask = _mm_set1_epi32(static_cast<int32>(0xFF000000));
+			const __m128i Half = _mm_set1_epi16(128);
+
+			int32 i = 0;
+			for (; i + 4 <= NumPixels; i += 4)
+			{
+				const __m128i P = _mm_loadu_si128(reinterpret_cast<const __m128i*>(S + i * 4));
+
+				// Round(C * A / 255) as (T + (T >> 8)) >> 8 with T = C * A + 128, in 16-bit lanes.
+				__m128i Lo = _mm_add_epi16(_mm_mullo_epi16(_mm_cvtepu8_epi16(P), _mm_shuffle_epi8(P, AlphaLo)), Half);
+				__m128i Hi = _mm_add_epi16(_mm_mullo_epi16(_mm_cvtepu8_epi16(_mm_srli_si128(P, 8)), _mm_shuffle_epi8(P, AlphaHi)), Half);
+				Lo = _mm_srli_epi16(_mm_add_epi16(Lo, _mm_srli_epi16(Lo, 8)), 8);
+				Hi = _mm_srli_epi16(_mm_add_epi16(Hi, _mm_srli_epi16(Hi, 8)), 8);
+
+				const __m128i Out = _mm_blendv_epi8(_mm_packus_epi16(Lo, Hi), P, AlphaMask);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(D + i * 4), Out);
+			}
+			Scalar::Premultiply(D + i * 4, S + i * 4, NumPixels - i);
+		}
+	}
+
+	void FillSSE4(FKernelTable& Table)
+	{
+		Table[static_cast<int32>(EKernel::SwizzleRB)] = &SSE4::SwizzleRB;
+		Table[static_cast<int32>(EKernel::RGBToRGBA)] = &SSE4::RGBToRGBA;
+		Table[static_cast<int32>(EKernel::RGBAToRGB)] = &SSE4::RGBAToRGB;
+		Table[static_cast<int32>(EKernel::UnpackRGB10A2)] = &SSE4::UnpackRGB10A2;
+		Table[static_cast<int32>(EKernel::PackRGB10A2)] = &SSE4::PackRGB10A2;
+		Table[static_cast<int32>(EKernel::Premultiply)] = &SSE4::Premultiply;
+	}
+
+	/* ---------------------------------------------------------------- AVX2 + F16C */
+
+	namespace AVX2
+	{
+		SPOUT_TARGET("avx2")
+		void SwizzleRB(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint8* D = static_cast<uint8*>(Dst);
+			const uint8* S = static_cast<const uint8*>(Src);
+			const __m256i Shuffle = _mm256_setr_epi8(
+				2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+				2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+			int32 i = 0;
+			for (; i + 8 <= NumPixels; i += 8)
+			{
+				const __m256i Pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(S + i * 4));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(D + i * 4), _mm256_shuffle_epi8(Pixels, Shuffle));
+			}
+			SSE4::SwizzleRB(D + i * 4, S + i * 4, NumPixels - i);
+		}
+
+		SPOUT_TARGET("avx2,f16c")
+		void HalfToUnorm8(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint8* D = static_cast<uint8*>(Dst);
+			const uint16* S = static_cast<const uint16*>(Src);
+			const __m256 Zero = _mm256_setzero_ps();
+			const __m256 One = _mm256_set1_ps(1.0f);
+			const __m256 Scale = _mm256_set1_ps(255.0f);
+			const __m256 Round = _mm256_set1_ps(0.5f);
+
+			// 16 channels (4 pixels) per iteration.
+			const int32 NumValues = NumPixels * 4;
+			int32 i = 0;
+			for (; i + 16 <= NumValues; i += 16)
+			{
+				__m256 A = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(S + i)));
+				__m256 B = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(S + i + 8)));
+
+				// max(x, 0) first: it also turns NaN into 0, like the scalar path.
+				A = _mm256_add_ps(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(A, Zero), One), Scale), Round);
+				B = _mm256_add_ps(_mm256_mul_ps(_mm256_min_ps(_mm256_max_ps(B, Zero), One), Scale), Round);
+
+				const __m256i IA = _mm256_cvttps_epi32(A);
+				const __m256i IB = _mm256_cvttps_epi32(B);
+				const __m128i WA = _mm_packus_epi32(_mm256_castsi256_si128(IA), _mm256_extracti128_si256(IA, 1));
+				const __m128i WB = _mm_packus_epi32(_mm256_castsi256_si128(IB), _mm256_extracti128_si256(IB, 1));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(D + i), _mm_packus_epi16(WA, WB));
+			}
+			Scalar::HalfToUnorm8(D + i, S + i, (NumValues - i) / 4);
+		}
+
+		SPOUT_TARGET("avx2,f16c")
+		void Unorm8ToHalf(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint16* D = static_cast<uint16*>(Dst);
+			const uint8* S = static_cast<const uint8*>(Src);
+			const __m256 Scale = _mm256_set1_ps(1.0f / 255.0f);
+
+			// 8 channels (2 pixels) per iteration.
+			const int32 NumValues = NumPixels * 4;
+			int32 i = 0;
+			for (; i + 8 <= NumValues; i += 8)
+			{
+				const __m256i Values = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(S + i)));
+				const __m256 Floats = _mm256_mul_ps(_mm256_cvtepi32_ps(Values), Scale);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(D + i), _mm256_cvtps_ph(Floats, _MM_FROUND_TO_NEAREST_INT));
+			}
+			Scalar::Unorm8ToHalf(D + i, S + i, (NumValues - i) / 4);
+		}
+
+		SPOUT_TARGET("avx2")
+		void UnpackRGB10A2(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint8* D = static_cast<uint8*>(Dst);
+			const uint8* S = static_cast<const uint8*>(Src);
+			const __m256i Byte = _mm256_set1_epi32(0xFF);
+			const __m256i AlphaScale = _mm256_set1_epi32(85);
+
+			int32 i = 0;
+			for (; i + 8 <= NumPixels; i += 8)
+			{
+				const __m256i P = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(S + i * 4));
+				const __m256i R = _mm256_and_si256(_mm256_srli_epi32(P, 2), Byte);
+				const __m256i G = _mm256_and_si256(_mm256_srli_epi32(P, 12), Byte);
+				const __m256i B = _mm256_and_si256(_mm256_srli_epi32(P, 22), Byte);
+				const __m256i A = _mm256_mullo_epi32(_mm256_srli_epi32(P, 30), AlphaScale);
+				const __m256i Out = _mm256_or_si256(_mm256_or_si256(R, _mm256_slli_epi32(G, 8)), _mm256_or_si256(_mm256_slli_epi32(B, 16), _mm256_slli_epi32(A, 24)));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(D + i * 4), Out);
+			}
+			SSE4::UnpackRGB10A2(D + i * 4, S + i * 4, NumPixels - i);
+		}
+
+		SPOUT_TARGET("avx2")
+		void PackRGB10A2(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint8* D = static_cast<uint8*>(Dst);
+			const uint8* S = static_cast<const uint8*>(Src);
+			const __m256i Byte = _mm256_set1_epi32(0xFF);
+
+			int32 i = 0;
+			for (; i + 8 <= NumPixels; i += 8)
+			{
+				const __m256i P = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(S + i * 4));
+				const __m256i R = _mm256_and_si256(P, Byte);
+				const __m256i G = _mm256_and_si256(_mm256_srli_epi32(P, 8), Byte);
+				const __m256i B = _mm256_and_si256(_mm256_srli_epi32(P, 16), Byte);
+				const __m256i A = _mm256_srli_epi32(P, 30);
+				const __m256i R10 = _mm256_or_si256(_mm256_slli_epi32(R, 2), _mm256_srli_epi32(R, 6));
+				const __m256i G10 = _mm256_or_si256(_mm256_slli_epi32(G, 2), _mm256_srli_epi32(G, 6));
+				const __m256i B10 = _mm256_or_si256(_mm256_slli_epi32(B, 2), _mm256_srli_epi32(B, 6));
+				const __m256i Out = _mm256_or_si256(_mm256_or_si256(R10, _mm256_slli_epi32(G10, 10)), _mm256_or_si256(_mm256_slli_epi32(B10, 20), _mm256_slli_epi32(A, 30)));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(D + i * 4), Out);
+			}
+			SSE4::PackRGB10A2(D + i * 4, S + i * 4, NumPixels - i);
+		}
+
+		SPOUT_TARGET("avx2")
+		void Premultiply(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint8* D = static_cast<uint8*>(Dst);
+			const uint8* S = static_cast<const uint8*>(Src);
+			// Alpha of each widened pixel, per 128-bit lane (shuffles do not cross lanes).
+			const __m256i AlphaWords = _mm256_setr_epi8(
+				6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15,
+				6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15);
+			const __m256i AlphaMask = _mm256_set1_epi32(static_cast<int32>(0xFF000000));
+			const __m256i Half = _mm256_set1_epi16(128);
+
+			int32 i = 0;
+			for (; i + 8 <= NumPixels; i += 8)
+			{
+				const __m256i P = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(S + i * 4));
+
+				__m256i Lo = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(P));
+				__m256i Hi = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(P, 1));
+				Lo = _mm256_add_epi16(_mm256_mullo_epi16(Lo, _mm256_shuffle_epi8(Lo, AlphaWords)), Half);
+				Hi = _mm256_add_epi16(_mm256_mullo_epi16(Hi, _mm256_shuffle_epi8(Hi, AlphaWords)), Half);
+				Lo = _mm256_srli_epi16(_mm256_add_epi16(Lo, _mm256_srli_epi16(Lo, 8)), 8);
+				Hi = _mm256_srli_epi16(_mm256_add_epi16(Hi, _mm256_srli_epi16(Hi, 8)), 8);
+
+				// packus works per lane; put the 64-bit pixel pairs back in order.
+				const __m256i Packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(Lo, Hi), _MM_SHUFFLE(3, 1, 2, 0));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(D + i * 4), _mm256_blendv_epi8(Packed, P, AlphaMask));
+			}
+			SSE4::Premultiply(D + i * 4, S + i * 4, NumPixels - i);
+		}
+	}
+
+	void FillAVX2(FKernelTable& Table)
+	{
+		Table[static_cast<int32>(EKernel::SwizzleRB)] = &AVX2::SwizzleRB;
+		Table[static_cast<int32>(EKernel::HalfToUnorm8)] = &AVX2::HalfToUnorm8;
+		Table[static_cast<int32>(EKernel::Unorm8ToHalf)] = &AVX2::Unorm8ToHalf;
+		Table[static_cast<int32>(EKernel::UnpackRGB10A2)] = &AVX2::UnpackRGB10A2;
+		Table[static_cast<int32>(EKernel::PackRGB10A2)] = &AVX2::PackRGB10A2;
+		Table[static_cast<int32>(EKernel::Premultiply)] = &AVX2::Premultiply;
+	}
+
+	/* ---------------------------------------------------------------- AVX-512 F + BW */
+
+	namespace AVX512
+	{
+		SPOUT_TARGET("avx512f,avx512bw")
+		void SwizzleRB(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint8* D = static_cast<uint8*>(Dst);
+			const uint8* S = static_cast<const uint8*>(Src);
+			const __m512i Shuffle = _mm512_broadcast_i32x4(_mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15));
+
+			int32 i = 0;
+			for (; i + 16 <= NumPixels; i += 16)
+			{
+				const __m512i Pixels = _mm512_loadu_si512(S + i * 4);
+				_mm512_storeu_si512(D + i * 4, _mm512_shuffle_epi8(Pixels, Shuffle));
+			}
+			AVX2::SwizzleRB(D + i * 4, S + i * 4, NumPixels - i);
+		}
+
+		SPOUT_TARGET("avx512f,avx512bw,f16c")
+		void HalfToUnorm8(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint8* D = static_cast<uint8*>(Dst);
+			const uint16* S = static_cast<const uint16*>(Src);
+			const __m512 Zero = _mm512_setzero_ps();
+			const __m512 One = _mm512_set1_ps(1.0f);
+			const __m512 Scale = _mm512_set1_ps(255.0f);
+			const __m512 Round = _mm512_set1_ps(0.5f);
+
+			const int32 NumValues = NumPixels * 4;
+			int32 i = 0;
+			for (; i + 16 <= NumValues; i += 16)
+			{
+				__m512 V = _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(S + i)));
+				V = _mm512_add_ps(_mm512_mul_ps(_mm512_min_ps(_mm512_max_ps(V, Zero), One), Scale), Round);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(D + i), _mm512_cvtusepi32_epi8(_mm512_cvttps_epu32(V)));
+			}
+			AVX2::HalfToUnorm8(D + i, S + i, (NumValues - i) / 4);
+		}
+
+		SPOUT_TARGET("avx512f,avx512bw,f16c")
+		void Unorm8ToHalf(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint16* D = static_cast<uint16*>(Dst);
+			const uint8* S = static_cast<const uint8*>(Src);
+			const __m512 Scale = _mm512_set1_ps(1.0f / 255.0f);
+
+			const int32 NumValues = NumPixels * 4;
+			int32 i = 0;
+			for (; i + 16 <= NumValues; i += 16)
+			{
+				const __m512i Values = _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(S + i)));
+				const __m512 Floats = _mm512_mul_ps(_mm512_cvtepi32_ps(Values), Scale);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(D + i), _mm512_cvtps_ph(Floats, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+			}
+			AVX2::Unorm8ToHalf(D + i, S + i, (NumValues - i) / 4);
+		}
+
+		SPOUT_TARGET("avx512f,avx512bw")
+		void UnpackRGB10A2(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint8* D = static_cast<uint8*>(Dst);
+			const uint8* S = static_cast<const uint8*>(Src);
+			const __m512i Byte = _mm512_set1_epi32(0xFF);
+			const __m512i AlphaScale = _mm512_set1_epi32(85);
+
+			int32 i = 0;
+			for (; i + 16 <= NumPixels; i += 16)
+			{
+				const __m512i P = _mm512_loadu_si512(S + i * 4);
+				const __m512i R = _mm512_and_si512(_mm512_srli_epi32(P, 2), Byte);
+				const __m512i G = _mm512_and_si512(_mm512_srli_epi32(P, 12), Byte);
+				const __m512i B = _mm512_and_si512(_mm512_srli_epi32(P, 22), Byte);
+				const __m512i A = _mm512_mullo_epi32(_mm512_srli_epi32(P, 30), AlphaScale);
+				const __m512i Out = _mm512_or_si512(_mm512_or_si512(R, _mm512_slli_epi32(G, 8)), _mm512_or_si512(_mm512_slli_epi32(B, 16), _mm512_slli_epi32(A, 24)));
+				_mm512_storeu_si512(D + i * 4, Out);
+			}
+			AVX2::UnpackRGB10A2(D + i * 4, S + i * 4, NumPixels - i);
+		}
+
+		SPOUT_TARGET("avx512f,avx512bw")
+		void PackRGB10A2(void* Dst, const void* Src, int32 NumPixels)
+		{
+			uint8* D = static_cast<uint8*>(Dst);
+			const uint8* S = static_cast<const uint8*>(Src);
+			const __m512i Byte = _mm512_set1_epi32(0xFF);
+
+			int32 i = 0;
+			for (; i + 16 <= NumPixels; i += 16)
+			{
+				const __m512i P = _mm512_loadu_si512(S + i * 4);
+				const __m512i R = _mm512_and_si512(P, Byte);
+				const __m512i G = _mm512_and_si512(_mm512_srli_epi32(P, 8), Byte);
+				const __m512i B = _mm512_and_si512(_mm512_srli_epi32(P, 16), Byte);
+				const __m512i A = _mm512_srli_epi32(P, 30);
+				const __m512i R10 = _mm512_or_si512(_mm512_slli_epi32(R, 2), _mm512_srli_epi32(R, 6));
+				const __m512i G10 = _mm512_or_si512(_mm512_slli_epi32(G, 2), _mm512_srli_epi32(G, 6));
+				const __m512i B10 = _mm512_or_si512(_mm512_slli_epi32(B, 2), _mm512_srli_epi32(B, 6));
+				const __m512i Out = _mm512_or_si512(_mm512_or_si512(R10, _mm512_slli_epi32(G10, 10)), _mm512_or_si512(_mm512_slli_epi32(B10, 20), _mm512_slli_epi32(A, 30)));
+				_mm512_storeu_si512(D + i * 4, Out);
+			}
+			AVX2::PackRGB10A2(D + i * 4, S + i * 4, NumPixels - i);
+		}
+	}
+
+	void FillAVX512(FKernelTable& Table)
+	{
+		Table[static_cast<int32>(EKernel::SwizzleRB)] = &AVX512::SwizzleRB;
+		Table[static_cast<int32>(EKernel::HalfToUnorm8)] = &AVX512::HalfToUnorm8;
+		Table[static_cast<int32>(EKernel::Unorm8ToHalf)] = &AVX512::Unorm8ToHalf;
+		Table[static_cast<int32>(EKernel::UnpackRGB10A2)] = &AVX512::UnpackRGB10A2;
+		Table[static_cast<int32>(EKernel::PackRGB10A2)] = &AVX512::PackRGB10A2;
+	}
+}
+
+#else
+
+namespace SpoutPixelKernels::Private
+{
+	EIsa DetectIsa() { return EIsa::Scalar; }
+	void FillSSE4(FKernelTable&) {}
+	void FillAVX2(FKernelTable&) {}
+	void FillAVX512(FKernelTable&) {}
+}
+
+#endif
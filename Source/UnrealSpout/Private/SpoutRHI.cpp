@@ -0,0 +1,40 @@
+#include "SpoutRHI.h"
+
+#include "DynamicRHI.h"
+
+namespace
+{
+	ESpoutRHIBackend ResolveBackend()
+	{
+		check(GDynamicRHI);
+
+		const FString RHIName = GDynamicRHI->GetName();
+		if (RHIName == TEXT("D3D11"))
+			return ESpoutRHIBackend::D3D11;
+		if (RHIName == TEXT("D3D12"))
+			return ESpoutRHIBackend::D3D12;
+		return ESpoutRHIBackend::Unsupported;
+	}
+}
+
+ESpoutRHIBackend SpoutRHI::GetBackend()
+{
+	// The dynamic RHI never changes once created.
+	static const ESpoutRHIBackend Backend = ResolveBackend();
+	return Backend;
+}
+
+ESpoutSharePath SpoutRHI::SelectSharePath(ESpoutRHIBackend Backend, bool bPreferNative, const FSpoutNativeShareCaps& Caps)
+{
+	switch (Backend)
+	{
+	case ESpoutRHIBackend::D3D11:
+		return ESpoutSharePath::D3D11;
+	case ESpoutRHIBackend::D3D12:
+		return bPreferNative && Caps.bOpenedSharedTextures && Caps.bCreatedFence
+			? ESpoutSharePath::NativeD3D12
+			: ESpoutSharePath::D3D11On12;
+	default:
+		return ESpoutSharePath::Unsupported;
+	}
+}
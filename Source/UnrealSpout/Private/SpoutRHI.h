@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** The RHIs Spout can share textures from. */
+enum class ESpoutRHIBackend : uint8
+{
+	Unsupported,
+	D3D11,
+	D3D12,
+};
+
+/** How a sender gets frames from the RHI's texture into its shared textures. */
+enum class ESpoutSharePath : uint8
+{
+	Unsupported,
+	/** CopyResource on the RHI's own D3D11 immediate context. */
+	D3D11,
+	/** Wrapped resource copied through the shared 11on12 device. */
+	D3D11On12,
+	/** Copy recorded on the RHI's D3D12 command list into the shared textures opened on the D3D12 device. */
+	NativeD3D12,
+};
+
+/** What the native D3D12 path managed to set up on this device and driver. */
+struct FSpoutNativeShareCaps
+{
+	/** Every shared texture opened on the D3D12 device through OpenSharedHandle. */
+	bool bOpenedSharedTextures = false;
+	/** An ID3D12Fence could be created and signalled on the RHI's queue. */
+	bool bCreatedFence = false;
+};
+
+namespace SpoutRHI
+{
+	/** Backend of the running dynamic RHI, resolved from its name on first use and cached. */
+	ESpoutRHIBackend GetBackend();
+
+	/** Picks the share path; native D3D12 only when asked for and fully set up, else 11on12. Pure. */
+	ESpoutSharePath SelectSharePath(ESpoutRHIBackend Backend, bool bPreferNative, const FSpoutNativeShareCaps& Caps);
+}
@@ -0,0 +1,202 @@
+#include "SpoutReadback.h"
+
+#include "RHICommandList.h"
+#include "RHIGPUReadback.h"
+#include "Misc/ScopeLock.h"
+
+#include "SpoutFormats.h"
+#include "SpoutMemoryShare.h"
+#include "SpoutPixelKernels.h"
+#include "SpoutStats.h"
+
+namespace
+{
+	/** Kernel turning a row of Format into RGBA8, if there is one. */
+	bool GetRGBA8Kernel(EPixelFormat Format, SpoutPixelKernels::EKernel& OutKernel)
+	{
+		using SpoutPixelKernels::EKernel;
+		switch (Format)
+		{
+		case PF_R8G8B8A8:		OutKernel = EKernel::Copy32; return true;
+		case PF_B8G8R8A8:		OutKernel = EKernel::SwizzleRB; return true;
+		case PF_FloatRGBA:		OutKernel = EKernel::HalfToUnorm8; return true;
+		case PF_A2B10G10R10:	OutKernel = EKernel::UnpackRGB10A2; return true;
+		default:				return false;
+		}
+	}
+}
+
+FSpoutReadback::FSpoutReadback(int32 NumBuffers, int32 Latency, bool bInConvertToRGBA8)
+	: Ring(NumBuffers, Latency)
+	, bConvertToRGBA8(bInConvertToRGBA8)
+	, Frames(Ring.Num() + QueueCapacity)
+	, Queue(QueueCapacity)
+{
+	Buffers.Reserve(Ring.Num());
+	for (int32 i = 0; i < Ring.Num(); ++i)
+		Buffers.Add(MakeUnique<FRHIGPUTextureReadback>(TEXT("SpoutReadback")));
+
+	Copies.SetNum(Ring.Num());
+}
+
+bool FSpoutReadback::Sync(TSharedPtr<FSpoutReadback, ESPMode::ThreadSafe>& Readback, bool bEnable, int32 NumBuffers, int32 Latency, bool bConvertToRGBA8, const FSpoutReadbackCallback& Callback)
+{
+	if (!bEnable)
+	{
+		const bool bChanged = Readback.IsValid();
+		Readback.Reset();
+		return bChanged;
+	}
+
+	// Compare against what the ring makes of the settings, not the raw values.
+	const FSpoutReadbackRing Wanted(NumBuffers, Latency);
+	if (Readback.IsValid() && Readback->GetNumBuffers() == Wanted.Num() && Readback->GetLatency() == Wanted.GetLatency()
+		&& Readback->ConvertsToRGBA8() == bConvertToRGBA8)
+		return false;
+
+	Readback = MakeShared<FSpoutReadback, ESPMode::ThreadSafe>(NumBuffers, Latency, bConvertToRGBA8);
+	Readback->SetCallback(Callback);
+	return true;
+}
+
+FSpoutReadback::~FSpoutReadback()
+{
+	// Callbacks still queued hold frames from our pool.
+	CallbackPipe.WaitUntilEmpty();
+}
+
+void FSpoutReadback::SetCallback(FSpoutReadbackCallback InCallback)
+{
+	FScopeLock ScopeLock(&CallbackLock);
+	Callback = MoveTemp(InCallback);
+}
+
+void FSpoutReadback::SetMemoryShare(TSharedPtr<FSpoutMemoryShareWriter, ESPMode::ThreadSafe> Writer)
+{
+	FScopeLock ScopeLock(&CallbackLock);
+	MemoryShare = MoveTemp(Writer);
+}
+
+bool FSpoutReadback::Dequeue(TSharedPtr<FSpoutReadbackFrame, ESPMode::ThreadSafe>& OutFrame)
+{
+	return Queue.Dequeue(OutFrame);
+}
+
+void FSpoutReadback::Process_RenderThread(FRHICommandListImmediate& RHICmdList, FRHITexture* Texture)
+{
+	check(IsInRenderingThread());
+	++ProcessCount;
+
+	// Oldest first, so frames are delivered in order; stop at the first one the GPU has not finished.
+	for (int32 Buffer = Ring.PeekReady(ProcessCount); Buffer != INDEX_NONE; Buffer = Ring.PeekReady(ProcessCount))
+	{
+		FRHIGPUTextureReadback& Readback = *Buffers[Buffer];
+		if (!Readback.IsReady())
+			break;
+
+		const FCopy& Copy = Copies[Buffer];
+		const bool bDeliver = bDeliverFrames.load(std::memory_order_relaxed);
+		TSharedPtr<FSpoutReadbackFrame, ESPMode::ThreadSafe> Frame = bDeliver ? Frames.Acquire() : nullptr;
+
+		TSharedPtr<FSpoutMemoryShareWriter, ESPMode::ThreadSafe> MemoryShareWriter;
+		{
+			FScopeLock ScopeLock(&CallbackLock);
+			MemoryShareWriter = MemoryShare;
+		}
+
+		int32 RowPitchInPixels = 0;
+		const uint8* Src = Frame.IsValid() || MemoryShareWriter.IsValid() ? static_cast<const uint8*>(Readback.Lock(RowPitchInPixels)) : nullptr;
+		if (Src)
+		{
+			const uint32 BlockBytes = GPixelFormats[Copy.Format].BlockBytes;
+			const uint32 SrcPitch = RowPitchInPixels * BlockBytes;
+
+			// Straight from the staging texture into shared memory, without an extra copy.
+			if (MemoryShareWriter.IsValid())
+				MemoryShareWriter->WriteFrame(Src, SrcPitch, Copy.Size.X, Copy.Size.Y, SpoutFormats::ToDXGI(Copy.Format), Copy.Size.X * BlockBytes);
+
+			if (Frame.IsValid())
+				CopyOut(*Frame, Copy, Src, SrcPitch);
+
+			Readback.Unlock();
+		}
+
+		if (Src && Frame.IsValid())
+		{
+			Frame->Size = Copy.Size;
+			Frame->FrameNumber = Copy.Number;
+			Deliver(MoveTemp(Frame));
+		}
+		else if (bDeliver)
+		{
+			// The consumer still holds every frame.
+			INC_DWORD_STAT(STAT_SpoutReadbackDropped);
+		}
+
+		Ring.Release(Buffer);
+		NumInFlight.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	if (!Texture)
+		return;
+
+	const int32 Buffer = Ring.BeginCopy(ProcessCount);
+	if (Buffer == INDEX_NONE)
+	{
+		INC_DWORD_STAT(STAT_SpoutReadbackDropped);
+		return;
+	}
+
+	const FRHITextureDesc& Desc = Texture->GetDesc();
+	Copies[Buffer] = { Desc.Extent, Desc.Format, ++CopyCount };
+
+	RHICmdList.Transition(FRHITransitionInfo(Texture, ERHIAccess::Unknown, ERHIAccess::CopySrc));
+	Buffers[Buffer]->EnqueueCopy(RHICmdList, Texture);
+	RHICmdList.Transition(FRHITransitionInfo(Texture, ERHIAccess::CopySrc, ERHIAccess::SRVMask));
+
+	NumInFlight.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FSpoutReadback::CopyOut(FSpoutReadbackFrame& Frame, const FCopy& Copy, const uint8* Src, uint32 SrcPitch) const
+{
+	SpoutPixelKernels::EKernel Kernel;
+	if (bConvertToRGBA8 && GetRGBA8Kernel(Copy.Format, Kernel))
+	{
+		Frame.RowPitch = Copy.Size.X * 4;
+		Frame.Format = PF_R8G8B8A8;
+		Frame.Data.SetNumUninitialized(Frame.RowPitch * Copy.Size.Y, EAllowShrinking::No);
+		SpoutPixelKernels::ConvertImage(Kernel, Frame.Data.GetData(), Frame.RowPitch, Src, SrcPitch, Copy.Size.X, Copy.Size.Y);
+		return;
+	}
+
+	Frame.RowPitch = Copy.Size.X * GPixelFormats[Copy.Format].BlockBytes;
+	Frame.Format = Copy.Format;
+	Frame.Data.SetNumUninitialized(Frame.RowPitch * Copy.Size.Y, EAllowShrinking::No);
+	for (int32 Y = 0; Y < Copy.Size.Y; ++Y)
+		FMemory::Memcpy(Frame.Data.GetData() + Y * Frame.RowPitch, Src + Y * SrcPitch, Frame.RowPitch);
+}
+
+void FSpoutReadback::Deliver(TSharedPtr<FSpoutReadbackFrame, ESPMode::ThreadSafe>&& Frame)
+{
+	FSpoutReadbackCallback CallbackCopy;
+	{
+		FScopeLock ScopeLock(&CallbackLock);
+		CallbackCopy = Callback;
+	}
+
+	if (CallbackCopy)
+	{
+		CallbackPipe.Launch(TEXT("SpoutReadbackCallback"), [CallbackCopy = MoveTemp(CallbackCopy), Frame = Frame.ToSharedRef()]()
+		{
+			CallbackCopy(Frame);
+		});
+	}
+	else if (!Queue.Enqueue(MoveTemp(Frame)))
+	{
+		// Nobody is dequeuing fast enough; the frame goes back to the pool.
+		INC_DWORD_STAT(STAT_SpoutReadbackDropped);
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_SpoutReadbackFrames);
+}
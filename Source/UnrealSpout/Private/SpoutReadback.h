@@ -0,0 +1,95 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "RHIResources.h"
+#include "Tasks/Pipe.h"
+
+#include "SpoutReadbackRing.h"
+#include "SpoutSpscQueue.h"
+#include "SpoutTypes.h"
+
+#include <atomic>
+
+class FRHICommandListImmediate;
+class FRHIGPUTextureReadback;
+class FSpoutMemoryShareWriter;
+
+/**
+ * Opt-in GPU->CPU stage for a sender or receiver. Each processed frame is copied into a
+ * ring of RHI staging textures and mapped Latency frames later, and only once the GPU
+ * reports the copy done, so the render thread never waits on it. CPU frames go to the
+ * callback, run one at a time on a worker pipe, or else to a lock-free queue for Dequeue.
+ * With bConvertToRGBA8, 8-bit BGRA, half-float and 10-bit frames are converted to RGBA8
+ * by the SIMD pixel kernels while they are copied out of the staging texture. A memory-share
+ * writer, if set, gets every frame straight from the mapped staging texture.
+ */
+class FSpoutReadback
+{
+public:
+	/** Frames the queue holds for Dequeue before new ones are dropped. */
+	static constexpr uint32 QueueCapacity = 8;
+
+	FSpoutReadback(int32 NumBuffers, int32 Latency, bool bConvertToRGBA8 = false);
+	~FSpoutReadback();
+
+	/**
+	 * Creates, replaces or drops Readback so it matches a component's settings. Returns
+	 * true if Readback changed and has to be handed to the render thread again. Game thread.
+	 */
+	static bool Sync(TSharedPtr<FSpoutReadback, ESPMode::ThreadSafe>& Readback, bool bEnable, int32 NumBuffers, int32 Latency, bool bConvertToRGBA8, const FSpoutReadbackCallback& Callback);
+
+	int32 GetNumBuffers() const { return Ring.Num(); }
+	int32 GetLatency() const { return Ring.GetLatency(); }
+	bool ConvertsToRGBA8() const { return bConvertToRGBA8; }
+
+	/** Any thread. Applies to frames delivered afterwards; null goes back to the queue. */
+	void SetCallback(FSpoutReadbackCallback InCallback);
+
+	/** Any thread. Also publishes every frame through Writer, in its texture format; null stops. */
+	void SetMemoryShare(TSharedPtr<FSpoutMemoryShareWriter, ESPMode::ThreadSafe> Writer);
+
+	/** Any thread. Off when the readback only feeds the memory share: frames skip the callback and queue. */
+	void SetDeliverFrames(bool bDeliver) { bDeliverFrames.store(bDeliver, std::memory_order_relaxed); }
+
+	/** Oldest frame not taken yet. Call from a single consumer thread. */
+	bool Dequeue(TSharedPtr<FSpoutReadbackFrame, ESPMode::ThreadSafe>& OutFrame);
+
+	/** Whether copies are waiting to be mapped, i.e. the owner should keep processing. Any thread. */
+	bool HasInFlight() const { return NumInFlight.load(std::memory_order_relaxed) > 0; }
+
+	/** Render thread. Maps every buffer that is ready, then copies Texture (if not null) into a free one. */
+	void Process_RenderThread(FRHICommandListImmediate& RHICmdList, FRHITexture* Texture);
+
+private:
+	void Deliver(TSharedPtr<FSpoutReadbackFrame, ESPMode::ThreadSafe>&& Frame);
+
+	struct FCopy
+	{
+		FIntPoint Size = FIntPoint::ZeroValue;
+		EPixelFormat Format = PF_Unknown;
+		uint64 Number = 0;
+	};
+
+	/** Copies Size rows out of the mapped staging texture into Frame, converting if asked to. */
+	void CopyOut(FSpoutReadbackFrame& Frame, const FCopy& Copy, const uint8* Src, uint32 SrcPitch) const;
+
+	FSpoutReadbackRing Ring;
+	bool bConvertToRGBA8 = false;
+	TArray<TUniquePtr<FRHIGPUTextureReadback>> Buffers;
+	TArray<FCopy> Copies;
+	FSpoutReadbackFramePool Frames;
+	TSpoutSpscQueue<TSharedPtr<FSpoutReadbackFrame, ESPMode::ThreadSafe>> Queue;
+
+	/** Also guards MemoryShare */
+	FCriticalSection CallbackLock;
+	FSpoutReadbackCallback Callback;
+	TSharedPtr<FSpoutMemoryShareWriter, ESPMode::ThreadSafe> MemoryShare;
+	std::atomic<bool> bDeliverFrames { true };
+	UE::Tasks::FPipe CallbackPipe { TEXT("SpoutReadback") };
+
+	/** Process_RenderThread calls so far; the clock Latency is measured in */
+	uint64 ProcessCount = 0;
+	uint64 CopyCount = 0;
+	std::atomic<int32> NumInFlight { 0 };
+};
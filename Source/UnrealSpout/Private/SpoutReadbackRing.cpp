@@ -0,0 +1,66 @@
+#include "SpoutReadbackRing.h"
+
+FSpoutReadbackRing::FSpoutReadbackRing(int32 InNumBuffers, int32 InLatency)
+{
+	Slots.SetNum(FMath::Clamp(InNumBuffers, MinBuffers, MaxBuffers));
+	Latency = FMath::Clamp(InLatency, 1, Slots.Num() - 1);
+}
+
+int32 FSpoutReadbackRing::BeginCopy(uint64 Frame)
+{
+	for (int32 i = 0; i < Slots.Num(); ++i)
+	{
+		if (!Slots[i].bInFlight)
+		{
+			Slots[i].bInFlight = true;
+			Slots[i].CopyFrame = Frame;
+			return i;
+		}
+	}
+
+	++NumDropped;
+	return INDEX_NONE;
+}
+
+int32 FSpoutReadbackRing::PeekReady(uint64 Frame, uint64* OutCopyFrame) const
+{
+	int32 Oldest = INDEX_NONE;
+	for (int32 i = 0; i < Slots.Num(); ++i)
+	{
+		if (Slots[i].bInFlight && (Oldest == INDEX_NONE || Slots[i].CopyFrame < Slots[Oldest].CopyFrame))
+			Oldest = i;
+	}
+
+	if (Oldest == INDEX_NONE || Frame < Slots[Oldest].CopyFrame + Latency)
+		return INDEX_NONE;
+
+	if (OutCopyFrame)
+		*OutCopyFrame = Slots[Oldest].CopyFrame;
+	return Oldest;
+}
+
+void FSpoutReadbackRing::Release(int32 Buffer)
+{
+	if (Slots.IsValidIndex(Buffer))
+		Slots[Buffer].bInFlight = false;
+}
+
+FSpoutReadbackFramePool::FSpoutReadbackFramePool(int32 InMaxFrames)
+	: MaxFrames(FMath::Max(1, InMaxFrames))
+{
+	Frames.Reserve(MaxFrames);
+}
+
+TSharedPtr<FSpoutReadbackFrame, ESPMode::ThreadSafe> FSpoutReadbackFramePool::Acquire()
+{
+	for (const TSharedRef<FSpoutReadbackFrame, ESPMode::ThreadSafe>& Frame : Frames)
+	{
+		if (Frame.GetSharedReferenceCount() == 1)
+			return Frame;
+	}
+
+	if (Frames.Num() >= MaxFrames)
+		return nullptr;
+
+	return Frames.Add_GetRef(MakeShared<FSpoutReadbackFrame, ESPMode::ThreadSafe>());
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpoutTypes.h"
+
+/**
+ * Scheduling for a ring of GPU->CPU staging buffers. A copy goes into a free buffer and
+ * is only handed out for mapping Latency frames later, oldest first, so by then the GPU
+ * has normally finished it and mapping does not stall. When every buffer is still in
+ * flight the new frame is dropped instead of waiting.
+ *
+ * Only tracks indices and frame numbers, so it runs without a GPU. Single thread.
+ */
+class FSpoutReadbackRing
+{
+public:
+	static constexpr int32 MinBuffers = 3;
+	static constexpr int32 MaxBuffers = 8;
+
+	/** Latency is clamped to [1, NumBuffers - 1] so a buffer is always free to copy into. */
+	FSpoutReadbackRing(int32 InNumBuffers, int32 InLatency);
+
+	int32 Num() const { return Slots.Num(); }
+	int32 GetLatency() const { return Latency; }
+
+	/** Claims a free buffer for a copy issued in Frame. INDEX_NONE (and a drop) if all are in flight. */
+	int32 BeginCopy(uint64 Frame);
+
+	/** Oldest in-flight buffer whose copy is at least Latency frames old at Frame, or INDEX_NONE. */
+	int32 PeekReady(uint64 Frame, uint64* OutCopyFrame = nullptr) const;
+
+	/** Returns a mapped (or abandoned) buffer to the free list. */
+	void Release(int32 Buffer);
+
+	uint64 GetNumDropped() const { return NumDropped; }
+
+private:
+	struct FSlot
+	{
+		bool bInFlight = false;
+		uint64 CopyFrame = 0;
+	};
+
+	TArray<FSlot, TInlineAllocator<MaxBuffers>> Slots;
+	int32 Latency;
+	uint64 NumDropped = 0;
+};
+
+/**
+ * Recycles CPU frames between the producer and whoever consumes them. A frame is reused
+ * once the producer holds its only reference, which needs no lock and no handshake with
+ * the consumer; when the consumer still holds every frame, Acquire fails and the frame is
+ * dropped. Producer thread only.
+ */
+class FSpoutReadbackFramePool
+{
+public:
+	explicit FSpoutReadbackFramePool(int32 InMaxFrames);
+
+	TSharedPtr<FSpoutReadbackFrame, ESPMode::ThreadSafe> Acquire();
+
+	int32 Num() const { return Frames.Num(); }
+
+private:
+	TArray<TSharedRef<FSpoutReadbackFrame, ESPMode::ThreadSafe>> Frames;
+	int32 MaxFrames;
+};
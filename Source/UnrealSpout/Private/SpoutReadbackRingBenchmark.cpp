@@ -0,0 +1,99 @@
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/OutputDevice.h"
+
+#include "SpoutReadbackRing.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace
+{
+	/** Longest fake GPU latency tried, in frames from a copy being issued to it being ready. */
+	constexpr int32 MaxGpuLatency = 4;
+
+	struct FReadbackRun
+	{
+		uint64 Delivered = 0;
+		uint64 Dropped = 0;
+		/** Buffers PeekReady handed out before the fake GPU finished them: each would have stalled a map. */
+		uint64 NotReady = 0;
+		/** Sum of frames between copy and delivery. */
+		uint64 DeliveryFrames = 0;
+		/** Deliveries out of copy order. */
+		int32 Errors = 0;
+	};
+
+	/**
+	 * One render-thread frame as FSpoutReadback runs it: map ready buffers oldest first,
+	 * stopping at the first the GPU hasn't finished, then issue this frame's copy. The fake
+	 * GPU finishes each copy GpuLatency frames after it was issued, give or take one.
+	 */
+	FReadbackRun RunReadback(int32 NumBuffers, int32 RingLatency, int32 GpuLatency, int32 Frames)
+	{
+		FSpoutReadbackRing Ring(NumBuffers, RingLatency);
+		FRandomStream Random(NumBuffers * 64 + RingLatency * 8 + GpuLatency);
+		TArray<uint64, TInlineAllocator<FSpoutReadbackRing::MaxBuffers>> ReadyAt;
+		ReadyAt.SetNumZeroed(Ring.Num());
+		uint64 LastDelivered = 0;
+		FReadbackRun Run;
+
+		for (uint64 Frame = 1; Frame <= static_cast<uint64>(Frames); ++Frame)
+		{
+			uint64 CopyFrame = 0;
+			for (int32 Buffer = Ring.PeekReady(Frame, &CopyFrame); Buffer != INDEX_NONE; Buffer = Ring.PeekReady(Frame, &CopyFrame))
+			{
+				if (Frame < ReadyAt[Buffer])
+				{
+					++Run.NotReady;
+					break;
+				}
+
+				Run.Errors += CopyFrame <= LastDelivered ? 1 : 0;
+				LastDelivered = CopyFrame;
+				Run.DeliveryFrames += Frame - CopyFrame;
+				++Run.Delivered;
+				Ring.Release(Buffer);
+			}
+
+			const int32 Buffer = Ring.BeginCopy(Frame);
+			if (Buffer == INDEX_NONE)
+			{
+				++Run.Dropped;
+				continue;
+			}
+			ReadyAt[Buffer] = Frame + FMath::Max(0, GpuLatency + Random.RandRange(-1, 1));
+		}
+		return Run;
+	}
+
+	void BenchmarkReadbackRing(const TArray<FString>& Args, FOutputDevice& Ar)
+	{
+		const int32 Frames = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100000;
+
+		for (int32 NumBuffers = FSpoutReadbackRing::MinBuffers; NumBuffers <= 5; ++NumBuffers)
+		{
+			for (int32 RingLatency = 1; RingLatency < NumBuffers; ++RingLatency)
+			{
+				for (int32 GpuLatency = 0; GpuLatency <= MaxGpuLatency; ++GpuLatency)
+				{
+					const double Start = FPlatformTime::Seconds();
+					const FReadbackRun Run = RunReadback(NumBuffers, RingLatency, GpuLatency, Frames);
+					const double Elapsed = FPlatformTime::Seconds() - Start;
+
+					Ar.Logf(TEXT("  %d buffers  ring latency %d  gpu latency %d  delivered %6.2f%%  dropped %6.2f%%  not ready %6.2f%%  %4.2f frames old  %5.1f ns/frame  errors %d"),
+						NumBuffers, RingLatency, GpuLatency, 100.0 * Run.Delivered / Frames, 100.0 * Run.Dropped / Frames, 100.0 * Run.NotReady / Frames,
+						Run.Delivered > 0 ? static_cast<double>(Run.DeliveryFrames) / Run.Delivered : 0.0, Elapsed / Frames * 1.0e9, Run.Errors);
+				}
+			}
+		}
+	}
+
+	FAutoConsoleCommandWithArgsAndOutputDevice BenchmarkReadbackRingCommand(
+		TEXT("Spout.BenchmarkReadbackRing"),
+		TEXT("Drives the readback ring against a fake GPU that finishes copies 0..4 frames after they are issued, for 3 to 5 buffers at every ring latency, and reports how many frames are delivered, dropped or would have stalled a map, and how old they are on delivery. Optional argument: frames per run (default 100000)."),
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&BenchmarkReadbackRing));
+}
+
+#endif
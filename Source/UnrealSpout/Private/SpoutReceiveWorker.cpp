@@ -0,0 +1,84 @@
+#include "SpoutReceiveWorker.h"
+
+#include "HAL/RunnableThread.h"
+
+#include "SpoutFrameSignal.h"
+#include "SpoutSenderRecord.h"
+#include "SpoutStats.h"
+
+FSpoutReceiveWorker::FSpoutReceiveWorker(TUniquePtr<FSpoutFrameSignalWaiter> InWaiter, TUniquePtr<FSpoutSenderRecordReader> InRecord, FOnFrame InOnFrame, uint32 InTimeoutMs)
+	: Waiter(MoveTemp(InWaiter))
+	, Record(MoveTemp(InRecord))
+	, OnFrame(MoveTemp(InOnFrame))
+	, TimeoutMs(InTimeoutMs)
+{
+	check(Waiter.IsValid() && Record.IsValid() && OnFrame);
+
+	Sequence = Waiter->GetSequence();
+}
+
+FSpoutReceiveWorker::~FSpoutReceiveWorker()
+{
+	// Kill calls Stop, which wakes the thread out of its wait.
+	if (Thread.IsValid())
+		Thread->Kill(true);
+	Thread.Reset();
+}
+
+TUniquePtr<FSpoutReceiveWorker> FSpoutReceiveWorker::Start(const ANSICHAR* SenderName, int64 WaiterId, FOnFrame OnFrame)
+{
+	TUniquePtr<FSpoutSenderRecordReader> Record = FSpoutSenderRecordReader::Open(SenderName);
+	if (!Record.IsValid())
+		return nullptr;
+
+	TUniquePtr<FSpoutFrameSignalWaiter> Waiter = FSpoutFrameSignalWaiter::Create(SenderName, WaiterId);
+	if (!Waiter.IsValid())
+		return nullptr;
+
+	TUniquePtr<FSpoutReceiveWorker> Worker = MakeUnique<FSpoutReceiveWorker>(MoveTemp(Waiter), MoveTemp(Record), MoveTemp(OnFrame));
+	Worker->Thread.Reset(FRunnableThread::Create(Worker.Get(), TEXT("SpoutReceiveWorker"), 0, TPri_AboveNormal));
+	if (!Worker->Thread.IsValid())
+		return nullptr;
+
+	return Worker;
+}
+
+bool FSpoutReceiveWorker::Tick()
+{
+	// A timeout still polls the record: it covers a missed wake-up and retries a refused frame.
+	Waiter->Wait(Sequence, TimeoutMs);
+	if (bStopping)
+		return false;
+
+	if (bResetConsumed.exchange(false))
+		Record->Reset();
+
+	FSpoutSenderRecord Frame;
+	if (Record->Poll(Frame) != FSpoutSenderRecordReader::EResult::NewFrame)
+	{
+		++NumIdleWakeups;
+		INC_DWORD_STAT(STAT_SpoutReceiveWorkerIdleWakeups);
+		return false;
+	}
+
+	if (!OnFrame(Frame))
+		return false;
+
+	Record->MarkConsumed(Frame.FrameNumber);
+	++NumFrames;
+	INC_DWORD_STAT(STAT_SpoutReceiveWorkerFrames);
+	return true;
+}
+
+uint32 FSpoutReceiveWorker::Run()
+{
+	while (!bStopping)
+		Tick();
+	return 0;
+}
+
+void FSpoutReceiveWorker::Stop()
+{
+	bStopping = true;
+	Waiter->Interrupt();
+}
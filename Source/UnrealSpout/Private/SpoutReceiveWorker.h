@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+
+#include <atomic>
+
+class FRunnableThread;
+class FSpoutFrameSignalWaiter;
+class FSpoutSenderRecordReader;
+struct FSpoutSenderRecord;
+
+/**
+ * Receives a plugin sender's frames as they are published rather than once per tick: a
+ * thread sleeps on the sender's frame-ready signal and offers each new frame, as described by
+ * its sender record, to a callback that stages it for the render thread.
+ *
+ * Wait, poll and callback are one Tick, which the thread runs in a loop; without a thread
+ * (Start not called) the same Tick can be driven step by step.
+ */
+class FSpoutReceiveWorker : public FRunnable
+{
+public:
+	/** Runs on the worker thread. Returns false if the frame could not be taken yet; it is offered again on the next wake-up. */
+	using FOnFrame = TFunction<bool(const FSpoutSenderRecord&)>;
+
+	/** Longest sleep (ms) without a signal; bounds a missed wake-up and a refused frame's retry. */
+	static constexpr uint32 DefaultTimeoutMs = 100;
+
+	FSpoutReceiveWorker(TUniquePtr<FSpoutFrameSignalWaiter> InWaiter, TUniquePtr<FSpoutSenderRecordReader> InRecord, FOnFrame InOnFrame, uint32 InTimeoutMs = DefaultTimeoutMs);
+
+	/** Stops and joins the thread. */
+	virtual ~FSpoutReceiveWorker() override;
+
+	/** Opens SenderName's record and frame signal and starts the thread. Null if the sender publishes no record. */
+	static TUniquePtr<FSpoutReceiveWorker> Start(const ANSICHAR* SenderName, int64 WaiterId, FOnFrame OnFrame);
+
+	/** Waits up to the timeout for a frame and offers the newest one. Returns true if the callback took it. */
+	bool Tick();
+
+	/** Offers the last frame taken again, e.g. after the render thread dropped its copy. Any thread. */
+	void ResetConsumed() { bResetConsumed = true; }
+
+	/** Frames the callback took, and wake-ups that found nothing new, since creation. Any thread. */
+	uint64 GetNumFrames() const { return NumFrames; }
+	uint64 GetNumIdleWakeups() const { return NumIdleWakeups; }
+
+	//~ FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	TUniquePtr<FSpoutFrameSignalWaiter> Waiter;
+	TUniquePtr<FSpoutSenderRecordReader> Record;
+	FOnFrame OnFrame;
+	const uint32 TimeoutMs;
+
+	/** Signal sequence as of the last wake-up. Worker thread only. */
+	uint32 Sequence = 0;
+
+	std::atomic<bool> bStopping { false };
+	std::atomic<bool> bResetConsumed { false };
+	std::atomic<uint64> NumFrames { 0 };
+	std::atomic<uint64> NumIdleWakeups { 0 };
+
+	TUniquePtr<FRunnableThread> Thread;
+};
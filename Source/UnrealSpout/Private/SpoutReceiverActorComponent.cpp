@@ -10,137 +10,204 @@
 #include "Windows/HideWindowsPlatformTypes.h"
 
 #include "GlobalShader.h"
-#include "UniformBuffer.h"
+#include "Misc/ScopeLock.h"
 #include "RHICommandList.h"
 #include "RHIUtilities.h"
-#include "MediaShaders.h"
 
 #include "RHI.h"
-#include "RHIResources.h"          // RHICreateShaderResourceView
+#include "RHIResources.h"
 #include "RHIStaticStates.h"
-#include "ShaderParameterUtils.h"  // SetShaderResourceViewParameter
-#include "RenderCore.h"         // FRHIBatchedShaderParameters helpers
+#include "PixelShaderUtils.h"      // Fullscreen triangle helpers
+#include "RenderCore.h"
+#include "ShaderParameterStruct.h" // SetShaderParameters
+
+#include "SpoutBatch.h"
+#include "SpoutConsumerTable.h"
+#include "SpoutFormats.h"
+#include "SpoutFramePoller.h"
+#include "SpoutInteropDevice.h"
+#include "SpoutFrameSync.h"
+#include "SpoutLruCache.h"
+#include "SpoutMemoryShare.h"
+#include "SpoutPixelKernels.h"
+#include "SpoutReadback.h"
+#include "SpoutReceiveWorker.h"
+#include "SpoutReceiverState.h"
+#include "SpoutRHI.h"
+#include "SpoutSenderDirectory.h"
+#include "SpoutSenderInfoLayout.h"
+#include "SpoutSenderName.h"
+#include "SpoutSenderRecord.h"
+#include "SpoutSharedInfo.h"
+#include "SpoutShaders.h"
+#include "SpoutSharedMemoryRegion.h"
+#include "SpoutStats.h"
+#include "SpoutSubsystem.h"
+#include "SpoutTextureRing.h"
+#include "UnrealSpout.h"
+
+#include <atomic>
 
 
 static spoutSenderNames senders;
+static_assert(SpoutSenderName::MaxLength == SpoutMaxSenderNameLen, "Sender name buffers must fit what FindSender writes");
 /** Helper to open shared handles without duplicating code */
 static spoutDirectX spoutdx;
 
-class FTextureCopyVertexShader : public FGlobalShader
-{
-	DECLARE_SHADER_TYPE(FTextureCopyVertexShader, Global);
-public:
-
-	static bool ShouldCache(EShaderPlatform Platform) { return true; }
-
-	FTextureCopyVertexShader(const ShaderMetaType::CompiledShaderInitializerType& Initializer) :
-		FGlobalShader(Initializer)
-	{}
-	FTextureCopyVertexShader() {}
+DECLARE_GPU_STAT_NAMED(SpoutReceiveCopy, TEXT("Spout Receive Copy"));
+DECLARE_GPU_STAT_NAMED(SpoutReceiveDraw, TEXT("Spout Receive Draw"));
 
-	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
-	{
-		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
-	}
-};
-
-class FTextureCopyPixelShader : public FGlobalShader
+/** Kernel turning memory-share pixels of SrcFormat into DstFormat, for formats that differ. */
+static bool FindMemoryShareKernel(EPixelFormat SrcFormat, EPixelFormat DstFormat, SpoutPixelKernels::EKernel& OutKernel)
 {
-	DECLARE_SHADER_TYPE(FTextureCopyPixelShader, Global);
-public:
+	using SpoutPixelKernels::EKernel;
 
-#if (ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION >= 25) || (ENGINE_MAJOR_VERSION == 5)
-	LAYOUT_FIELD(FShaderResourceParameter, SrcTexture);
-#else ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION <= 24
-	FShaderResourceParameter SrcTexture;
-
-	virtual bool Serialize(FArchive& Ar) override
+	if (DstFormat == PF_R8G8B8A8)
 	{
-		bool bShaderHasOutdatedParams = FGlobalShader::Serialize(Ar);
-		Ar << SrcTexture;
-		return bShaderHasOutdatedParams;
+		switch (SrcFormat)
+		{
+		case PF_B8G8R8A8:		OutKernel = EKernel::SwizzleRB; return true;
+		case PF_FloatRGBA:		OutKernel = EKernel::HalfToUnorm8; return true;
+		case PF_A2B10G10R10:	OutKernel = EKernel::UnpackRGB10A2; return true;
+		default:				return false;
+		}
 	}
-#endif
-
-	static bool ShouldCache(EShaderPlatform Platform) { return true; }
 
-	FTextureCopyPixelShader(const ShaderMetaType::CompiledShaderInitializerType& Initializer) :
-		FGlobalShader(Initializer)
+	if (SrcFormat == PF_R8G8B8A8)
 	{
-		SrcTexture.Bind(Initializer.ParameterMap, TEXT("SrcTexture"));
+		switch (DstFormat)
+		{
+		case PF_B8G8R8A8:		OutKernel = EKernel::SwizzleRB; return true;
+		case PF_FloatRGBA:		OutKernel = EKernel::Unorm8ToHalf; return true;
+		case PF_A2B10G10R10:	OutKernel = EKernel::PackRGB10A2; return true;
+		default:				return false;
+		}
 	}
-	FTextureCopyPixelShader() {}
 
-	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	if (SrcFormat == PF_B8G8R8A8 && DstFormat == PF_B8G8R8A8)
 	{
-		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+		OutKernel = EKernel::Copy32;
+		return true;
 	}
-};
+	return false;
+}
 
-struct FTextureVertex
-{
-	FVector4 Position;
-	FVector2D UV;
-};
+//////////////////////////////////////////////////////////////////////////
 
-IMPLEMENT_SHADER_TYPE(, FTextureCopyPixelShader, TEXT("/Plugin/UnrealSpout/SpoutReceiverCopyShader.usf"), TEXT("MainPixelShader"), SF_Pixel)
+/** Identifies a shared texture opened on a device; a sender that rebuilds its textures yields new keys. */
+struct FSpoutSharedTextureKey
+{
+	void* Device = nullptr;
+	uint32 ShareHandle = 0;
+	uint32 Width = 0;
+	uint32 Height = 0;
+	uint32 Format = 0;
 
-//////////////////////////////////////////////////////////////////////////
+	bool operator==(const FSpoutSharedTextureKey& Other) const
+	{
+		return Device == Other.Device
+			&& ShareHandle == Other.ShareHandle
+			&& Width == Other.Width
+			&& Height == Other.Height
+			&& Format == Other.Format;
+	}
+};
 
-struct USpoutReceiverActorComponent::SpoutReceiverContext
+struct USpoutReceiverActorComponent::SpoutReceiverContext : public ISpoutStream
 {
 	unsigned int width = 0, height = 0;
 	DXGI_FORMAT dwFormat = DXGI_FORMAT_UNKNOWN;
 	EPixelFormat format = PF_Unknown;
 	FRHITexture* Texture;
 
+	ESpoutRHIBackend Backend = ESpoutRHIBackend::Unsupported;
+
+	/** D3D12 only: the shared 11on12 device; D3D11Device, Context and D3D11on12Device are borrowed from it. */
+	TSharedPtr<FSpoutInteropDevice, ESPMode::ThreadSafe> InteropDevice;
+
 	ID3D11Device* D3D11Device = nullptr;
 	ID3D11DeviceContext* Context = nullptr;
 
-	ID3D12Device* D3D12Device = nullptr;
 	ID3D11On12Device* D3D11on12Device = nullptr;
 	ID3D11Resource* WrappedDX11Resource = nullptr;
 
-	SpoutReceiverContext(unsigned int width, unsigned int height, DXGI_FORMAT dwFormat, FRHITexture* Texture)
+	TUniquePtr<ISpoutFrameSync> FrameSync;
+	uint64 FrameCounter = 0;
+
+	/** Shared texture opened on the game thread, consumed by the next batch. */
+	std::atomic<ID3D11Texture2D*> StagedTexture { nullptr };
+	bool bCopiedThisBatch = false;
+
+	/** Set when a staged frame could not be copied, so the game thread does not treat it as consumed. */
+	std::atomic<bool> bCopyDropped { false };
+
+	/** Render target the received frame ends up in. Render thread only; set through SetOutput. */
+	FTextureRHIRef OutputTexture;
+
+	/** Conversion applied on the way into OutputTexture. Render thread only; set through SetOutput. */
+	FSpoutConversionSettings Conversion;
+
+	/** CPU readback of OutputTexture after each received frame. Render thread only; set through SetReadback. */
+	TSharedPtr<FSpoutReadback, ESPMode::ThreadSafe> Readback;
+
+	/** Cached SRV for the intermediate texture, created on the first draw */
+	FShaderResourceViewRHIRef IntermediateSRV;
+
+	/** Pipeline state for the resampling draw, keyed by output format */
+	FGraphicsPipelineStateInitializer CachedPSOInit;
+	EPixelFormat CachedPSOFormat = PF_Unknown;
+	bool bPSOInitialized = false;
+
+	/**
+	 * Shared textures opened through OpenSharedResource, kept until the sender changes
+	 * them. Sized for every slot of a sender's ring plus one. Used by the game thread and
+	 * the receive worker, under OpenedTexturesLock.
+	 */
+	FCriticalSection OpenedTexturesLock;
+	TSpoutLruCache<FSpoutSharedTextureKey, ID3D11Texture2D*> OpenedTextures {
+		FSpoutTextureRing::MaxSlots + 1,
+		[](const FSpoutSharedTextureKey&, ID3D11Texture2D*& SharedTex)
+		{
+			SharedTex->Release();
+			INC_DWORD_STAT(STAT_SpoutTextureCacheEvictions);
+		}
+	};
+
+	SpoutReceiverContext(unsigned int width, unsigned int height, DXGI_FORMAT dwFormat, FRHITexture* Texture, ESpoutSyncMode SyncMode)
 		: width(width)
 		, height(height)
 		, dwFormat(dwFormat)
 		, Texture(Texture)
 	{
-		if (dwFormat == DXGI_FORMAT_B8G8R8A8_UNORM)
-			format = PF_B8G8R8A8;
-		else if (dwFormat == DXGI_FORMAT_R16G16B16A16_FLOAT)
-			format = PF_FloatRGBA;
-		else if (dwFormat == DXGI_FORMAT_R32G32B32A32_FLOAT)
-			format = PF_A32B32G32R32F;
+		format = SpoutFormats::FromDXGI(dwFormat);
 
-		FString RHIName = GDynamicRHI->GetName();
+		Backend = SpoutRHI::GetBackend();
 
-		if (RHIName == TEXT("D3D11"))
+		if (Backend == ESpoutRHIBackend::D3D11)
 		{
 			D3D11Device = (ID3D11Device*)GDynamicRHI->RHIGetNativeDevice();
 			D3D11Device->GetImmediateContext(&Context);
 		}
-		else if (RHIName == TEXT("D3D12"))
+		else if (Backend == ESpoutRHIBackend::D3D12)
 		{
-			D3D12Device = static_cast<ID3D12Device*>(GDynamicRHI->RHIGetNativeDevice());
-			UINT DeviceFlags11 = D3D11_CREATE_DEVICE_BGRA_SUPPORT;
-
-			verify(D3D11On12CreateDevice(
-				D3D12Device,
-				DeviceFlags11,
-				nullptr,
-				0,
-				nullptr,
-				0,
-				0,
-				&D3D11Device,
-				&Context,
-				nullptr
-			) == S_OK);
-
-			verify(D3D11Device->QueryInterface(__uuidof(ID3D11On12Device), (void**)&D3D11on12Device) == S_OK);
-			
+			InteropDevice = FSpoutInteropDevice::Acquire();
+			if (!InteropDevice.IsValid())
+			{
+				// Left inert: IsUsable() is false and the component never queues or reads through it.
+				static bool bLogged = false;
+				if (!bLogged)
+				{
+					UE_LOG(LogUnrealSpout, Error, TEXT("Spout receiver: could not create the D3D11On12 device; receiving is disabled."));
+					bLogged = true;
+				}
+				return;
+			}
+
+			D3D11Device = InteropDevice->GetDevice();
+			Context = InteropDevice->GetContext();
+			D3D11on12Device = InteropDevice->GetOn12Device();
+
+
 			ID3D12Resource* NativeTex = (ID3D12Resource*)Texture->GetNativeResource();
 
 			D3D11_RESOURCE_FLAGS rf11 = {};
@@ -152,63 +219,261 @@ struct USpoutReceiverActorComponent::SpoutReceiverContext
 				(void**)&WrappedDX11Resource) == S_OK);
 		}
 		else throw;
+
+		FrameSync = SpoutFrameSync::Create(SyncMode, D3D11Device, Context);
 	}
 
-	~SpoutReceiverContext()
+	/** False when the constructor could not get a device; such a context does nothing. */
+	bool IsUsable() const { return D3D11Device != nullptr && Context != nullptr; }
+
+	virtual ~SpoutReceiverContext() override
 	{
+		Stage(nullptr);
+		OpenedTextures.Empty();
+		FrameSync.Reset();
+
 		if (WrappedDX11Resource)
 		{
-			D3D11on12Device->ReleaseWrappedResources(&WrappedDX11Resource, 1);
+			WrappedDX11Resource->Release();
 			WrappedDX11Resource = nullptr;
 		}
 
-		if (D3D11on12Device)
+		// Only the D3D11 path owns a reference (from GetImmediateContext); the rest is
+		// the RHI's device or borrowed from InteropDevice.
+		if (Backend == ESpoutRHIBackend::D3D11 && Context)
+			Context->Release();
+
+		Context = nullptr;
+		D3D11on12Device = nullptr;
+		D3D11Device = nullptr;
+		InteropDevice.Reset();
+	}
+
+	/**
+	 * Returns the sender's texture opened on our device, with a reference for the caller,
+	 * reusing an earlier open when the handle is unchanged. Any thread.
+	 */
+	ID3D11Texture2D* AcquireSharedTexture(HANDLE hSharehandle, unsigned int SenderWidth, unsigned int SenderHeight, DXGI_FORMAT SenderFormat)
+	{
+		FScopeLock ScopeLock(&OpenedTexturesLock);
+
+		const FSpoutSharedTextureKey Key { D3D11Device, SpoutSharedInfo::HandleToUint32(hSharehandle), SenderWidth, SenderHeight, static_cast<uint32>(SenderFormat) };
+
+		// A new size or format means the sender rebuilt its textures; the old handles are dead.
+		OpenedTextures.RemoveIf([&Key](const FSpoutSharedTextureKey& Cached, ID3D11Texture2D*)
+		{
+			return Cached.Width != Key.Width || Cached.Height != Key.Height || Cached.Format != Key.Format;
+		});
+
+		ID3D11Texture2D* SharedTex = nullptr;
+		if (ID3D11Texture2D** Cached = OpenedTextures.Find(Key))
 		{
-			D3D11on12Device->Release();
-			D3D11on12Device = nullptr;
+			INC_DWORD_STAT(STAT_SpoutTextureCacheHits);
+			SharedTex = *Cached;
 		}
+		else
+		{
+			INC_DWORD_STAT(STAT_SpoutTextureCacheMisses);
+
+			if (!spoutdx.OpenDX11shareHandle(D3D11Device, &SharedTex, hSharehandle) || !SharedTex)
+				return nullptr;
+
+			OpenedTextures.Add(Key, SharedTex);
+		}
+
+		// The cache keeps its own reference; it may evict this entry as soon as we unlock.
+		SharedTex->AddRef();
+		return SharedTex;
+	}
+
+	/** Points the receive pipeline at a new output render target and conversion. Game thread; takes effect on the render thread. */
+	static void SetOutput(const TSharedRef<SpoutReceiverContext, ESPMode::ThreadSafe>& Context, FTextureRHIRef NewOutput, const FSpoutConversionSettings& NewConversion)
+	{
+		ENQUEUE_RENDER_COMMAND(SpoutReceiverSetOutput)(
+			[Context, NewOutput, NewConversion](FRHICommandListImmediate&) {
+			Context->OutputTexture = NewOutput;
+			Context->Conversion = NewConversion;
+		});
+	}
+
+	/** Hands the readback stage (or null) to the render thread. Game thread. */
+	static void SetReadback(const TSharedRef<SpoutReceiverContext, ESPMode::ThreadSafe>& Context, TSharedPtr<FSpoutReadback, ESPMode::ThreadSafe> NewReadback)
+	{
+		ENQUEUE_RENDER_COMMAND(SpoutReceiverSetReadback)(
+			[Context, NewReadback = MoveTemp(NewReadback)](FRHICommandListImmediate&) mutable {
+			Context->Readback = MoveTemp(NewReadback);
+		});
+	}
+
+	/** Drops every cached open, e.g. when the sender went away. */
+	void ReleaseSharedTextures()
+	{
+		FScopeLock ScopeLock(&OpenedTexturesLock);
+		OpenedTextures.Empty();
+	}
+
+	/** Hands a shared texture (with a reference for the render thread) over, dropping one that was never consumed. */
+	void Stage(ID3D11Texture2D* SharedTex)
+	{
+		if (ID3D11Texture2D* Previous = StagedTexture.exchange(SharedTex))
+			Previous->Release();
+	}
+
+	virtual void Process_RenderThread(FSpoutFrameBatch& Batch) override
+	{
+		bCopiedThisBatch = false;
+
+		ID3D11Texture2D* SharedTex = StagedTexture.exchange(nullptr);
+		if (!SharedTex)
+			return;
+
+		bCopiedThisBatch = CopyResource(SharedTex, Batch);
+		SharedTex->Release();
+
+		if (!bCopiedThisBatch)
+			bCopyDropped = true;
+	}
+
+	virtual void PostSubmit_RenderThread(FSpoutFrameBatch& Batch) override
+	{
+		FRHICommandListImmediate* RHICmdList = Batch.GetRHICmdList();
+		if (!RHICmdList) return;
 
-		if (D3D11Device)
+		const bool bWroteOutput = WriteOutput(*RHICmdList);
+
+		// Runs on batches without a new frame too, so earlier copies still get mapped.
+		if (Readback.IsValid())
+			Readback->Process_RenderThread(*RHICmdList, bWroteOutput ? OutputTexture.GetReference() : nullptr);
+	}
+
+	/** Moves this batch's frame from the intermediate texture into OutputTexture. False if there was none. */
+	bool WriteOutput(FRHICommandListImmediate& RHICmdList)
+	{
+		if (!bCopiedThisBatch || !GWorld || !Texture || !OutputTexture.IsValid()) return false;
+
+		const FRHITextureDesc& SrcDesc = Texture->GetDesc();
+		const FRHITextureDesc& DstDesc = OutputTexture->GetDesc();
+
+		if (SrcDesc.Format == DstDesc.Format && SrcDesc.Extent == DstDesc.Extent && Conversion.IsColorIdentity())
+		{
+			CopyToOutput(RHICmdList);
+		}
+		else
 		{
-			D3D11Device->Release();
-			D3D11Device = nullptr;
+			DrawToOutput(RHICmdList);
 		}
+		return true;
+	}
+
+	/** Same size and format: a plain GPU copy into the output render target. */
+	void CopyToOutput(FRHICommandListImmediate& RHICmdList)
+	{
+		SCOPED_DRAW_EVENT(RHICmdList, SpoutReceiveCopy);
+		SCOPED_GPU_STAT(RHICmdList, SpoutReceiveCopy);
 
-		if (D3D12Device)
+		RHICmdList.Transition({
+			FRHITransitionInfo(Texture, ERHIAccess::Unknown, ERHIAccess::CopySrc),
+			FRHITransitionInfo(OutputTexture, ERHIAccess::Unknown, ERHIAccess::CopyDest)
+		});
+
+		FRHICopyTextureInfo CopyInfo{};
+		RHICmdList.CopyTexture(Texture, OutputTexture, CopyInfo);
+
+		RHICmdList.Transition({
+			FRHITransitionInfo(Texture, ERHIAccess::CopySrc, ERHIAccess::SRVMask),
+			FRHITransitionInfo(OutputTexture, ERHIAccess::CopyDest, ERHIAccess::SRVMask)
+		});
+	}
+
+	/** Size, format or colour differ: one fullscreen draw that converts into the output render target. */
+	void DrawToOutput(FRHICommandListImmediate& RHICmdList)
+	{
+		SCOPED_DRAW_EVENT(RHICmdList, SpoutReceiveDraw);
+		SCOPED_GPU_STAT(RHICmdList, SpoutReceiveDraw);
+
+		FGlobalShaderMap* GlobalShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+		TShaderMapRef<FSpoutConvertPS> PixelShader(GlobalShaderMap);
+
+		if (!IntermediateSRV.IsValid())
 		{
-			D3D12Device->Release();
-			D3D12Device = nullptr;
+			IntermediateSRV = RHICmdList.CreateShaderResourceView(Texture, FRHIViewDesc::CreateTextureSRV().SetDimensionFromTexture(Texture));
 		}
 
-		if (Context)
+		RHICmdList.Transition({
+			FRHITransitionInfo(Texture, ERHIAccess::Unknown, ERHIAccess::SRVGraphics),
+			FRHITransitionInfo(OutputTexture, ERHIAccess::Unknown, ERHIAccess::RTV)
+		});
+
+		const FIntPoint OutputSize = OutputTexture->GetDesc().Extent;
+
+		FRHIRenderPassInfo RPInfo(OutputTexture, ERenderTargetActions::DontLoad_Store);
+		RHICmdList.BeginRenderPass(RPInfo, TEXT("SpoutReceiver"));
+		RHICmdList.SetViewport(0.0f, 0.0f, 0.0f, OutputSize.X, OutputSize.Y, 1.0f);
+
+		// The pipeline only depends on the output format, so it is built once per format.
+		if (!bPSOInitialized || CachedPSOFormat != OutputTexture->GetDesc().Format)
 		{
-			Context->Release();
-			Context = nullptr;
+			FPixelShaderUtils::InitFullscreenPipelineState(RHICmdList, GlobalShaderMap, PixelShader, CachedPSOInit);
+			CachedPSOFormat = OutputTexture->GetDesc().Format;
+			bPSOInitialized = true;
 		}
+		RHICmdList.ApplyCachedRenderTargets(CachedPSOInit);
+		SetGraphicsPipelineState(RHICmdList, CachedPSOInit, 0);
 
+		FSpoutConvertPS::FParameters Parameters;
+		Parameters.SrcTexture = IntermediateSRV;
+		SetSpoutConversionParameters(Parameters.Conversion, Conversion, Texture->GetDesc().Extent, OutputSize);
+		SetShaderParameters(RHICmdList, PixelShader, PixelShader.GetPixelShader(), Parameters);
+
+		FPixelShaderUtils::DrawFullscreenTriangle(RHICmdList);
+		RHICmdList.EndRenderPass();
+
+		RHICmdList.Transition(FRHITransitionInfo(OutputTexture, ERHIAccess::RTV, ERHIAccess::SRVMask));
 	}
 
-	void CopyResource(ID3D11Resource* SrcTexture)
+	bool CopyResource(ID3D11Resource* SrcTexture, FSpoutFrameBatch& Batch)
 	{
 		check(IsInRenderingThread());
-		if (!GWorld || !SrcTexture) return;
+		if (!GWorld || !SrcTexture) return false;
 
-		FString RHIName = GDynamicRHI->GetName();
+		// Drop the frame rather than queue another copy behind one the GPU has not finished.
+		if (FrameSync->GetCompletedFrame() < FrameCounter)
+			return false;
 
-		if (RHIName == TEXT("D3D11"))
+		if (Backend == ESpoutRHIBackend::D3D11)
 		{
 			ID3D11Texture2D* NativeTex = (ID3D11Texture2D*)Texture->GetNativeResource();
 
+			// Same immediate context the RHI records on, so later reads are ordered after the copy.
 			Context->CopyResource(NativeTex, SrcTexture);
-			Context->Flush();
+			FrameSync->Signal(++FrameCounter);
 		}
-		else if (RHIName == TEXT("D3D12"))
+		else if (Backend == ESpoutRHIBackend::D3D12)
 		{
-			D3D11on12Device->AcquireWrappedResources(&WrappedDX11Resource, 1);
-			Context->CopyResource(WrappedDX11Resource, SrcTexture);
-			D3D11on12Device->ReleaseWrappedResources(&WrappedDX11Resource, 1);
-			Context->Flush();
+			// Batched with every other stream's wrapped copies at the submit.
+			InteropDevice->QueueCopy(WrappedDX11Resource, SrcTexture, WrappedDX11Resource, FrameSync.Get(), ++FrameCounter);
+			Batch.RequestSubmit(InteropDevice.Get());
 		}
+		return true;
+	}
+};
+
+/** The context the receive worker stages into; swapped by the game thread when it reallocates. */
+struct USpoutReceiverActorComponent::FReceiveTarget
+{
+	FCriticalSection Lock;
+	TSharedPtr<SpoutReceiverContext> Context;
+
+	void Set(const TSharedPtr<SpoutReceiverContext>& NewContext)
+	{
+		FScopeLock ScopeLock(&Lock);
+		Context = NewContext;
+	}
+
+	TSharedPtr<SpoutReceiverContext> Get()
+	{
+		FScopeLock ScopeLock(&Lock);
+		return Context;
 	}
 };
 
@@ -228,9 +493,254 @@ void USpoutReceiverActorComponent::BeginPlay()
 
 void USpoutReceiverActorComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	StopReceiveWorker();
+	UnregisterConsumer();
+	ReleaseIntermediate();
+	MemoryShare.Reset();
 	Super::EndPlay(EndPlayReason);
 }
 
+int32 USpoutReceiverActorComponent::GetReallocationCount() const
+{
+	return ReceiverState.IsValid() ? static_cast<int32>(ReceiverState->GetNumReallocations()) : 0;
+}
+
+void USpoutReceiverActorComponent::SetReadbackCallback(FSpoutReadbackCallback Callback)
+{
+	ReadbackCallback = MoveTemp(Callback);
+	if (Readback.IsValid())
+		Readback->SetCallback(ReadbackCallback);
+}
+
+bool USpoutReceiverActorComponent::DequeueReadback(TSharedPtr<FSpoutReadbackFrame, ESPMode::ThreadSafe>& OutFrame)
+{
+	return Readback.IsValid() && Readback->Dequeue(OutFrame);
+}
+
+void USpoutReceiverActorComponent::ReallocateIntermediate(uint32 Width, uint32 Height, EPixelFormat Format)
+{
+	ReleaseIntermediate();
+
+	if (USpoutSubsystem* Subsystem = USpoutSubsystem::Get())
+		IntermediateTextureResource = Subsystem->AcquireRenderTarget(FIntPoint(Width, Height), Format);
+}
+
+void USpoutReceiverActorComponent::ReleaseIntermediate()
+{
+	// The batch holds its own reference to the old context until it has run, and the
+	// pool keeps the old texture alive for it. So does a frame the worker is staging now.
+	context.Reset();
+	BoundOutputRHI = nullptr;
+
+	if (ReceiveTarget.IsValid())
+		ReceiveTarget->Set(nullptr);
+
+	if (IntermediateTextureResource)
+	{
+		if (USpoutSubsystem* Subsystem = USpoutSubsystem::Get())
+			Subsystem->ReleaseRenderTarget(IntermediateTextureResource);
+
+		IntermediateTextureResource = nullptr;
+	}
+}
+
+void USpoutReceiverActorComponent::UpdateReceiveWorker(bool bCopyDropped)
+{
+	if (!ReceiveWorker.IsValid())
+	{
+		TSharedPtr<FReceiveTarget, ESPMode::ThreadSafe> Target = MakeShared<FReceiveTarget, ESPMode::ThreadSafe>();
+
+		// Worker thread: open and stage the frame. It replaces one staged earlier and not yet
+		// copied, so the next Spout batch copies only the newest frame, with every other stream.
+		auto OnFrame = [Target](const FSpoutSenderRecord& Record) -> bool
+		{
+			TSharedPtr<SpoutReceiverContext> Context = Target->Get();
+
+			// A new size or format needs a new intermediate texture first; the tick sees it too.
+			if (!Context.IsValid() || Context->width != Record.Width || Context->height != Record.Height || Context->dwFormat != static_cast<DXGI_FORMAT>(Record.Format))
+				return false;
+
+			ID3D11Texture2D* SharedTex = Context->AcquireSharedTexture(SpoutSharedInfo::Uint32ToHandle(Record.ShareHandle), Record.Width, Record.Height, static_cast<DXGI_FORMAT>(Record.Format));
+			if (!SharedTex)
+				return false;
+
+			Context->Stage(SharedTex);
+			return true;
+		};
+
+		if (ConsumerId == 0)
+			ConsumerId = FSpoutConsumerTable::MakeConsumerId();
+
+		TUniquePtr<FSpoutReceiveWorker> Worker = FSpoutReceiveWorker::Start(SubscribeNameAnsi.GetData(), ConsumerId, MoveTemp(OnFrame));
+		if (!Worker.IsValid())
+			return;
+
+		ReceiveWorker = MakeShareable(Worker.Release());
+		ReceiveTarget = MoveTemp(Target);
+	}
+
+	if (bCopyDropped)
+		ReceiveWorker->ResetConsumed();
+
+	ReceiveTarget->Set(context);
+}
+
+void USpoutReceiverActorComponent::StopReceiveWorker()
+{
+	// Joins the thread; a batch it already queued keeps its own reference to the context.
+	ReceiveWorker.Reset();
+	ReceiveTarget.Reset();
+}
+
+void USpoutReceiverActorComponent::UpdateConsumerRegistration(const ANSICHAR* SenderName)
+{
+	if (!SenderName || !SenderName[0])
+		return;
+
+	if (!ConsumerTable.IsValid() || FCStringAnsi::Strcmp(ConsumerTableSender.GetData(), SenderName) != 0)
+	{
+		UnregisterConsumer();
+
+		TUniquePtr<FSpoutConsumerTable> Table = FSpoutConsumerTable::OpenOrCreate(SenderName);
+		if (!Table.IsValid())
+			return;
+
+		ConsumerTable = MakeShareable(Table.Release());
+		ConsumerTableSender = TArray<ANSICHAR>(SenderName, FCStringAnsi::Strlen(SenderName) + 1);
+		if (ConsumerId == 0)
+			ConsumerId = FSpoutConsumerTable::MakeConsumerId();
+	}
+
+	// One atomic store per tick; only a reclaimed or missing slot costs a scan.
+	const int64 Now = FSpoutConsumerTable::NowMs();
+	if (!ConsumerTable->Heartbeat(ConsumerSlot, ConsumerId, Now))
+		ConsumerSlot = ConsumerTable->Register(ConsumerId, Now);
+}
+
+void USpoutReceiverActorComponent::UnregisterConsumer()
+{
+	if (ConsumerTable.IsValid())
+		ConsumerTable->Unregister(ConsumerSlot, ConsumerId);
+
+	ConsumerTable.Reset();
+	ConsumerTableSender.Reset();
+	ConsumerSlot = INDEX_NONE;
+}
+
+/**
+ * A memory-share reader and what its frames go through on the render thread. The frame is
+ * acquired right before it is copied out, so a fast sender has as little time as possible
+ * to start overwriting it.
+ */
+struct USpoutReceiverActorComponent::FMemoryShareState
+{
+	TUniquePtr<FSpoutMemoryShareReader> Reader;
+
+	/** Private copy of the frame, converted if need be, uploaded only if intact. */
+	TArray<uint8> Scratch;
+
+	/** Width << 32 | Height of a frame the output did not fit; 0 when none. Resized on the game thread. */
+	std::atomic<uint64> WantedExtent { 0 };
+
+	/** Set once the sender ended the stream; the game thread then opens the name again. */
+	std::atomic<bool> bEnded { false };
+
+	/** When Reader was opened. Game thread only. */
+	double OpenedAt = 0.0;
+
+	/** Least time between opens while the sender is gone. */
+	static constexpr double ReopenIntervalSeconds = 0.5;
+};
+
+void USpoutReceiverActorComponent::TickMemoryShare()
+{
+	if (SubscribeName.IsNone())
+		return;
+
+	// A sender that stopped may have taken its control block with it; a new one makes a fresh one.
+	const double Now = FPlatformTime::Seconds();
+	const bool bReopen = MemoryShare.IsValid() && MemoryShare->bEnded && Now - MemoryShare->OpenedAt >= FMemoryShareState::ReopenIntervalSeconds;
+
+	if (!MemoryShare.IsValid() || MemoryShareSender != SubscribeName || bReopen)
+	{
+		MemoryShare.Reset();
+
+		TUniquePtr<FSpoutMemoryShareReader> Reader = FSpoutMemoryShareReader::Open(SubscribeNameAnsi.GetData());
+		if (!Reader.IsValid())
+			return;
+
+		MemoryShare = MakeShared<FMemoryShareState, ESPMode::ThreadSafe>();
+		MemoryShare->Reader = MoveTemp(Reader);
+		MemoryShare->OpenedAt = Now;
+		MemoryShareSender = SubscribeName;
+	}
+
+	if (const uint64 Wanted = MemoryShare->WantedExtent.exchange(0))
+	{
+		const int32 Width = static_cast<int32>(Wanted >> 32);
+		const int32 Height = static_cast<int32>(Wanted & MAX_uint32);
+		if (OutputRenderTarget->SizeX != Width || OutputRenderTarget->SizeY != Height)
+			OutputRenderTarget->ResizeTarget(Width, Height);
+	}
+
+	FTextureResource* Resource = OutputRenderTarget->GetResource();
+	if (!Resource)
+		return;
+
+	ENQUEUE_RENDER_COMMAND(SpoutReceiveMemoryShare)(
+		[State = MemoryShare, Resource](FRHICommandListImmediate& RHICmdList) {
+		FRHITexture* Texture = Resource->TextureRHI.GetReference();
+		if (!Texture)
+			return;
+
+		FSpoutMemoryShareFrame Frame;
+		const FSpoutMemoryShareReader::EResult Result = State->Reader->AcquireFrame(Frame);
+		if (Result == FSpoutMemoryShareReader::EResult::Ended)
+			State->bEnded = true;
+		if (Result != FSpoutMemoryShareReader::EResult::NewFrame)
+			return;
+
+		// Only the game thread can resize the output; the frame is reported again once it has.
+		if (Texture->GetDesc().Extent != FIntPoint(static_cast<int32>(Frame.Width), static_cast<int32>(Frame.Height)))
+		{
+			State->WantedExtent = static_cast<uint64>(Frame.Width) << 32 | Frame.Height;
+			State->Reader->Reset();
+			return;
+		}
+
+		const EPixelFormat SrcFormat = SpoutFormats::FromDXGI(Frame.DXGIFormat);
+		const EPixelFormat DstFormat = Texture->GetFormat();
+
+		SpoutPixelKernels::EKernel Kernel = SpoutPixelKernels::EKernel::Copy32;
+		const bool bConvert = SrcFormat != DstFormat;
+		if (SrcFormat == PF_Unknown || (bConvert && !FindMemoryShareKernel(SrcFormat, DstFormat, Kernel)))
+			return;
+
+		const int32 RowBytes = Frame.Width * (bConvert ? SpoutPixelKernels::GetDstBytesPerPixel(Kernel) : GPixelFormats[SrcFormat].BlockBytes);
+
+		// The sender may reuse the buffer meanwhile, so the pixels go to scratch first and
+		// only an intact copy is uploaded.
+		TArray<uint8>& Scratch = State->Scratch;
+		Scratch.SetNumUninitialized(RowBytes * Frame.Height, EAllowShrinking::No);
+		if (bConvert)
+		{
+			SpoutPixelKernels::ConvertImage(Kernel, Scratch.GetData(), RowBytes, Frame.Data, Frame.RowPitch, Frame.Width, Frame.Height);
+		}
+		else
+		{
+			for (uint32 Row = 0; Row < Frame.Height; ++Row)
+				FMemory::Memcpy(Scratch.GetData() + Row * RowBytes, Frame.Data + Row * Frame.RowPitch, RowBytes);
+		}
+
+		// Torn: the sender is already writing the frame that replaces it, so skip this one.
+		if (!FSpoutMemoryShareReader::IsIntact(Frame))
+			return;
+
+		const FUpdateTextureRegion2D Region(0, 0, 0, 0, Frame.Width, Frame.Height);
+		RHICmdList.UpdateTexture2D(Texture, 0, Region, RowBytes, Scratch.GetData());
+	});
+}
+
 // Called every frame
 void USpoutReceiverActorComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
@@ -245,29 +755,157 @@ void USpoutReceiverActorComponent::TickComponent(float DeltaTime, ELevelTick Tic
 	HANDLE hSharehandle = nullptr;
 	DXGI_FORMAT dwFormat = DXGI_FORMAT_UNKNOWN;
 
-	bool find_sender = senders.FindSender(TCHAR_TO_ANSI(*SubscribeName.ToString()), width, height, hSharehandle, (DWORD&)dwFormat);
+	if (SpoutSenderName::Update(SubscribeName, CachedSubscribeName, SubscribeNameAnsi))
+	{
+		FramePoller.Reset();
+		SenderRecord.Reset();
+		SenderRecordGeneration = MAX_uint64;
+		StopReceiveWorker();
+	}
 
-	EPixelFormat format = PF_Unknown;
+	// Announce ourselves before any early-out, so demand-driven senders keep sending.
+	if (!SubscribeName.IsNone())
+		UpdateConsumerRegistration(SubscribeNameAnsi.GetData());
+
+	if (bMemoryShare || !bEventDrivenReceive)
+		StopReceiveWorker();
+
+	if (bMemoryShare)
+	{
+		TickMemoryShare();
+		return;
+	}
+
+	MemoryShare.Reset();
+
+	const bool bCopyDropped = context.IsValid() && context->bCopyDropped.exchange(false);
+
+	// Senders from this plugin publish a lock-free record: frame number and texture in one
+	// consistent read, without the SDK's named mutex.
+	FSpoutSenderRecord Record;
+	FSpoutSenderRecordReader::EResult RecordResult = FSpoutSenderRecordReader::EResult::Unavailable;
+	if (!SubscribeName.IsNone())
+	{
+		if (!SenderRecord.IsValid())
+		{
+			// Only look again once the directory says a plugin sender came or went.
+			FSpoutSenderDirectory* Directory = FSpoutSenderDirectory::Get();
+			const uint64 Generation = Directory ? Directory->GetGeneration() : MAX_uint64;
+			if (!Directory || Generation != SenderRecordGeneration)
+			{
+				SenderRecordGeneration = Generation;
+				if (!Directory || Directory->Find(SubscribeNameAnsi.GetData()) != INDEX_NONE)
+				{
+					if (TUniquePtr<FSpoutSenderRecordReader> Reader = FSpoutSenderRecordReader::Open(SubscribeNameAnsi.GetData()))
+						SenderRecord = MakeShareable(Reader.Release());
+				}
+			}
+		}
+
+		if (SenderRecord.IsValid())
+		{
+			if (bCopyDropped)
+				SenderRecord->Reset();
+
+			const uint64 RetriesBefore = SenderRecord->GetNumRetries();
+			RecordResult = SenderRecord->Poll(Record);
+			INC_DWORD_STAT_BY(STAT_SpoutSenderRecordRetries, SenderRecord->GetNumRetries() - RetriesBefore);
+			if (RecordResult == FSpoutSenderRecordReader::EResult::Unavailable)
+				INC_DWORD_STAT(STAT_SpoutSenderRecordFallbacks);
+		}
+	}
+
+	// Otherwise a cheap lock-free check of the legacy frame number before the locked FindSender/open/copy.
+	uint32 PolledFrame = 0;
+	bool bPolledFrame = false;
+	bool bUnchanged = bOnlyCopyNewFrames && RecordResult == FSpoutSenderRecordReader::EResult::Unchanged;
+	if (bOnlyCopyNewFrames && !SubscribeName.IsNone() && RecordResult == FSpoutSenderRecordReader::EResult::Unavailable)
+	{
+		if (!FramePoller.IsValid())
+		{
+			if (TUniquePtr<ISpoutSharedMemoryRegion> Region = SpoutSharedMemory::Open(SubscribeNameAnsi.GetData(), sizeof(FSpoutSharedTextureInfoLayout), ESpoutSharedMemoryAccess::ReadOnly))
+			{
+				FramePoller = MakeShared<FSpoutFramePoller>(MoveTemp(Region));
+			}
+		}
+
+		if (FramePoller.IsValid())
+		{
+			if (bCopyDropped)
+				FramePoller->Reset();
+
+			const FSpoutFramePoller::EResult Result = FramePoller->Poll(PolledFrame);
+			bUnchanged = Result == FSpoutFramePoller::EResult::Unchanged;
+			bPolledFrame = Result == FSpoutFramePoller::EResult::NewFrame;
+		}
+	}
+
+	if (bUnchanged)
+	{
+		// No new frame, but readback copies still in flight have to be mapped.
+		if (context.IsValid() && Readback.IsValid() && Readback->HasInFlight())
+		{
+			if (USpoutSubsystem* Subsystem = USpoutSubsystem::Get())
+				Subsystem->QueueStream(context.ToSharedRef());
+		}
+		return;
+	}
+
+	bool find_sender;
+	if (RecordResult != FSpoutSenderRecordReader::EResult::Unavailable)
+	{
+		width = Record.Width;
+		height = Record.Height;
+		hSharehandle = SpoutSharedInfo::Uint32ToHandle(Record.ShareHandle);
+		dwFormat = static_cast<DXGI_FORMAT>(Record.Format);
+		find_sender = true;
+	}
+	else
+	{
+		find_sender = senders.FindSender(SubscribeNameAnsi.GetData(), width, height, hSharehandle, (DWORD&)dwFormat);
+	}
+
+	const EPixelFormat format = SpoutFormats::FromDXGI(dwFormat);
+
+	FSpoutSenderDesc Sender;
+	if (find_sender && format != PF_Unknown)
+		Sender = { width, height, static_cast<uint32>(dwFormat), SpoutSharedInfo::HandleToUint32(hSharehandle) };
 
-	if (dwFormat == DXGI_FORMAT_B8G8R8A8_UNORM)
-		format = PF_B8G8R8A8;
-	else if (dwFormat == DXGI_FORMAT_R16G16B16A16_FLOAT)
-		format = PF_FloatRGBA;
-	else if (dwFormat == DXGI_FORMAT_R32G32B32A32_FLOAT)
-		format = PF_A32B32G32R32F;
-
-	if (!find_sender
-		|| !hSharehandle
-		|| format == PF_Unknown
-		|| width == 0
-		|| height == 0)
+	if (!ReceiverState.IsValid())
+		ReceiverState = MakeShared<FSpoutReceiverState>();
+
+	switch (ReceiverState->Update(Sender))
+	{
+	case ESpoutReceiverAction::Disconnect:
+		if (context.IsValid())
+			context->ReleaseSharedTextures();
+		break;
+
+	case ESpoutReceiverAction::Reallocate:
+		INC_DWORD_STAT(STAT_SpoutReceiverReallocations);
+		// Same as the first allocation, from the pool.
+		[[fallthrough]];
+	case ESpoutReceiverAction::Allocate:
+		ReallocateIntermediate(width, height, format);
+		break;
+
+	default:
+		// Reopen: handled by the context's shared texture cache below.
+		break;
+	}
+
+	if (!ReceiverState->IsConnected())
 		return;
 
-	if (!this->IntermediateTextureResource)
+	// Following the active sender: its name is only known now.
+	if (SubscribeName.IsNone())
+		UpdateConsumerRegistration(SubscribeNameAnsi.GetData());
+
+	if (!IntermediateTextureResource || !IntermediateTextureResource->GetResource())
 	{
-		this->IntermediateTextureResource = NewObject<UTextureRenderTarget2D>(this);
-		this->IntermediateTextureResource->InitCustomFormat(width, height, format, false);
-		this->IntermediateTextureResource->UpdateResourceImmediate(false);
+		// No texture to receive into (e.g. pooling unavailable); try again next tick.
+		ReceiverState->Reset();
+		return;
 	}
 
 	FRHITexture* IntermediateRHI = IntermediateTextureResource->GetResource()->TextureRHI.GetReference();
@@ -275,38 +913,61 @@ void USpoutReceiverActorComponent::TickComponent(float DeltaTime, ELevelTick Tic
 
 	if (!context.IsValid())
 	{
-		context = TSharedPtr<SpoutReceiverContext>(new SpoutReceiverContext(width, height, dwFormat, IntermediateRHI));
+		context = TSharedPtr<SpoutReceiverContext>(new SpoutReceiverContext(width, height, dwFormat, IntermediateRHI, SyncMode));
+		BoundOutputRHI = nullptr;
+		bReadbackBound = false;
 	}
 
-	ID3D11Texture2D* SharedTex = nullptr;
-	verify(spoutdx.OpenDX11shareHandle(context->D3D11Device, &SharedTex, hSharehandle));
-	context->CopyResource(SharedTex);
-	SharedTex->Release();
+	// Kept rather than rebuilt every tick; the next reallocation tries again.
+	if (!context->IsUsable())
+		return;
 
-	ENQUEUE_RENDER_COMMAND(SpoutReceiverRenderThreadOp)(
-		[IntermediateRHI, this](FRHICommandListImmediate& RHICmdList) {
-		if (!GWorld || !IntermediateRHI) return;
+	if (FSpoutReadback::Sync(Readback, bEnableReadback, NumReadbackBuffers, ReadbackLatency, bReadbackToRGBA8, ReadbackCallback))
+		bReadbackBound = false;
 
-		FRHIRenderPassInfo RPInfo(IntermediateRHI, ERenderTargetActions::DontLoad_Store);
-		RHICmdList.BeginRenderPass(RPInfo, TEXT("SpoutReceiver"));
-
-		FGlobalShaderMap* GlobalShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
-		TShaderMapRef<FMediaShadersVS> VertexShader(GlobalShaderMap);
-		TShaderMapRef<FTextureCopyPixelShader> PixelShader(GlobalShaderMap);
+	if (!bReadbackBound)
+	{
+		SpoutReceiverContext::SetReadback(context.ToSharedRef(), Readback);
+		bReadbackBound = true;
+	}
 
-		FRHITextureSRVCreateInfo SRVDesc{};
-		IntermediateTextureParameterSRV = RHICmdList.CreateShaderResourceView(IntermediateRHI, SRVDesc);
+	FRHITexture* OutputRHI = OutputRenderTarget->GetResource() ? OutputRenderTarget->GetResource()->TextureRHI.GetReference() : nullptr;
+	if (OutputRHI != BoundOutputRHI || Conversion != BoundConversion)
+	{
+		SpoutReceiverContext::SetOutput(context.ToSharedRef(), OutputRHI, Conversion);
+		BoundOutputRHI = OutputRHI;
+		BoundConversion = Conversion;
+	}
 
-		if (PixelShader->SrcTexture.IsBound())
+	// Event-driven: the worker stages frames as they are published, and the batch picks up
+	// whichever is newest. The tick only follows the sender's size and format (SenderRecord
+	// is not marked consumed while the worker runs, so every tick gets here), keeps the
+	// worker on the current context and queues it, so staged frames and readbacks are served.
+	if (bEventDrivenReceive && RecordResult != FSpoutSenderRecordReader::EResult::Unavailable)
+	{
+		UpdateReceiveWorker(bCopyDropped);
+		if (ReceiveWorker.IsValid())
 		{
-			FRHIBatchedShaderParameters& BatchedParameters = RHICmdList.GetScratchShaderParameters();
-			SetSRVParameter(BatchedParameters, PixelShader->SrcTexture, IntermediateTextureParameterSRV);
-			RHICmdList.SetBatchedShaderParameters(PixelShader.GetPixelShader(), BatchedParameters);
+			if (USpoutSubsystem* Subsystem = USpoutSubsystem::Get())
+				Subsystem->QueueStream(context.ToSharedRef());
+			return;
 		}
+	}
 
-		RHICmdList.EndRenderPass();
+	ID3D11Texture2D* SharedTex = context->AcquireSharedTexture(hSharehandle, width, height, dwFormat);
+	if (!SharedTex)
+		return;
 
-		FRHICopyTextureInfo CopyInfo{};
-		RHICmdList.CopyTexture(IntermediateRHI, IntermediateRHI, CopyInfo);
-	});
+	// Our reference goes to the render thread.
+	context->Stage(SharedTex);
+
+	if (RecordResult == FSpoutSenderRecordReader::EResult::NewFrame)
+		SenderRecord->MarkConsumed(Record.FrameNumber);
+	else if (bPolledFrame)
+		FramePoller->MarkConsumed(PolledFrame);
+
+	if (USpoutSubsystem* Subsystem = USpoutSubsystem::Get())
+	{
+		Subsystem->QueueStream(context.ToSharedRef());
+	}
 }
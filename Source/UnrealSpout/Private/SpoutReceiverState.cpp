@@ -0,0 +1,44 @@
+#include "SpoutReceiverState.h"
+
+ESpoutReceiverAction FSpoutReceiverState::Update(const FSpoutSenderDesc& Sender)
+{
+	if (!Sender.IsValid())
+	{
+		if (!bConnected)
+			return ESpoutReceiverAction::None;
+
+		bConnected = false;
+		Current = FSpoutSenderDesc();
+		return ESpoutReceiverAction::Disconnect;
+	}
+
+	const bool bWasConnected = bConnected;
+	const FSpoutSenderDesc Previous = Current;
+	bConnected = true;
+	Current = Sender;
+
+	if (!Allocated.IsValid())
+	{
+		Allocated = Sender;
+		return ESpoutReceiverAction::Allocate;
+	}
+
+	if (!Allocated.SameAllocation(Sender))
+	{
+		Allocated = Sender;
+		++NumReallocations;
+		return ESpoutReceiverAction::Reallocate;
+	}
+
+	if (!bWasConnected || Previous.Handle != Sender.Handle)
+		return ESpoutReceiverAction::Reopen;
+
+	return ESpoutReceiverAction::None;
+}
+
+void FSpoutReceiverState::Reset()
+{
+	Current = FSpoutSenderDesc();
+	Allocated = FSpoutSenderDesc();
+	bConnected = false;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** What FindSender reported this tick. A zero Width means no usable sender. */
+struct FSpoutSenderDesc
+{
+	uint32 Width = 0;
+	uint32 Height = 0;
+	/** DXGI_FORMAT */
+	uint32 Format = 0;
+	/** Share handle truncated to 32 bits, as Spout stores it */
+	uint32 Handle = 0;
+
+	bool IsValid() const { return Width != 0 && Height != 0 && Format != 0 && Handle != 0; }
+	bool SameAllocation(const FSpoutSenderDesc& Other) const { return Width == Other.Width && Height == Other.Height && Format == Other.Format; }
+};
+
+/** What a receiver has to do after FSpoutReceiverState::Update. */
+enum class ESpoutReceiverAction : uint8
+{
+	None,
+	/** First sender seen: allocate the intermediate texture. */
+	Allocate,
+	/** The sender changed size or format: replace the intermediate texture. */
+	Reallocate,
+	/** Same size and format, different shared texture (ring slot, or a sender that came back). */
+	Reopen,
+	/** The sender went away: drop the shared textures opened for it, keep the intermediate. */
+	Disconnect,
+};
+
+/**
+ * Tracks the sender a receiver is bound to across ticks and turns changes in its
+ * (width, height, format, handle) into the one action the receiver has to take. The
+ * intermediate texture outlives a disconnect, so a sender that comes back at the same
+ * size only costs a reopen. Engine independent.
+ */
+class FSpoutReceiverState
+{
+public:
+	ESpoutReceiverAction Update(const FSpoutSenderDesc& Sender);
+
+	bool IsConnected() const { return bConnected; }
+	const FSpoutSenderDesc& GetSender() const { return Current; }
+
+	/** Size and format the intermediate texture was last allocated for. Zero before the first sender. */
+	const FSpoutSenderDesc& GetAllocation() const { return Allocated; }
+
+	/** Reallocations after the first allocation. */
+	uint32 GetNumReallocations() const { return NumReallocations; }
+
+	/** Forgets the sender and the allocation, e.g. when the intermediate texture was released. */
+	void Reset();
+
+private:
+	FSpoutSenderDesc Current;
+	FSpoutSenderDesc Allocated;
+	bool bConnected = false;
+	uint32 NumReallocations = 0;
+};
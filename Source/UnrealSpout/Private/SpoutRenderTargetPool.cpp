@@ -0,0 +1,64 @@
+#include "SpoutRenderTargetPool.h"
+
+#include "Engine/TextureRenderTarget2D.h"
+#include "UObject/Package.h"
+
+#include "SpoutStats.h"
+
+FSpoutRenderTargetPool::FSpoutRenderTargetPool()
+	// Evicted targets are only unreferenced; GC collects them once nothing else (e.g. a scene
+	// capture still pointing at one) holds them.
+	: Pool(MaxIdle, MaxIdleFrames, [](const FKey&, TObjectPtr<UTextureRenderTarget2D>& RenderTarget)
+	{
+		RenderTarget = nullptr;
+	})
+{
+}
+
+UTextureRenderTarget2D* FSpoutRenderTargetPool::Acquire(const FIntPoint& Size, EPixelFormat Format)
+{
+	check(IsInGameThread());
+
+	TObjectPtr<UTextureRenderTarget2D> RenderTarget;
+	if (Pool.Acquire({ Size, Format }, RenderTarget) && IsValid(RenderTarget))
+	{
+		INC_DWORD_STAT(STAT_SpoutPoolHits);
+		return RenderTarget;
+	}
+
+	INC_DWORD_STAT(STAT_SpoutPoolMisses);
+
+	RenderTarget = NewObject<UTextureRenderTarget2D>(GetTransientPackage());
+	RenderTarget->ClearColor = FLinearColor::Black;
+	RenderTarget->InitCustomFormat(Size.X, Size.Y, Format, true);
+	RenderTarget->UpdateResourceImmediate(true);
+	return RenderTarget;
+}
+
+void FSpoutRenderTargetPool::Release(UTextureRenderTarget2D* RenderTarget)
+{
+	check(IsInGameThread());
+	if (!IsValid(RenderTarget))
+		return;
+
+	const FKey Key { FIntPoint(RenderTarget->SizeX, RenderTarget->SizeY), RenderTarget->GetFormat() };
+	Pool.Release(Key, RenderTarget, GFrameCounter);
+}
+
+void FSpoutRenderTargetPool::Trim()
+{
+	Pool.Trim(GFrameCounter);
+}
+
+void FSpoutRenderTargetPool::Empty()
+{
+	Pool.Empty();
+}
+
+void FSpoutRenderTargetPool::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Pool.ForEachIdle([&Collector](const FKey&, TObjectPtr<UTextureRenderTarget2D>& RenderTarget)
+	{
+		Collector.AddReferencedObject(RenderTarget);
+	});
+}
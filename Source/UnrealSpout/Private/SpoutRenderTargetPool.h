@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectPtr.h"
+#include "UObject/UObjectGlobals.h"
+
+#include "SpoutResourcePool.h"
+
+class UTextureRenderTarget2D;
+
+/**
+ * Render targets bucketed by size and format, so toggling between resolutions reuses
+ * allocations instead of churning VRAM. Every target is created with linear gamma and
+ * no mips, which is all Spout streams use. Game thread only.
+ */
+class FSpoutRenderTargetPool
+{
+public:
+	/** Idle targets kept, and how many frames one may stay idle. */
+	static constexpr int32 MaxIdle = 8;
+	static constexpr uint64 MaxIdleFrames = 600;
+
+	FSpoutRenderTargetPool();
+
+	/** A pooled target of this size and format, or a new one. */
+	UTextureRenderTarget2D* Acquire(const FIntPoint& Size, EPixelFormat Format);
+
+	/** Hands a target from Acquire back. It must not be drawn to or sent afterwards. */
+	void Release(UTextureRenderTarget2D* RenderTarget);
+
+	/** Drops targets idle for longer than MaxIdleFrames, leaving them to GC. Call once per frame. */
+	void Trim();
+
+	void Empty();
+
+	/** Keeps idle targets from being garbage collected. */
+	void AddReferencedObjects(FReferenceCollector& Collector);
+
+private:
+	struct FKey
+	{
+		FIntPoint Size = FIntPoint::ZeroValue;
+		EPixelFormat Format = PF_Unknown;
+
+		bool operator==(const FKey& Other) const { return Size == Other.Size && Format == Other.Format; }
+	};
+
+	TSpoutResourcePool<FKey, TObjectPtr<UTextureRenderTarget2D>> Pool;
+};
@@ -0,0 +1,41 @@
+#include "SpoutResizeDetector.h"
+
+FSpoutResizeDetector::FSpoutResizeDetector(int32 InSettleTicks)
+	: SettleTicks(FMath::Max(1, InSettleTicks))
+{
+}
+
+bool FSpoutResizeDetector::Update(const FIntPoint& Size)
+{
+	if (Size.X <= 0 || Size.Y <= 0 || Size == Current)
+	{
+		StableTicks = 0;
+		return false;
+	}
+
+	// Nothing allocated yet: there is no old size worth keeping.
+	if (Current.X <= 0 || Current.Y <= 0)
+	{
+		Reset(Size);
+		return true;
+	}
+
+	if (Size != Candidate)
+	{
+		Candidate = Size;
+		StableTicks = 0;
+	}
+
+	if (++StableTicks < SettleTicks)
+		return false;
+
+	Reset(Size);
+	return true;
+}
+
+void FSpoutResizeDetector::Reset(const FIntPoint& Size)
+{
+	Current = Size;
+	Candidate = Size;
+	StableTicks = 0;
+}
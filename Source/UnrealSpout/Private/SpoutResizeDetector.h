@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Follows a window size with hysteresis: a new size is only reported once it has held
+ * for SettleTicks consecutive ticks, so dragging a window edge reallocates once at the
+ * end instead of every frame. Zero-area sizes (minimised windows) are ignored.
+ */
+class FSpoutResizeDetector
+{
+public:
+	explicit FSpoutResizeDetector(int32 InSettleTicks = 8);
+
+	/** Feeds this tick's size. Returns true when GetSize() has changed. */
+	bool Update(const FIntPoint& Size);
+
+	/** Accepts Size immediately, e.g. for the first allocation. */
+	void Reset(const FIntPoint& Size);
+
+	void SetSettleTicks(int32 InSettleTicks) { SettleTicks = FMath::Max(1, InSettleTicks); }
+
+	const FIntPoint& GetSize() const { return Current; }
+
+private:
+	int32 SettleTicks;
+	FIntPoint Current = FIntPoint::ZeroValue;
+	FIntPoint Candidate = FIntPoint::ZeroValue;
+	int32 StableTicks = 0;
+};
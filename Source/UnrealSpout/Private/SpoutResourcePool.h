@@ -0,0 +1,121 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Pool of idle GPU resources bucketed by an exact key (size, format, device...), so a
+ * stream that goes back to a size it used before gets its old allocation back instead
+ * of creating a new one. Idle entries are evicted least recently released first once
+ * more than MaxIdle are held, and by Trim once they have been idle for MaxIdleAge.
+ * Ages are in whatever clock the caller passes (frames, milliseconds).
+ *
+ * Not thread safe, and engine independent so the policy can be exercised without a GPU.
+ * OnEvict runs for every value that leaves the pool other than through Acquire.
+ */
+template <typename KeyType, typename ValueType>
+class TSpoutResourcePool
+{
+public:
+	struct FStats
+	{
+		uint64 Hits = 0;
+		uint64 Misses = 0;
+		uint64 Evictions = 0;
+	};
+
+	using FOnEvict = TFunction<void(const KeyType&, ValueType&)>;
+
+	TSpoutResourcePool(int32 InMaxIdle, uint64 InMaxIdleAge, FOnEvict InOnEvict = nullptr)
+		: MaxIdle(FMath::Max(0, InMaxIdle))
+		, MaxIdleAge(InMaxIdleAge)
+		, OnEvict(MoveTemp(InOnEvict))
+	{
+		Idle.Reserve(MaxIdle + 1);
+	}
+
+	~TSpoutResourcePool()
+	{
+		Empty();
+	}
+
+	/** Takes the most recently released idle value for Key. False on a miss. */
+	bool Acquire(const KeyType& Key, ValueType& OutValue)
+	{
+		for (int32 i = Idle.Num() - 1; i >= 0; --i)
+		{
+			if (Idle[i].Key == Key)
+			{
+				OutValue = MoveTemp(Idle[i].Value);
+				Idle.RemoveAt(i, 1, EAllowShrinking::No);
+				++Stats.Hits;
+				return true;
+			}
+		}
+		++Stats.Misses;
+		return false;
+	}
+
+	/** Hands a value back at time Now. The oldest idle values go if the pool is over MaxIdle. */
+	void Release(const KeyType& Key, ValueType Value, uint64 Now)
+	{
+		FEntry& Entry = Idle.AddDefaulted_GetRef();
+		Entry.Key = Key;
+		Entry.Value = MoveTemp(Value);
+		Entry.ReleasedAt = Now;
+
+		// Idle is kept in release order, so the front is always the oldest.
+		while (Idle.Num() > MaxIdle)
+			EvictAt(0);
+	}
+
+	/** Evicts values idle for longer than MaxIdleAge. Returns how many were removed. */
+	int32 Trim(uint64 Now)
+	{
+		int32 NumRemoved = 0;
+		while (Idle.Num() > 0 && Now - Idle[0].ReleasedAt > MaxIdleAge)
+		{
+			EvictAt(0);
+			++NumRemoved;
+		}
+		return NumRemoved;
+	}
+
+	void Empty()
+	{
+		while (Idle.Num() > 0)
+			EvictAt(Idle.Num() - 1);
+	}
+
+	template <typename FunctionType>
+	void ForEachIdle(FunctionType Function)
+	{
+		for (FEntry& Entry : Idle)
+			Function(Entry.Key, Entry.Value);
+	}
+
+	int32 NumIdle() const { return Idle.Num(); }
+	const FStats& GetStats() const { return Stats; }
+
+private:
+	struct FEntry
+	{
+		KeyType Key;
+		ValueType Value;
+		uint64 ReleasedAt = 0;
+	};
+
+	void EvictAt(int32 Index)
+	{
+		if (OnEvict)
+			OnEvict(Idle[Index].Key, Idle[Index].Value);
+
+		Idle.RemoveAt(Index, 1, EAllowShrinking::No);
+		++Stats.Evictions;
+	}
+
+	int32 MaxIdle;
+	uint64 MaxIdleAge;
+	FOnEvict OnEvict;
+	TArray<FEntry> Idle;
+	FStats Stats;
+};
@@ -4,7 +4,6 @@
 #include "SpoutSenderActorComponent.h"
 
 #include <string>
-#include <map>
 
 #include "Windows/AllowWindowsPlatformTypes.h" 
 #include <d3d11on12.h>
@@ -14,40 +13,107 @@
 #include "RenderCore.h"         // FRHIBatchedShaderParameters helpers
 #include "ShaderParameterUtils.h"  // SetSRVParameter
 
+#include "ID3D11DynamicRHI.h"
 #include "RHI.h"            // for FRHITexture & GetNativeResource()
 #include "RenderResource.h"
 #include "RenderUtils.h"
 
-static std::map<std::string, int> sender_name_reference_countor;
+#include "SpoutBatch.h"
+#include "SpoutConsumerTable.h"
+#include "SpoutD3D12Native.h"
+#include "SpoutFrameSignal.h"
+#include "SpoutFrameSync.h"
+#include "SpoutFormats.h"
+#include "SpoutInteropDevice.h"
+#include "SpoutMemoryShare.h"
+#include "SpoutReadback.h"
+#include "SpoutRHI.h"
+#include "SpoutSenderRecord.h"
+#include "SpoutSenderRegistry.h"
+#include "SpoutSharedInfo.h"
+#include "SpoutSharedTexturePool.h"
+#include "SpoutSubsystem.h"
+#include "SpoutTextureRing.h"
+
+#include <atomic>
+
+struct USpoutSenderActorComponent::SpoutSenderCounters
+{
+	std::atomic<int64> FramesSent { 0 };
+	std::atomic<int64> FramesSkipped { 0 };
+};
 
-struct USpoutSenderActorComponent::SpoutSenderContext
+struct USpoutSenderActorComponent::SpoutSenderContext : public ISpoutStream
 {
+	ESpoutRHIBackend Backend = ESpoutRHIBackend::Unsupported;
+	ESpoutSharePath Path = ESpoutSharePath::Unsupported;
+	bool bPreferNativeD3D12 = false;
+
+	/** D3D12 only: the shared 11on12 device; D3D11Device, deviceContext and D3D11on12Device are borrowed from it. */
+	TSharedPtr<FSpoutInteropDevice, ESPMode::ThreadSafe> InteropDevice;
+
 	ID3D11Device* D3D11Device = nullptr;
 	ID3D11On12Device* D3D11on12Device = nullptr;
 	ID3D11Resource* WrappedDX11Resource = nullptr;
 
 	spoutSenderNames senders;
-	spoutDirectX sdx;
 
 	FName Name;
 	std::string Name_str;
 	unsigned int width = 0, height = 0;
 
-	HANDLE sharedSendingHandle = nullptr;
-	ID3D11Texture2D* sendingTexture = nullptr;
+	DXGI_FORMAT texFormat = DXGI_FORMAT_UNKNOWN;
+
+	using FSharedSlot = FSpoutSharedTexture;
+
+	/** Slots come from and go back to the shared texture pool under this key. */
+	FSpoutSharedTexturePool::FKey PoolKey;
+	FSpoutTextureRing Ring;
+	FSharedSlot Slots[FSpoutTextureRing::MaxSlots];
 	ID3D11DeviceContext* deviceContext = nullptr;
 
+	/** Each slot as an RHI texture, created with the context; null where the backend cannot open it. For reading only. */
+	FTextureRHIRef SlotRHIs[FSpoutTextureRing::MaxSlots];
+
+	ESpoutSyncMode RequestedSyncMode;
+	TUniquePtr<ISpoutFrameSync> FrameSync;
+	uint64 FrameCounter = 0;
+
+	/** Lock-free copy of what Publish advertises, read by this plugin's receivers. Shared with other senders of the name. */
+	TSharedPtr<FSpoutSenderRecordWriter, ESPMode::ThreadSafe> Record;
+
+	/** Wakes this plugin's event-driven receivers after each Publish. Shared with other senders of the name. */
+	TSharedPtr<FSpoutFrameSignalSender, ESPMode::ThreadSafe> FrameSignal;
+
+	/** Set once the name is counted in the sender registry; a constructor that returned early never got that far. */
+	bool bRegistered = false;
+
+	/** Set on the game thread when the source has new content; consumed by the next batch. */
+	std::atomic<bool> bCopyRequested { false };
+	bool bSentThisBatch = false;
+
+	/** CPU readback of every sent frame. Render thread only; set through SetReadback. */
+	TSharedPtr<FSpoutReadback, ESPMode::ThreadSafe> Readback;
+	TSharedRef<SpoutSenderCounters, ESPMode::ThreadSafe> Counters;
+
 	FRHITexture* Texture;
 
 	SpoutSenderContext(const FName& Name,
-		FRHITexture* Texture)
-		: Name(Name)
+		FRHITexture* Texture,
+		int32 NumBuffers,
+		ESpoutSyncMode SyncMode,
+		bool bPreferNativeD3D12,
+		const TSharedRef<SpoutSenderCounters, ESPMode::ThreadSafe>& Counters)
+		: bPreferNativeD3D12(bPreferNativeD3D12)
+		, Name(Name)
+		, Ring(NumBuffers)
+		, RequestedSyncMode(SyncMode)
+		, Counters(Counters)
 		, Texture(Texture)
 	{
-		DXGI_FORMAT texFormat;
-		FString RHIName = GDynamicRHI->GetName();
+		Backend = SpoutRHI::GetBackend();
 
-		if (RHIName == TEXT("D3D11"))
+		if (Backend == ESpoutRHIBackend::D3D11)
 		{
 			D3D11Device = static_cast<ID3D11Device*>(GDynamicRHI->RHIGetNativeDevice());
 			D3D11Device->GetImmediateContext(&deviceContext);
@@ -64,25 +130,15 @@ struct USpoutSenderActorComponent::SpoutSenderContext
 
 			texFormat = desc.Format;
 		}
-		else if (RHIName == TEXT("D3D12"))
+		else if (Backend == ESpoutRHIBackend::D3D12)
 		{
-			ID3D12Device* Device12 = static_cast<ID3D12Device*>(GDynamicRHI->RHIGetNativeDevice());
-			UINT DeviceFlags11 = D3D11_CREATE_DEVICE_BGRA_SUPPORT;
-
-			verify(D3D11On12CreateDevice(
-				Device12,
-				DeviceFlags11,
-				nullptr,
-				0,
-				nullptr,
-				0,
-				0,
-				&D3D11Device,
-				&deviceContext,
-				nullptr
-			) == S_OK);
-
-			verify(D3D11Device->QueryInterface(__uuidof(ID3D11On12Device), (void**)&D3D11on12Device) == S_OK);
+			InteropDevice = FSpoutInteropDevice::Acquire();
+			if (!InteropDevice.IsValid())
+				return;
+
+			D3D11Device = InteropDevice->GetDevice();
+			deviceContext = InteropDevice->GetContext();
+			D3D11on12Device = InteropDevice->GetOn12Device();
 
 			D3D12_RESOURCE_DESC desc;
 			ID3D12Resource* NativeTex = static_cast<ID3D12Resource*>(Texture->GetNativeResource());
@@ -94,111 +150,339 @@ struct USpoutSenderActorComponent::SpoutSenderContext
 			height = desc.Height;
 
 			texFormat = desc.Format;
-
-			D3D11_RESOURCE_FLAGS rf11 = {};
-
-			verify(D3D11on12Device->CreateWrappedResource(
-				NativeTex, &rf11,
-				D3D12_RESOURCE_STATE_COPY_SOURCE,
-				D3D12_RESOURCE_STATE_PRESENT, __uuidof(ID3D11Resource),
-				(void**)&WrappedDX11Resource) == S_OK);
 		}
 		else
 		{
 			throw;
 		}
 
-		if (texFormat == DXGI_FORMAT_B8G8R8A8_TYPELESS) {
-			texFormat = DXGI_FORMAT_B8G8R8A8_UNORM;
-		}
+		texFormat = static_cast<DXGI_FORMAT>(SpoutFormats::ToTypedDXGI(texFormat));
 
 		Name_str = TCHAR_TO_ANSI(*Name.ToString());;
 
-		verify(sdx.CreateSharedDX11Texture(D3D11Device, width, height, texFormat, &sendingTexture, sharedSendingHandle));
+		PoolKey = { D3D11Device, width, height, static_cast<uint32>(texFormat), Name };
+		for (int32 i = 0; i < Ring.Num(); ++i)
+		{
+			verify(FSpoutSharedTexturePool::Get().Acquire(PoolKey, Slots[i]));
+		}
+
+		verify(senders.CreateSender(Name_str.c_str(), width, height, Slots[0].Handle, texFormat));
 
-		if (sender_name_reference_countor.find(Name_str) == sender_name_reference_countor.end())
-			sender_name_reference_countor[Name_str] = 0;
+		// Counted and listed in the sender directory; the name's one record writer and frame signal come with it.
+		const FSpoutSenderRegistry::FWriters Writers = FSpoutSenderRegistry::Get().Acquire(Name_str.c_str(), FSpoutConsumerTable::NowMs());
+		Record = Writers.Record;
+		FrameSignal = Writers.FrameSignal;
+		bRegistered = true;
 
-		sender_name_reference_countor[Name_str] += 1;
+		FSpoutNativeShareCaps NativeCaps;
+		TUniquePtr<ISpoutFrameSync> NativeFrameSync;
+		if (Backend == ESpoutRHIBackend::D3D12 && bPreferNativeD3D12)
+		{
+			NativeCaps.bOpenedSharedTextures = OpenNativeSlots();
+			NativeFrameSync = SpoutD3D12Native::CreateFenceFrameSync();
+			NativeCaps.bCreatedFence = NativeFrameSync.IsValid();
+		}
 
-		verify(senders.CreateSender(Name_str.c_str(), width, height, sharedSendingHandle, texFormat));
+		Path = SpoutRHI::SelectSharePath(Backend, bPreferNativeD3D12, NativeCaps);
+
+		if (Path == ESpoutSharePath::NativeD3D12)
+		{
+			FrameSync = SyncMode == ESpoutSyncMode::None ? MakeUnique<FSpoutNoFrameSync>() : MoveTemp(NativeFrameSync);
+		}
+		else
+		{
+			for (FSharedSlot& Slot : Slots)
+				Slot.NativeRHI.SafeRelease();
+
+			if (Path == ESpoutSharePath::D3D11On12)
+			{
+				D3D11_RESOURCE_FLAGS rf11 = {};
+
+				verify(D3D11on12Device->CreateWrappedResource(
+					static_cast<ID3D12Resource*>(Texture->GetNativeResource()), &rf11,
+					D3D12_RESOURCE_STATE_COPY_SOURCE,
+					D3D12_RESOURCE_STATE_PRESENT, __uuidof(ID3D11Resource),
+					(void**)&WrappedDX11Resource) == S_OK);
+			}
+
+			FrameSync = SpoutFrameSync::Create(SyncMode, D3D11Device, deviceContext);
+		}
+
+		CreateSlotRHIs();
 	}
 
-	~SpoutSenderContext()
+	/** Wraps every slot once, so handing out the published frame never allocates. */
+	void CreateSlotRHIs()
 	{
-		sender_name_reference_countor[Name_str] -= 1;
+		const EPixelFormat PixelFormat = SpoutFormats::FromDXGI(texFormat);
+		if (PixelFormat == PF_Unknown)
+			return;
 
-		if (sender_name_reference_countor[Name_str] == 0)
-			senders.ReleaseSenderName(Name_str.c_str());
+		for (int32 i = 0; i < Ring.Num(); ++i)
+		{
+			if (Backend == ESpoutRHIBackend::D3D11)
+				SlotRHIs[i] = GetID3D11DynamicRHI()->RHICreateTexture2DFromResource(PixelFormat, ETextureCreateFlags::Shared, FClearValueBinding::None, Slots[i].Texture);
+			else if (Slots[i].NativeRHI.IsValid())
+				SlotRHIs[i] = Slots[i].NativeRHI;
+			else
+				SlotRHIs[i] = SpoutD3D12Native::OpenSharedTexture(Slots[i].Handle, PixelFormat);
+		}
+	}
+
+	/** Opens every slot on the RHI's D3D12 device; false if the driver refuses any of them. */
+	bool OpenNativeSlots()
+	{
+		const EPixelFormat PixelFormat = SpoutFormats::FromDXGI(texFormat);
+		if (PixelFormat == PF_Unknown)
+			return false;
 
-		if (sendingTexture)
+		for (int32 i = 0; i < Ring.Num(); ++i)
 		{
-			sendingTexture->Release();
-			sendingTexture = nullptr;
+			// Pooled slots may already have been opened by an earlier sender.
+			if (Slots[i].NativeRHI.IsValid())
+				continue;
+
+			Slots[i].NativeRHI = SpoutD3D12Native::OpenSharedTexture(Slots[i].Handle, PixelFormat);
+			if (!Slots[i].NativeRHI.IsValid())
+				return false;
 		}
+		return true;
+	}
 
-		if (deviceContext)
+	virtual ~SpoutSenderContext() override
+	{
+		for (FTextureRHIRef& SlotRHI : SlotRHIs)
+			SlotRHI.SafeRelease();
+
+		if (bRegistered && FSpoutSenderRegistry::Get().Release(Name_str.c_str()) == 0)
 		{
-			deviceContext->Release();
-			deviceContext = nullptr;
+			if (Record.IsValid())
+				Record->Close();
+			senders.ReleaseSenderName(Name_str.c_str());
 		}
 
-		if (WrappedDX11Resource)
+		// The GPU may still be copying into the slots: they go back to the pool only once
+		// FrameSync reports the last frame done, and FrameSync, with the interop device it
+		// may poll, stays alive until then.
+		TArray<FSharedSlot> Retiring;
+		for (FSharedSlot& Slot : Slots)
 		{
-			D3D11on12Device->ReleaseWrappedResources(&WrappedDX11Resource, 1);
-			WrappedDX11Resource = nullptr;
+			if (Slot.Texture)
+				Retiring.Add(MoveTemp(Slot));
+			Slot = FSharedSlot();
 		}
 
-		if (D3D11on12Device)
+		if (Retiring.Num() > 0)
 		{
-			D3D11on12Device->Release();
-			D3D11on12Device = nullptr;
+			TSharedPtr<ISpoutFrameSync, ESPMode::ThreadSafe> Sync;
+			if (FrameSync)
+				Sync = MakeShareable(FrameSync.Release());
+
+			FSpoutSharedTexturePool::Get().ReleaseWhenIdle(PoolKey, MoveTemp(Retiring),
+				[Sync, LastFrame = FrameCounter, KeepInterop = InteropDevice]() {
+				return !Sync.IsValid() || Sync->GetCompletedFrame() >= LastFrame;
+			});
 		}
+		FrameSync.Reset();
 
-		if (D3D11Device)
+		if (WrappedDX11Resource)
 		{
-			D3D11Device->Release();
-			D3D11Device = nullptr;
+			WrappedDX11Resource->Release();
+			WrappedDX11Resource = nullptr;
 		}
+
+		// Only the D3D11 path owns a reference (from GetImmediateContext); the rest is
+		// the RHI's device or borrowed from InteropDevice.
+		if (Backend == ESpoutRHIBackend::D3D11 && deviceContext)
+			deviceContext->Release();
+
+		deviceContext = nullptr;
+		D3D11on12Device = nullptr;
+		D3D11Device = nullptr;
+		InteropDevice.Reset();
 	}
 
-	void Tick()
+	/** Hands the readback stage (or null) to the render thread. Game thread. */
+	static void SetReadback(const TSharedRef<SpoutSenderContext, ESPMode::ThreadSafe>& Context, TSharedPtr<FSpoutReadback, ESPMode::ThreadSafe> NewReadback)
 	{
-		if (!deviceContext)
+		ENQUEUE_RENDER_COMMAND(SpoutSenderSetReadback)(
+			[Context, NewReadback = MoveTemp(NewReadback)](FRHICommandListImmediate&) mutable {
+			Context->Readback = MoveTemp(NewReadback);
+		});
+	}
+
+	virtual void Process_RenderThread(FSpoutFrameBatch& Batch) override
+	{
+		bSentThisBatch = false;
+
+		if (!deviceContext || !FrameSync)
+			return;
+
+		RetireCompleted();
+
+		// Unchanged source: only the retire above runs, so a pending frame still gets published.
+		if (!bCopyRequested.exchange(false))
 			return;
 
-		FString RHIName = GDynamicRHI->GetName();
+		bSentThisBatch = true;
 
-		if (RHIName == TEXT("D3D11"))
+		if (Backend == ESpoutRHIBackend::D3D11)
 		{
-			ENQUEUE_RENDER_COMMAND(SpoutSenderRenderThreadOp)([this](FRHICommandListImmediate& RHICmdList) {
-				ID3D11Texture2D* NativeTex = static_cast<ID3D11Texture2D*>(Texture->GetNativeResource());
-				if (!NativeTex)
-					return;
+			ID3D11Texture2D* NativeTex = static_cast<ID3D11Texture2D*>(Texture->GetNativeResource());
+			if (!NativeTex)
+				return;
 
-				this->deviceContext->CopyResource(sendingTexture, NativeTex);
-				this->deviceContext->Flush();
+			const int32 Slot = BeginWrite();
+			if (Slot == INDEX_NONE)
+				return;
 
-				verify(this->senders.UpdateSender(TCHAR_TO_ANSI(*this->Name.ToString()),
-					this->width, this->height,
-					this->sharedSendingHandle));
-			});
+			// deviceContext is the RHI's own immediate context, so the copy goes out
+			// with the engine's next submission; no Flush needed.
+			deviceContext->CopyResource(Slots[Slot].Texture, NativeTex);
+			FrameSync->Signal(EndWrite(Slot));
 		}
-		else if (RHIName == TEXT("D3D12"))
+		else if (Path == ESpoutSharePath::NativeD3D12)
 		{
-			ENQUEUE_RENDER_COMMAND(SpoutSenderRenderThreadOp)([this](FRHICommandListImmediate& RHICmdList) {
-				this->D3D11on12Device->AcquireWrappedResources(&WrappedDX11Resource, 1);
-				this->deviceContext->CopyResource(sendingTexture, WrappedDX11Resource);
-				this->D3D11on12Device->ReleaseWrappedResources(&WrappedDX11Resource, 1);
-				this->deviceContext->Flush();
-
-				verify(this->senders.UpdateSender(TCHAR_TO_ANSI(*this->Name.ToString()),
-					this->width, this->height,
-					this->sharedSendingHandle));
+			FRHICommandListImmediate* RHICmdList = Batch.GetRHICmdList();
+			if (!RHICmdList)
+				return;
+
+			const int32 Slot = BeginWrite();
+			if (Slot == INDEX_NONE)
+				return;
+
+			FRHITexture* Dst = Slots[Slot].NativeRHI;
+
+			RHICmdList->Transition({
+				FRHITransitionInfo(Texture, ERHIAccess::Unknown, ERHIAccess::CopySrc),
+				FRHITransitionInfo(Dst, ERHIAccess::Unknown, ERHIAccess::CopyDest)
 			});
+
+			FRHICopyTextureInfo CopyInfo{};
+			RHICmdList->CopyTexture(Texture, Dst, CopyInfo);
+
+			// Present is D3D12's COMMON state, which is what other APIs and processes expect to open.
+			RHICmdList->Transition({
+				FRHITransitionInfo(Texture, ERHIAccess::CopySrc, ERHIAccess::SRVMask),
+				FRHITransitionInfo(Dst, ERHIAccess::CopyDest, ERHIAccess::Present)
+			});
+
+			// Goes out with the RHI's own submission: no 11on12 hop and no extra flush.
+			FrameSync->Signal(EndWrite(Slot));
+		}
+		else if (Path == ESpoutSharePath::D3D11On12)
+		{
+			const int32 Slot = BeginWrite();
+			if (Slot == INDEX_NONE)
+				return;
+
+			// Recorded at the batch's submit together with every other stream's wrapped copies,
+			// so the resource transitions and the flush happen once per frame.
+			InteropDevice->QueueCopy(Slots[Slot].Texture, WrappedDX11Resource, WrappedDX11Resource, FrameSync.Get(), EndWrite(Slot));
+			Batch.RequestSubmit(InteropDevice.Get());
+		}
+	}
+
+	virtual void PostSubmit_RenderThread(FSpoutFrameBatch& Batch) override
+	{
+		if (FrameSync)
+			RetireCompleted();
+
+		// Reads the source rather than a shared slot, so it does not depend on the share path.
+		FRHICommandListImmediate* RHICmdList = Batch.GetRHICmdList();
+		if (Readback.IsValid() && RHICmdList)
+			Readback->Process_RenderThread(*RHICmdList, bSentThisBatch ? Texture : nullptr);
+	}
+
+	/** Claims a slot to copy into; a frame that finds every slot busy counts as skipped. */
+	int32 BeginWrite()
+	{
+		const int32 Slot = Ring.BeginWrite();
+		if (Slot == INDEX_NONE)
+			Counters->FramesSkipped.fetch_add(1, std::memory_order_relaxed);
+		return Slot;
+	}
+
+	/** Numbers the frame of the queued copy; the caller signals it and it is published once the GPU is done with it. */
+	uint64 EndWrite(int32 Slot)
+	{
+		const uint64 Frame = ++FrameCounter;
+		Ring.EndWrite(Slot, Frame);
+
+		Counters->FramesSent.fetch_add(1, std::memory_order_relaxed);
+		return Frame;
+	}
+
+	/** Publishes the newest slot whose copy the GPU has finished. */
+	void RetireCompleted()
+	{
+		const int32 Slot = Ring.Retire(FrameSync->GetCompletedFrame());
+		if (Slot != INDEX_NONE)
+			Publish(Slot);
+	}
+
+	/**
+	 * Advertises the slot as the latest complete frame, first through the lock-free record, then
+	 * through the SDK's mutex-guarded SharedTextureInfo for other receivers. The legacy fields
+	 * point at the slot directly.
+	 */
+	void Publish(int32 Slot)
+	{
+		if (Record.IsValid())
+		{
+			FSpoutSenderRecord Desc;
+			Desc.FrameNumber = Ring.GetSlotFrame(Slot);
+			Desc.ShareHandle = SpoutSharedInfo::HandleToUint32(Slots[Slot].Handle);
+			Desc.Width = width;
+			Desc.Height = height;
+			Desc.Format = texFormat;
+			Desc.NumSlots = Ring.Num();
+			Desc.PublishedSlot = Slot;
+			for (int32 i = 0; i < Ring.Num(); ++i)
+				Desc.SlotHandles[i] = SpoutSharedInfo::HandleToUint32(Slots[i].Handle);
+			Record->Publish(Desc);
 		}
+
+		SharedTextureInfo Info = {};
+		Info.shareHandle = SpoutSharedInfo::HandleToUint32(Slots[Slot].Handle);
+		Info.width = width;
+		Info.height = height;
+		Info.format = texFormat;
+
+		FSpoutSenderInfoExt Ext;
+		Ext.NumSlots = Ring.Num();
+		Ext.PublishedSlot = Slot;
+		Ext.FrameNumber = static_cast<uint32>(Ring.GetSlotFrame(Slot));
+		for (int32 i = 0; i < Ring.Num(); ++i)
+			Ext.SlotHandles[i] = SpoutSharedInfo::HandleToUint32(Slots[i].Handle);
+		SpoutSharedInfo::WriteExt(Info, Ext);
+
+		verify(senders.setSharedInfo(Name_str.c_str(), &Info));
+
+		// Last, so a woken receiver finds both the record and the legacy info current.
+		if (FrameSignal.IsValid())
+			FrameSignal->Notify();
 	}
 
+	/** Texture holding the latest complete frame, or the first slot before anything was published. */
+	ID3D11Texture2D* GetPublishedTexture() const
+	{
+		const int32 Slot = Ring.GetPublishedSlot();
+		return Slots[Slot == INDEX_NONE ? 0 : Slot].Texture;
+	}
+
+	/** GetPublishedTexture's slot as an RHI texture. */
+	FTextureRHIRef GetPublishedRHI() const
+	{
+		const int32 Slot = Ring.GetPublishedSlot();
+		return SlotRHIs[Slot == INDEX_NONE ? 0 : Slot];
+	}
+
+	int32 GetNumBuffers() const { return Ring.Num(); }
+	FRHITexture* GetSourceTexture() const { return Texture; }
+	ESpoutSyncMode GetRequestedSyncMode() const { return RequestedSyncMode; }
+	bool GetPreferNativeD3D12() const { return bPreferNativeD3D12; }
+
 	const FName& GetName() const { return Name; }
 
 };
@@ -206,11 +490,106 @@ struct USpoutSenderActorComponent::SpoutSenderContext
 ///////////////////////////////////////////////////////////////////////////////
 
 USpoutSenderActorComponent::USpoutSenderActorComponent()
+	: counters(MakeShared<SpoutSenderCounters, ESPMode::ThreadSafe>())
 {
 	PrimaryComponentTick.bCanEverTick = true;
 	bTickInEditor = true;
 }
 
+void USpoutSenderActorComponent::MarkDirty()
+{
+	bDirty = true;
+}
+
+int64 USpoutSenderActorComponent::GetFramesSent() const
+{
+	return counters->FramesSent.load(std::memory_order_relaxed);
+}
+
+int64 USpoutSenderActorComponent::GetFramesSkipped() const
+{
+	return counters->FramesSkipped.load(std::memory_order_relaxed);
+}
+
+int32 USpoutSenderActorComponent::GetConsumerCount() const
+{
+	if (!ConsumerTable.IsValid() || ConsumerTableName != PublishName)
+	{
+		ConsumerTable.Reset();
+		ConsumerTableName = PublishName;
+
+		if (TUniquePtr<FSpoutConsumerTable> Table = FSpoutConsumerTable::OpenOrCreate(TCHAR_TO_ANSI(*PublishName.ToString())))
+			ConsumerTable = MakeShareable(Table.Release());
+	}
+
+	return ConsumerTable.IsValid() ? ConsumerTable->CountLive(FSpoutConsumerTable::NowMs()) : 0;
+}
+
+bool USpoutSenderActorComponent::ShouldCaptureThisFrame()
+{
+	USpoutSubsystem* Subsystem = USpoutSubsystem::Get();
+	if (!Subsystem || Capture.IsEveryFrame())
+	{
+		UnregisterCapture();
+		return true;
+	}
+
+	if (CaptureHandle == INDEX_NONE)
+		CaptureHandle = Subsystem->RegisterCapture(Capture);
+	else if (Capture != RegisteredCapture)
+		Subsystem->UpdateCapture(CaptureHandle, Capture);
+
+	RegisteredCapture = Capture;
+	return Subsystem->ShouldCapture(CaptureHandle);
+}
+
+void USpoutSenderActorComponent::SetReadbackCallback(FSpoutReadbackCallback Callback)
+{
+	ReadbackCallback = MoveTemp(Callback);
+	if (Readback.IsValid())
+		Readback->SetCallback(ReadbackCallback);
+}
+
+bool USpoutSenderActorComponent::DequeueReadback(TSharedPtr<FSpoutReadbackFrame, ESPMode::ThreadSafe>& OutFrame)
+{
+	return Readback.IsValid() && Readback->Dequeue(OutFrame);
+}
+
+void USpoutSenderActorComponent::UnregisterCapture()
+{
+	if (CaptureHandle == INDEX_NONE)
+		return;
+
+	if (USpoutSubsystem* Subsystem = USpoutSubsystem::Get())
+		Subsystem->UnregisterCapture(CaptureHandle);
+
+	CaptureHandle = INDEX_NONE;
+}
+
+void USpoutSenderActorComponent::UpdateMemoryShare()
+{
+	if (MemoryShare.IsValid() && (!bMemoryShare || MemoryShareName != PublishName))
+	{
+		// The writer marks the stream as ended once the render thread lets go of it too.
+		MemoryShare.Reset();
+		MemoryShareName = NAME_None;
+	}
+
+	if (bMemoryShare && !MemoryShare.IsValid() && !PublishName.IsNone())
+	{
+		// Shared with every sender of the name in this process: the control block takes one writer.
+		MemoryShare = FSpoutSenderRegistry::Get().AcquireMemoryShare(TCHAR_TO_ANSI(*PublishName.ToString()));
+		if (MemoryShare.IsValid())
+			MemoryShareName = PublishName;
+	}
+
+	if (Readback.IsValid())
+	{
+		Readback->SetMemoryShare(MemoryShare);
+		Readback->SetDeliverFrames(bEnableReadback);
+	}
+}
+
 void USpoutSenderActorComponent::BeginPlay()
 {
 	Super::BeginPlay();
@@ -222,9 +601,21 @@ void USpoutSenderActorComponent::EndPlay(const EEndPlayReason::Type EndPlayReaso
 {
 	context.Reset();
 
+	if (Readback.IsValid())
+		Readback->SetMemoryShare(nullptr);
+	MemoryShare.Reset();
+	MemoryShareName = NAME_None;
+
 	Super::EndPlay(EndPlayReason);
 }
 
+void USpoutSenderActorComponent::OnUnregister()
+{
+	UnregisterCapture();
+
+	Super::OnUnregister();
+}
+
 void USpoutSenderActorComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
@@ -247,68 +638,78 @@ void USpoutSenderActorComponent::TickComponent(float DeltaTime, ELevelTick TickT
 
 	if (!context.IsValid())
 	{
-		context = TSharedPtr<SpoutSenderContext>(new SpoutSenderContext(PublishName, Texture));
+		context = TSharedPtr<SpoutSenderContext>(new SpoutSenderContext(PublishName, Texture, NumBuffers, SyncMode, bPreferNativeD3D12, counters.ToSharedRef()));
+
+		// A new context has nothing published yet.
+		bDirty = true;
+		bReadbackBound = false;
 	}
-	else if (PublishName != context->GetName())
+	else if (PublishName != context->GetName()
+		|| FMath::Clamp(NumBuffers, FSpoutTextureRing::MinSlots, FSpoutTextureRing::MaxSlots) != context->GetNumBuffers()
+		|| SyncMode != context->GetRequestedSyncMode()
+		|| bPreferNativeD3D12 != context->GetPreferNativeD3D12()
+		|| Texture != context->GetSourceTexture())
 	{
 		context.Reset();
 		return;
 	}
 
-	context->Tick();
+	if (FSpoutReadback::Sync(Readback, bEnableReadback || bMemoryShare, NumReadbackBuffers, ReadbackLatency, bReadbackToRGBA8, ReadbackCallback))
+		bReadbackBound = false;
+
+	UpdateMemoryShare();
+
+	if (!bReadbackBound)
+	{
+		SpoutSenderContext::SetReadback(context.ToSharedRef(), Readback);
+		bReadbackBound = true;
+	}
+
+	// Nobody watching: keep the sender registered but copy nothing. The first frame after
+	// a receiver shows up is always sent.
+	if (bOnlySendWhenConsumed && GetConsumerCount() == 0)
+	{
+		counters->FramesSkipped.fetch_add(1, std::memory_order_relaxed);
+		bDirty = true;
+	}
+	// Off-schedule frames keep bDirty for the next scheduled one. Either way the stream is
+	// still queued, so copies and readbacks in flight get retired.
+	else if (ShouldCaptureThisFrame() && (!bOnlySendWhenDirty || bDirty))
+	{
+		context->bCopyRequested = true;
+		bDirty = false;
+	}
+	else
+	{
+		counters->FramesSkipped.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	if (USpoutSubsystem* Subsystem = USpoutSubsystem::Get())
+	{
+		Subsystem->QueueStream(context.ToSharedRef());
+	}
 }
 
 // --- Spout integration helpers ------------------------------------------------
 ID3D11Texture2D* USpoutSenderActorComponent::GetSharedDX11Texture() const
 {
-    // If we cached the pointer earlier and the context is still valid, just reuse it
-    if (CachedDX11 && context.IsValid())
-    {
-        return CachedDX11;
-    }
-
-    // We only have the texture once the sender context is up and running
-    if (!context.IsValid())
-    {
-        return nullptr;
-    }
-
-    CachedDX11 = context->sendingTexture;   // public struct member, no extra copy needed
-    return CachedDX11;
+	check(IsInGameThread());
+
+	// We only have the texture once the sender context is up and running
+	if (!context.IsValid())
+		return nullptr;
+
+	// The ring rotates every frame, so always hand out the latest complete slot
+	return context->GetPublishedTexture();
 }
 
-FTextureRHIRef USpoutSenderActorComponent::GetSharedTextureRHI()
+FTextureRHIRef USpoutSenderActorComponent::GetSharedTextureRHI() const
 {
-    // Re-use the RHI texture once it has been created.
-    if (CachedRHI.IsValid())
-        return CachedRHI;
-
-    // Native DX11 texture supplied by Spout.
-    ID3D11Texture2D* Native = GetSharedDX11Texture();
-    if (!Native)
-        return nullptr;
-
-    // Query width/height/format so we can describe the UE resource.
-    D3D11_TEXTURE2D_DESC D;
-    Native->GetDesc(&D);
-
-    // Map DXGI format → UE pixel format (handle the two we actually use).
-    EPixelFormat Format = PF_B8G8R8A8;
-    if (D.Format == DXGI_FORMAT_R16G16B16A16_FLOAT)      Format = PF_FloatRGBA;
-    else if (D.Format == DXGI_FORMAT_R32G32B32A32_FLOAT) Format = PF_A32B32G32R32F;
-
-    // Build the FRHI texture description – EXTERNAL flag is critical.
-    const FRHITextureCreateDesc Desc =
-        FRHITextureCreateDesc::Create2D(TEXT("SpoutShared"))
-        .SetExtent(static_cast<int32>(D.Width), static_cast<int32>(D.Height))
-        .SetFormat(Format)
-        .SetNumMips(1)
-        .SetFlags(ETextureCreateFlags::ShaderResource | ETextureCreateFlags::External)
-        .SetInitialState(ERHIAccess::CopyDest)
-        // Store the native pointer in ExtData – this is UE 5.5's hook for external resources.
-        .SetExtData(static_cast<uint32>(reinterpret_cast<uint64>(Native)));
-
-    CachedRHI = RHICreateTexture(Desc);
-    return CachedRHI;
-}
+	check(IsInGameThread());
 
+	if (!context.IsValid())
+		return nullptr;
+
+	// Wrapped once per slot when the context was created.
+	return context->GetPublishedRHI();
+}
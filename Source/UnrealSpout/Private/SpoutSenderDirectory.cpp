@@ -0,0 +1,381 @@
+#include "SpoutSenderDirectory.h"
+
+#include "SpoutSharedAtomics.h"
+#include "SpoutSharedMemoryRegion.h"
+
+using namespace SpoutSharedAtomics;
+
+namespace
+{
+	using FSlot = FSpoutSenderDirectoryLayout::FSlot;
+	using ESlotTag = FSpoutSenderDirectoryLayout::ESlotTag;
+
+	/** Snapshot attempts before settling for a scan the directory changed under. */
+	constexpr int32 MaxSnapshotAttempts = 4;
+
+	uint64 LoadState(const FSlot& Slot)
+	{
+		return Load(Slot.State);
+	}
+
+	ESlotTag GetTag(uint64 State)
+	{
+		return static_cast<ESlotTag>(State & 3);
+	}
+
+	/** Next version of State, tagged Tag. */
+	uint64 Advance(uint64 State, ESlotTag Tag)
+	{
+		return (((State >> 2) + 1) << 2) | Tag;
+	}
+
+	bool CompareExchange(FSlot& Slot, uint64 Expected, uint64 Desired)
+	{
+		return FPlatformAtomics::InterlockedCompareExchange(AsAtomic(Slot.State), static_cast<int64>(Desired), static_cast<int64>(Expected)) == static_cast<int64>(Expected);
+	}
+}
+
+FSpoutSenderDirectory::FSpoutSenderDirectory(TUniquePtr<ISpoutSharedMemoryRegion> InRegion)
+	: Region(MoveTemp(InRegion))
+{
+	check(Region.IsValid() && Region->IsWritable() && Region->GetSize() >= sizeof(FSpoutSenderDirectoryLayout));
+
+	// Whoever maps a zero-filled region first stamps the header; slots are valid as zeros.
+	FSpoutSenderDirectoryLayout& Layout = GetLayout();
+	if (FPlatformAtomics::AtomicRead(AsAtomic(Layout.Magic)) == 0)
+	{
+		Layout.Version = FSpoutSenderDirectoryLayout::CurrentVersion;
+		Layout.SlotCount = FSpoutSenderDirectoryLayout::NumSlots;
+		FPlatformAtomics::InterlockedCompareExchange(AsAtomic(Layout.Magic), static_cast<int32>(FSpoutSenderDirectoryLayout::ExpectedMagic), 0);
+	}
+}
+
+FSpoutSenderDirectory::~FSpoutSenderDirectory() = default;
+
+TUniquePtr<FSpoutSenderDirectory> FSpoutSenderDirectory::OpenOrCreate(const ANSICHAR* RegionName)
+{
+	if (!RegionName || !RegionName[0])
+		return nullptr;
+
+	TUniquePtr<ISpoutSharedMemoryRegion> Region = SpoutSharedMemory::Create(RegionName, sizeof(FSpoutSenderDirectoryLayout));
+	if (!Region.IsValid())
+		return nullptr;
+
+	return MakeUnique<FSpoutSenderDirectory>(MoveTemp(Region));
+}
+
+FSpoutSenderDirectory* FSpoutSenderDirectory::Get()
+{
+	static TUniquePtr<FSpoutSenderDirectory> Instance = OpenOrCreate();
+	return Instance.Get();
+}
+
+FSpoutSenderDirectoryLayout& FSpoutSenderDirectory::GetLayout() const
+{
+	return *reinterpret_cast<FSpoutSenderDirectoryLayout*>(Region->GetData());
+}
+
+uint64 FSpoutSenderDirectory::HashName(const ANSICHAR* Name)
+{
+	// FNV-1a: the table spreads it with a mask, so the low bits must be well mixed.
+	uint64 Hash = 0xcbf29ce484222325ull;
+	for (const ANSICHAR* Char = Name; *Char; ++Char)
+	{
+		Hash ^= static_cast<uint8>(*Char);
+		Hash *= 0x100000001b3ull;
+	}
+	return Hash;
+}
+
+bool FSpoutSenderDirectory::Matches(const FSlot& Slot, uint64 State, uint64 Hash, const ANSICHAR* Name) const
+{
+	if (Load(Slot.NameHash) != Hash)
+		return false;
+
+	const bool bSameName = FCStringAnsi::Strncmp(Slot.Name, Name, FSpoutSenderDirectoryLayout::MaxNameLength) == 0;
+
+	// The name must have been read before the slot could be reused.
+	FPlatformMisc::MemoryBarrier();
+	return bSameName && LoadState(Slot) == State;
+}
+
+int32 FSpoutSenderDirectory::FindLive(const ANSICHAR* Name, uint64 Hash, uint64& OutState) const
+{
+	const FSpoutSenderDirectoryLayout& Layout = GetLayout();
+	const uint32 Mask = FSpoutSenderDirectoryLayout::NumSlots - 1;
+
+	for (uint32 Probe = 0; Probe < FSpoutSenderDirectoryLayout::NumSlots; ++Probe)
+	{
+		const int32 Index = static_cast<int32>((Hash + Probe) & Mask);
+		const FSlot& Slot = Layout.Slots[Index];
+		const uint64 State = LoadState(Slot);
+
+		const ESlotTag Tag = GetTag(State);
+		if (Tag == ESlotTag::Empty)
+			return INDEX_NONE;
+
+		if (Tag == ESlotTag::Live && Matches(Slot, State, Hash, Name))
+		{
+			OutState = State;
+			return Index;
+		}
+	}
+	return INDEX_NONE;
+}
+
+int32 FSpoutSenderDirectory::Register(const ANSICHAR* Name, int64 OwnerId, int64 Now, int64 TimeoutMs)
+{
+	check(OwnerId != 0);
+	if (!Name || !Name[0] || FCStringAnsi::Strlen(Name) >= FSpoutSenderDirectoryLayout::MaxNameLength)
+		return INDEX_NONE;
+
+	FSpoutSenderDirectoryLayout& Layout = GetLayout();
+	const uint64 Hash = HashName(Name);
+	const uint32 Mask = FSpoutSenderDirectoryLayout::NumSlots - 1;
+
+	for (;;)
+	{
+		// Walk the whole chain first: the name may already sit past a tombstone we could reuse.
+		int32 Free = INDEX_NONE;
+		uint64 FreeState = 0;
+		bool bReclaimed = false;
+		for (uint32 Probe = 0; Probe < FSpoutSenderDirectoryLayout::NumSlots; ++Probe)
+		{
+			const int32 Index = static_cast<int32>((Hash + Probe) & Mask);
+			FSlot& Slot = Layout.Slots[Index];
+			const uint64 State = LoadState(Slot);
+
+			const ESlotTag Tag = GetTag(State);
+			if (Tag == ESlotTag::Live && Matches(Slot, State, Hash, Name))
+			{
+				if (FPlatformAtomics::AtomicRead(&Slot.OwnerId) == OwnerId)
+					return Index;
+
+				if (Now - FPlatformAtomics::AtomicRead(&Slot.HeartbeatMs) <= TimeoutMs)
+					return INDEX_NONE;
+
+				// Left behind by a dead process: take the name over.
+				Remove(Index, State);
+				bReclaimed = true;
+				break;
+			}
+
+			if ((Tag == ESlotTag::Empty || Tag == ESlotTag::Removed) && Free == INDEX_NONE)
+			{
+				Free = Index;
+				FreeState = State;
+			}
+
+			if (Tag == ESlotTag::Empty)
+				break;
+		}
+
+		if (bReclaimed)
+			continue;
+
+		if (Free == INDEX_NONE)
+			return INDEX_NONE;
+
+		FSlot& Slot = Layout.Slots[Free];
+		const uint64 Claimed = Advance(FreeState, ESlotTag::Claimed);
+		if (!CompareExchange(Slot, FreeState, Claimed))
+			continue; // Someone else took it; look again.
+
+		// A slot we walked past while it was live may have been removed and emptied since,
+		// cutting Free off from the chain. ClearTombstones checks the other way round, so one
+		// of us sees the other; give the slot back as it was and look again.
+		if (!IsOnChain(Hash, Free))
+		{
+			CompareExchange(Slot, Claimed, Advance(Claimed, GetTag(FreeState)));
+			continue;
+		}
+
+		FPlatformAtomics::AtomicStore(&Slot.OwnerId, OwnerId);
+		FPlatformAtomics::AtomicStore(&Slot.HeartbeatMs, Now);
+		Store(Slot.NameHash, Hash);
+		FCStringAnsi::Strncpy(Slot.Name, Name, FSpoutSenderDirectoryLayout::MaxNameLength);
+
+		// Sequentially consistent: the entry is visible before the slot turns live. Fails if
+		// ReclaimStale took the claim for a dead one, seeing the previous owner's heartbeat.
+		if (!CompareExchange(Slot, Claimed, Advance(Claimed, ESlotTag::Live)))
+			continue;
+		FPlatformAtomics::InterlockedIncrement(&Layout.Count);
+		FPlatformAtomics::InterlockedIncrement(AsAtomic(Layout.Generation));
+		return Free;
+	}
+}
+
+bool FSpoutSenderDirectory::Remove(int32 Index, uint64 State)
+{
+	FSpoutSenderDirectoryLayout& Layout = GetLayout();
+
+	// Left as a tombstone, not emptied, so chains through it stay intact.
+	if (!CompareExchange(Layout.Slots[Index], State, Advance(State, ESlotTag::Removed)))
+		return false;
+
+	FPlatformAtomics::InterlockedDecrement(&Layout.Count);
+	FPlatformAtomics::InterlockedIncrement(AsAtomic(Layout.Generation));
+
+	ClearTombstones(Index);
+	return true;
+}
+
+void FSpoutSenderDirectory::ClearTombstones(int32 Index)
+{
+	FSpoutSenderDirectoryLayout& Layout = GetLayout();
+	const uint32 Mask = FSpoutSenderDirectoryLayout::NumSlots - 1;
+
+	// Every chain through a run of tombstones followed by an empty slot ends there, so the run
+	// can go back to empty, last slot first.
+	for (int32 Step = 0; Step < FSpoutSenderDirectoryLayout::NumSlots; ++Step)
+	{
+		const int32 Current = static_cast<int32>((Index - Step) & Mask);
+		const FSlot& Next = Layout.Slots[(Current + 1) & Mask];
+		if (GetTag(LoadState(Next)) != ESlotTag::Empty)
+			return;
+
+		FSlot& Slot = Layout.Slots[Current];
+		const uint64 State = LoadState(Slot);
+		if (GetTag(State) != ESlotTag::Removed)
+			return;
+
+		const uint64 Emptied = Advance(State, ESlotTag::Empty);
+		if (!CompareExchange(Slot, State, Emptied))
+			return;
+
+		// Register may have claimed the next slot meanwhile, having probed past this one while
+		// it was live. Either it sees this slot empty and backs off, or we see its claim here.
+		if (GetTag(LoadState(Next)) != ESlotTag::Empty)
+		{
+			CompareExchange(Slot, Emptied, Advance(Emptied, ESlotTag::Removed));
+			return;
+		}
+	}
+}
+
+bool FSpoutSenderDirectory::IsOnChain(uint64 Hash, int32 Index) const
+{
+	const FSpoutSenderDirectoryLayout& Layout = GetLayout();
+	const uint32 Mask = FSpoutSenderDirectoryLayout::NumSlots - 1;
+
+	for (uint32 Probe = 0; Probe < FSpoutSenderDirectoryLayout::NumSlots; ++Probe)
+	{
+		const int32 Current = static_cast<int32>((Hash + Probe) & Mask);
+		if (Current == Index)
+			return true;
+		if (GetTag(LoadState(Layout.Slots[Current])) == ESlotTag::Empty)
+			return false;
+	}
+	return false;
+}
+
+bool FSpoutSenderDirectory::Unregister(const ANSICHAR* Name, int64 OwnerId)
+{
+	if (!Name || !Name[0])
+		return false;
+
+	uint64 State = 0;
+	const int32 Index = FindLive(Name, HashName(Name), State);
+	if (Index == INDEX_NONE || FPlatformAtomics::AtomicRead(&GetLayout().Slots[Index].OwnerId) != OwnerId)
+		return false;
+
+	return Remove(Index, State);
+}
+
+bool FSpoutSenderDirectory::Heartbeat(int32 Index, int64 OwnerId, int64 Now)
+{
+	if (Index < 0 || Index >= FSpoutSenderDirectoryLayout::NumSlots)
+		return false;
+
+	FSlot& Slot = GetLayout().Slots[Index];
+	const uint64 State = LoadState(Slot);
+	if (GetTag(State) != ESlotTag::Live || FPlatformAtomics::AtomicRead(&Slot.OwnerId) != OwnerId)
+		return false;
+
+	FPlatformAtomics::AtomicStore(&Slot.HeartbeatMs, Now);
+
+	// Reclaimed in between: the stray heartbeat only delays the new entry's own timeout.
+	return LoadState(Slot) == State;
+}
+
+int32 FSpoutSenderDirectory::ReclaimStale(int64 Now, int64 TimeoutMs)
+{
+	FSpoutSenderDirectoryLayout& Layout = GetLayout();
+
+	int32 Reclaimed = 0;
+	for (int32 Index = 0; Index < FSpoutSenderDirectoryLayout::NumSlots; ++Index)
+	{
+		FSlot& Slot = Layout.Slots[Index];
+		const uint64 State = LoadState(Slot);
+		const ESlotTag Tag = GetTag(State);
+		if (Tag != ESlotTag::Live && Tag != ESlotTag::Claimed)
+			continue;
+
+		if (Now - FPlatformAtomics::AtomicRead(&Slot.HeartbeatMs) <= TimeoutMs)
+			continue;
+
+		if (Tag == ESlotTag::Live)
+		{
+			if (Remove(Index, State))
+				++Reclaimed;
+		}
+		// A writer that died while filling the slot in. It never counted as an entry; a
+		// tombstone keeps any chain through it intact.
+		else if (CompareExchange(Slot, State, Advance(State, ESlotTag::Removed)))
+		{
+			ClearTombstones(Index);
+			++Reclaimed;
+		}
+	}
+	return Reclaimed;
+}
+
+int32 FSpoutSenderDirectory::Find(const ANSICHAR* Name) const
+{
+	if (!Name || !Name[0])
+		return INDEX_NONE;
+
+	uint64 State = 0;
+	return FindLive(Name, HashName(Name), State);
+}
+
+uint64 FSpoutSenderDirectory::GetGeneration() const
+{
+	return Load(GetLayout().Generation);
+}
+
+int32 FSpoutSenderDirectory::Num() const
+{
+	return FPlatformAtomics::AtomicRead(&GetLayout().Count);
+}
+
+FSpoutSenderDirectory::FSnapshot FSpoutSenderDirectory::TakeSnapshot() const
+{
+	const FSpoutSenderDirectoryLayout& Layout = GetLayout();
+
+	FSnapshot Snapshot;
+	ANSICHAR Name[FSpoutSenderDirectoryLayout::MaxNameLength];
+	for (int32 Attempt = 0; Attempt < MaxSnapshotAttempts; ++Attempt)
+	{
+		Snapshot.Generation = GetGeneration();
+		Snapshot.Names.Reset();
+
+		for (const FSlot& Slot : Layout.Slots)
+		{
+			const uint64 State = LoadState(Slot);
+			if (GetTag(State) != ESlotTag::Live)
+				continue;
+
+			FMemory::Memcpy(Name, Slot.Name, sizeof(Name));
+			Name[UE_ARRAY_COUNT(Name) - 1] = '\0';
+
+			FPlatformMisc::MemoryBarrier();
+			if (LoadState(Slot) == State)
+				Snapshot.Names.Emplace(ANSI_TO_TCHAR(Name));
+		}
+
+		if (GetGeneration() == Snapshot.Generation)
+			break;
+	}
+	return Snapshot;
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ISpoutSharedMemoryRegion;
+
+/** Shared-memory layout of the sender directory. Plain data, no Windows types. */
+struct FSpoutSenderDirectoryLayout
+{
+	static constexpr uint32 ExpectedMagic = 0x52445355; // 'USDR'
+	static constexpr uint32 CurrentVersion = 1;
+	/** Power of two, twice the senders a large stage runs, so probe chains stay short. */
+	static constexpr int32 NumSlots = 2048;
+	/** Same as the SDK's SpoutMaxSenderNameLen, terminator included. */
+	static constexpr int32 MaxNameLength = 256;
+
+	/** Low two bits of FSlot::State. */
+	enum ESlotTag : uint64
+	{
+		Empty = 0,
+		/** A writer owns the slot and is filling it in. Reclaimed like a dead entry if the writer never finishes. */
+		Claimed = 1,
+		Live = 2,
+		/** Tombstone: probing continues past it and registering may reuse it. */
+		Removed = 3,
+	};
+
+	struct FSlot
+	{
+		/** ESlotTag in the low bits, bumped version above; changes on every transition. Claimed with compare-exchange. */
+		uint64 State;
+		uint64 NameHash;
+		/** Process that registered the entry. */
+		int64 OwnerId;
+		/** Owner's last heartbeat, in FSpoutConsumerTable::NowMs() time. */
+		int64 HeartbeatMs;
+		ANSICHAR Name[MaxNameLength];
+	};
+
+	uint32 Magic;
+	uint32 Version;
+	uint32 SlotCount;
+	/** Live entries. */
+	int32 Count;
+	/** Bumped after every register and unregister. */
+	uint64 Generation;
+	uint64 Reserved[5];
+	FSlot Slots[NumSlots];
+};
+
+static_assert(STRUCT_OFFSET(FSpoutSenderDirectoryLayout, Generation) % 8 == 0, "Directory generation must be 8-byte aligned for 64-bit atomics");
+static_assert(STRUCT_OFFSET(FSpoutSenderDirectoryLayout, Slots) % 64 == 0, "Directory slots should start on a cache line");
+static_assert(sizeof(FSpoutSenderDirectoryLayout::FSlot) % 8 == 0, "Directory slot states must be 8-byte aligned for 64-bit atomics");
+static_assert((FSpoutSenderDirectoryLayout::NumSlots & (FSpoutSenderDirectoryLayout::NumSlots - 1)) == 0, "Directory size must be a power of two");
+
+/**
+ * Machine-wide directory of this plugin's senders: an open-addressed hash table (linear
+ * probing, tombstones) in one shared region, so a lookup by name touches a few slots instead
+ * of rebuilding the SDK's whole sender set. A run of tombstones that ends at an empty slot is
+ * emptied again, so misses stay short however many senders come and go. A generation counter
+ * lets clients see whether anything changed without reading the table.
+ *
+ * Every entry belongs to the process that registered it, which refreshes its heartbeat;
+ * entries whose heartbeat is older than the timeout count as dead and anyone may reclaim
+ * them, which covers senders in processes that crashed.
+ *
+ * Lock-free: slots are claimed with 64-bit compare-exchange, and every slot state carries a
+ * version, so readers detect a slot that was reused under them and skip or retry it. The
+ * SDK's own sender list is still kept for other Spout applications.
+ *
+ * Works on any ISpoutSharedMemoryRegion, including the POSIX one.
+ */
+class FSpoutSenderDirectory
+{
+public:
+	/** Names in the directory at one generation. */
+	struct FSnapshot
+	{
+		uint64 Generation = 0;
+		TArray<FString> Names;
+
+		int32 Num() const { return Names.Num(); }
+		TArray<FString>::RangedForConstIteratorType begin() const { return Names.begin(); }
+		TArray<FString>::RangedForConstIteratorType end() const { return Names.end(); }
+	};
+
+	static constexpr const ANSICHAR* DefaultRegionName = "UnrealSpoutSenderDirectory";
+
+	/** Heartbeats older than this mark an entry as dead. Generous, so a loading hitch does not drop senders. */
+	static constexpr int64 DefaultTimeoutMs = 5000;
+
+	/** Region must hold a full FSpoutSenderDirectoryLayout and be writable. */
+	explicit FSpoutSenderDirectory(TUniquePtr<ISpoutSharedMemoryRegion> InRegion);
+	~FSpoutSenderDirectory();
+
+	/** Opens the directory, creating it if nobody has yet. Null on failure. */
+	static TUniquePtr<FSpoutSenderDirectory> OpenOrCreate(const ANSICHAR* RegionName = DefaultRegionName);
+
+	/** The process's view of the default directory, opened on first use. Null if shared memory is unavailable. Any thread. */
+	static FSpoutSenderDirectory* Get();
+
+	/**
+	 * Adds Name for OwnerId (never 0), or finds OwnerId's entry if already there. A dead entry
+	 * under the name is reclaimed first. Returns the slot, or INDEX_NONE if the name is empty or
+	 * too long, the directory is full, or another live process owns the name. Two processes
+	 * registering the same name at the same moment may both get an entry; the SDK refuses the
+	 * second sender anyway.
+	 */
+	int32 Register(const ANSICHAR* Name, int64 OwnerId, int64 Now, int64 TimeoutMs = DefaultTimeoutMs);
+
+	/** Removes Name's entry if OwnerId owns it. False if it was not there. */
+	bool Unregister(const ANSICHAR* Name, int64 OwnerId);
+
+	/** Refreshes the entry. False if it was reclaimed meanwhile, in which case register again. */
+	bool Heartbeat(int32 Slot, int64 OwnerId, int64 Now);
+
+	/** Removes entries, and slots a writer claimed but never finished, whose heartbeat is older than TimeoutMs. Returns how many. */
+	int32 ReclaimStale(int64 Now, int64 TimeoutMs = DefaultTimeoutMs);
+
+	/** Name's slot, or INDEX_NONE. */
+	int32 Find(const ANSICHAR* Name) const;
+
+	/** Changes whenever an entry is added or removed. */
+	uint64 GetGeneration() const;
+
+	/** Live entries. */
+	int32 Num() const;
+
+	/** Every name, consistent with one generation unless the directory keeps changing. */
+	FSnapshot TakeSnapshot() const;
+
+	static uint64 HashName(const ANSICHAR* Name);
+
+private:
+	FSpoutSenderDirectoryLayout& GetLayout() const;
+
+	/** Marks the slot, live in State, as removed. False if it changed meanwhile. */
+	bool Remove(int32 Slot, uint64 State);
+
+	/** Empties the run of tombstones ending at Slot if an empty slot follows it. */
+	void ClearTombstones(int32 Slot);
+
+	/** Whether probing for Hash reaches Slot without passing an empty slot. */
+	bool IsOnChain(uint64 Hash, int32 Slot) const;
+
+	/** Whether Slot held Name while its state was State. */
+	bool Matches(const FSpoutSenderDirectoryLayout::FSlot& Slot, uint64 State, uint64 Hash, const ANSICHAR* Name) const;
+
+	/** Probes for Name; returns its slot and the state it was live in. */
+	int32 FindLive(const ANSICHAR* Name, uint64 Hash, uint64& OutState) const;
+
+	TUniquePtr<ISpoutSharedMemoryRegion> Region;
+};
@@ -0,0 +1,98 @@
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/OutputDevice.h"
+
+#include "SpoutConsumerTable.h"
+#include "SpoutSenderDirectory.h"
+#include "SpoutSharedMemoryRegion.h"
+
+#include <set>
+#include <string>
+
+#if !UE_BUILD_SHIPPING
+
+namespace
+{
+	constexpr int32 NameLength = FSpoutSenderDirectoryLayout::MaxNameLength;
+
+	/** The SDK's scheme: every lookup rebuilds the name set from a buffer of fixed-size names. */
+	bool FindInNameBuffer(const TArray<ANSICHAR>& Buffer, int32 Count, const ANSICHAR* Name)
+	{
+		std::set<std::string> Names;
+		for (int32 i = 0; i < Count; ++i)
+			Names.insert(&Buffer[i * NameLength]);
+		return Names.find(Name) != Names.end();
+	}
+
+	template <typename Fn>
+	double NanosecondsPerCall(int32 Calls, Fn&& Call)
+	{
+		const double Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Calls; ++i)
+			Call(i);
+		return (FPlatformTime::Seconds() - Start) * 1.0e9 / Calls;
+	}
+
+	void BenchmarkSenderDirectory(const TArray<FString>& Args, FOutputDevice& Ar)
+	{
+		const int32 Lookups = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100000;
+		const int32 Counts[] = { 10, 100, 1000 };
+
+		for (const int32 Count : Counts)
+		{
+			// A private directory per size, so earlier runs' tombstones do not skew later ones.
+			const FString RegionName = FString::Printf(TEXT("UnrealSpoutDirectoryBenchmark_%u_%d"), FPlatformProcess::GetCurrentProcessId(), Count);
+			TUniquePtr<FSpoutSenderDirectory> Directory = FSpoutSenderDirectory::OpenOrCreate(TCHAR_TO_ANSI(*RegionName));
+			if (!Directory.IsValid())
+			{
+				Ar.Log(TEXT("Spout sender directory: could not create the shared memory region."));
+				return;
+			}
+
+			TArray<FString> Names;
+			TArray<ANSICHAR> NameBuffer;
+			NameBuffer.SetNumZeroed(Count * NameLength);
+			for (int32 i = 0; i < Count; ++i)
+			{
+				Names.Add(FString::Printf(TEXT("Stage Camera %04d"), i));
+				FCStringAnsi::Strncpy(&NameBuffer[i * NameLength], TCHAR_TO_ANSI(*Names[i]), NameLength);
+			}
+
+			TArray<TArray<ANSICHAR>> AnsiNames;
+			for (const FString& Name : Names)
+			{
+				const auto Converted = StringCast<ANSICHAR>(*Name);
+				AnsiNames.Emplace(Converted.Get(), Converted.Length() + 1);
+			}
+
+			const int64 OwnerId = static_cast<int64>(FPlatformProcess::GetCurrentProcessId());
+			const int64 Now = FSpoutConsumerTable::NowMs();
+			const double RegisterNs = NanosecondsPerCall(Count, [&](int32 i) { Directory->Register(AnsiNames[i].GetData(), OwnerId, Now); });
+			const double HitNs = NanosecondsPerCall(Lookups, [&](int32 i) { Directory->Find(AnsiNames[i % Count].GetData()); });
+			const double MissNs = NanosecondsPerCall(Lookups, [&](int32) { Directory->Find("Not A Sender"); });
+			const double GenerationNs = NanosecondsPerCall(Lookups, [&](int32) { Directory->GetGeneration(); });
+
+			const int32 Snapshots = FMath::Max(1, Lookups / 100);
+			int32 Listed = 0;
+			const double SnapshotNs = NanosecondsPerCall(Snapshots, [&](int32) { Listed = Directory->TakeSnapshot().Num(); });
+
+			const int32 BaselineLookups = FMath::Max(1, Lookups / 100);
+			const double BaselineNs = NanosecondsPerCall(BaselineLookups, [&](int32 i) { FindInNameBuffer(NameBuffer, Count, AnsiNames[i % Count].GetData()); });
+
+			Ar.Logf(TEXT("  %4d senders  register %7.0f ns  find %6.0f ns  miss %6.0f ns  generation %4.1f ns  snapshot %8.0f ns (%d names)  set rebuild %9.0f ns"),
+				Count, RegisterNs, HitNs, MissNs, GenerationNs, SnapshotNs, Listed, BaselineNs);
+
+			Directory.Reset();
+			SpoutSharedMemory::Remove(TCHAR_TO_ANSI(*RegionName));
+		}
+	}
+
+	FAutoConsoleCommandWithArgsAndOutputDevice BenchmarkSenderDirectoryCommand(
+		TEXT("Spout.BenchmarkSenderDirectory"),
+		TEXT("Registers 10, 100 and 1000 senders in a private Spout sender directory and times lookups, snapshots and the generation check against rebuilding the SDK's sender set. Optional argument: lookups per size (default 100000)."),
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&BenchmarkSenderDirectory));
+}
+
+#endif
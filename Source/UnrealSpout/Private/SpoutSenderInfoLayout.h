@@ -0,0 +1,65 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "SpoutTextureRing.h"
+
+/**
+ * Portable mirror of the Spout SDK's SharedTextureInfo, the record every sender keeps
+ * in a named shared-memory block. Lets code that only reads the record work without
+ * the Windows headers (and against a POSIX stand-in).
+ */
+struct FSpoutSharedTextureInfoLayout
+{
+	uint32 ShareHandle;
+	uint32 Width;
+	uint32 Height;
+	uint32 Format;
+	uint32 Usage;
+	uint16 Description[128];
+	uint32 PartnerId;
+};
+
+/**
+ * Extra sender state carried in the unused SharedTextureInfo::description field.
+ * Legacy receivers only look at shareHandle/width/height/format, which always
+ * describe the latest complete slot, so they keep working unchanged.
+ */
+struct FSpoutSenderInfoExt
+{
+	static constexpr uint32 ExpectedMagic = 0x54505355; // 'USPT'
+	static constexpr uint32 CurrentVersion = 2;
+
+	uint32 Magic = ExpectedMagic;
+	uint32 Version = CurrentVersion;
+	uint32 NumSlots = 0;
+	uint32 PublishedSlot = 0;
+	uint32 SlotHandles[FSpoutTextureRing::MaxSlots] = {};
+
+	/**
+	 * Version 2: sender frame number of the published slot, bumped only when a new frame
+	 * is published. 32 bits and 4-byte aligned in the record, so it can be read without
+	 * taking the sender's mutex.
+	 */
+	uint32 FrameNumber = 0;
+};
+
+static_assert(sizeof(FSpoutSenderInfoExt) <= sizeof(FSpoutSharedTextureInfoLayout::Description), "Spout sender extension must fit in SharedTextureInfo::description");
+
+namespace SpoutSenderInfoLayout
+{
+	/** Byte offset of FSpoutSenderInfoExt::FrameNumber inside the shared record. */
+	constexpr SIZE_T FrameNumberOffset = STRUCT_OFFSET(FSpoutSharedTextureInfoLayout, Description) + STRUCT_OFFSET(FSpoutSenderInfoExt, FrameNumber);
+
+	static_assert(FrameNumberOffset % sizeof(uint32) == 0, "FrameNumber must stay naturally aligned for lock-free reads");
+
+	/** Returns false if the record was written by a sender that does not know about the extension. */
+	inline bool ReadExt(const FSpoutSharedTextureInfoLayout& Info, FSpoutSenderInfoExt& OutExt)
+	{
+		FMemory::Memcpy(&OutExt, Info.Description, sizeof(OutExt));
+		return OutExt.Magic == FSpoutSenderInfoExt::ExpectedMagic
+			&& OutExt.Version >= 1
+			&& OutExt.NumSlots <= FSpoutTextureRing::MaxSlots
+			&& OutExt.PublishedSlot < OutExt.NumSlots;
+	}
+}
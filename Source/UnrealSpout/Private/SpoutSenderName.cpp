@@ -0,0 +1,23 @@
+#include "SpoutSenderName.h"
+
+bool SpoutSenderName::Update(FName Name, FName& Cached, TArray<ANSICHAR>& Buffer)
+{
+	const bool bChanged = Name != Cached || Buffer.Num() != MaxLength;
+	if (bChanged)
+	{
+		Buffer.SetNumZeroed(MaxLength);
+		Cached = Name;
+
+		if (!Name.IsNone())
+		{
+			TCHAR Wide[MaxLength];
+			Name.ToString(Wide, MaxLength);
+			FCStringAnsi::Strncpy(Buffer.GetData(), StringCast<ANSICHAR>(Wide).Get(), MaxLength);
+		}
+	}
+
+	if (Name.IsNone())
+		Buffer[0] = '\0';
+
+	return bChanged;
+}
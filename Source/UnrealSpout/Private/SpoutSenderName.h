@@ -0,0 +1,18 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace SpoutSenderName
+{
+	/** Same as the SDK's SpoutMaxSenderNameLen, terminator included. */
+	constexpr int32 MaxLength = 256;
+
+	/**
+	 * Keeps Buffer holding Name as the ANSI string the Spout SDK takes, converting only when
+	 * Name differs from Cached, so polling a sender every tick builds no strings. Buffer is
+	 * kept MaxLength long because FindSender writes the active sender's name into it when
+	 * given an empty one; for None it is cleared on every call, so that stays whichever
+	 * sender is active rather than the one found last. Returns true if the name changed.
+	 */
+	bool Update(FName Name, FName& Cached, TArray<ANSICHAR>& Buffer);
+}
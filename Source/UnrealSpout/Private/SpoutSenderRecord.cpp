@@ -0,0 +1,172 @@
+#include "SpoutSenderRecord.h"
+
+#include "SpoutSharedAtomics.h"
+#include "SpoutSharedMemoryRegion.h"
+
+using namespace SpoutSharedAtomics;
+
+/* ---------------------------------------------------------------- Writer */
+
+FSpoutSenderRecordWriter::FSpoutSenderRecordWriter(TUniquePtr<ISpoutSharedMemoryRegion> InRegion)
+	: Region(MoveTemp(InRegion))
+{
+	check(Region.IsValid() && Region->IsWritable() && Region->GetSize() >= sizeof(FSpoutSenderRecordLayout));
+
+	FSpoutSenderRecordLayout& Layout = GetLayout();
+	if (Load(Layout.Magic) != FSpoutSenderRecordLayout::ExpectedMagic)
+	{
+		Layout.Version = FSpoutSenderRecordLayout::CurrentVersion;
+		Store(Layout.Magic, FSpoutSenderRecordLayout::ExpectedMagic);
+	}
+
+	// Taking over from an earlier sender of the same name: keep the sequence going, and
+	// close it if that sender died mid-publish.
+	Sequence = Load(Layout.Sequence);
+	if (Sequence & 1)
+		Store(Layout.Sequence, ++Sequence);
+}
+
+FSpoutSenderRecordWriter::~FSpoutSenderRecordWriter() = default;
+
+TUniquePtr<FSpoutSenderRecordWriter> FSpoutSenderRecordWriter::Create(const ANSICHAR* SenderName)
+{
+	if (!SenderName || !SenderName[0])
+		return nullptr;
+
+	const FString RegionName = GetRegionName(SenderName);
+	TUniquePtr<ISpoutSharedMemoryRegion> Region = SpoutSharedMemory::Create(TCHAR_TO_ANSI(*RegionName), sizeof(FSpoutSenderRecordLayout));
+	if (!Region.IsValid())
+		return nullptr;
+
+	return MakeUnique<FSpoutSenderRecordWriter>(MoveTemp(Region));
+}
+
+FString FSpoutSenderRecordWriter::GetRegionName(const ANSICHAR* SenderName)
+{
+	return FString(ANSI_TO_TCHAR(SenderName)) + TEXT("_record");
+}
+
+FSpoutSenderRecordLayout& FSpoutSenderRecordWriter::GetLayout() const
+{
+	return *reinterpret_cast<FSpoutSenderRecordLayout*>(Region->GetData());
+}
+
+void FSpoutSenderRecordWriter::BeginWrite()
+{
+	// Sequentially consistent stores: the odd sequence is visible before any field.
+	Store(GetLayout().Sequence, ++Sequence);
+}
+
+void FSpoutSenderRecordWriter::EndWrite()
+{
+	Store(GetLayout().Sequence, ++Sequence);
+}
+
+void FSpoutSenderRecordWriter::Publish(const FSpoutSenderRecord& Record)
+{
+	FSpoutSenderRecordLayout& Layout = GetLayout();
+
+	BeginWrite();
+	Store(Layout.FrameNumber, Record.FrameNumber);
+	Store(Layout.Active, 1);
+	Store(Layout.ShareHandle, Record.ShareHandle);
+	Store(Layout.Width, Record.Width);
+	Store(Layout.Height, Record.Height);
+	Store(Layout.Format, Record.Format);
+	Store(Layout.NumSlots, FMath::Min<uint32>(Record.NumSlots, FSpoutTextureRing::MaxSlots));
+	Store(Layout.PublishedSlot, Record.PublishedSlot);
+	for (int32 i = 0; i < FSpoutTextureRing::MaxSlots; ++i)
+		Store(Layout.SlotHandles[i], Record.SlotHandles[i]);
+	EndWrite();
+}
+
+void FSpoutSenderRecordWriter::Close()
+{
+	BeginWrite();
+	Store(GetLayout().Active, 0);
+	EndWrite();
+}
+
+/* ---------------------------------------------------------------- Reader */
+
+FSpoutSenderRecordReader::FSpoutSenderRecordReader(TUniquePtr<ISpoutSharedMemoryRegion> InRegion)
+	: Region(MoveTemp(InRegion))
+{
+	check(Region.IsValid() && Region->GetSize() >= sizeof(FSpoutSenderRecordLayout));
+}
+
+FSpoutSenderRecordReader::~FSpoutSenderRecordReader() = default;
+
+TUniquePtr<FSpoutSenderRecordReader> FSpoutSenderRecordReader::Open(const ANSICHAR* SenderName)
+{
+	if (!SenderName || !SenderName[0])
+		return nullptr;
+
+	const FString RegionName = FSpoutSenderRecordWriter::GetRegionName(SenderName);
+	TUniquePtr<ISpoutSharedMemoryRegion> Region = SpoutSharedMemory::Open(TCHAR_TO_ANSI(*RegionName), sizeof(FSpoutSenderRecordLayout), ESpoutSharedMemoryAccess::ReadOnly);
+	if (!Region.IsValid())
+		return nullptr;
+
+	return MakeUnique<FSpoutSenderRecordReader>(MoveTemp(Region));
+}
+
+const FSpoutSenderRecordLayout& FSpoutSenderRecordReader::GetLayout() const
+{
+	return *reinterpret_cast<const FSpoutSenderRecordLayout*>(Region->GetData());
+}
+
+bool FSpoutSenderRecordReader::Read(FSpoutSenderRecord& OutRecord) const
+{
+	const FSpoutSenderRecordLayout& Layout = GetLayout();
+	if (Load(Layout.Magic) != FSpoutSenderRecordLayout::ExpectedMagic || Load(Layout.Version) != FSpoutSenderRecordLayout::CurrentVersion)
+		return false;
+
+	for (int32 Attempt = 0; Attempt < MaxReadAttempts; ++Attempt)
+	{
+		if (Attempt > 0)
+			++NumRetries;
+
+		const uint64 Sequence = Load(Layout.Sequence);
+		if (Sequence & 1)
+		{
+			FPlatformProcess::YieldThread();
+			continue;
+		}
+
+		FSpoutSenderRecord Record;
+		const bool bActive = Load(Layout.Active) != 0;
+		Record.FrameNumber = Load(Layout.FrameNumber);
+		Record.ShareHandle = Load(Layout.ShareHandle);
+		Record.Width = Load(Layout.Width);
+		Record.Height = Load(Layout.Height);
+		Record.Format = Load(Layout.Format);
+		Record.NumSlots = Load(Layout.NumSlots);
+		Record.PublishedSlot = Load(Layout.PublishedSlot);
+		for (int32 i = 0; i < FSpoutTextureRing::MaxSlots; ++i)
+			Record.SlotHandles[i] = Load(Layout.SlotHandles[i]);
+
+		if (Load(Layout.Sequence) != Sequence)
+			continue;
+
+		if (!bActive || Record.NumSlots > FSpoutTextureRing::MaxSlots)
+			return false;
+
+		OutRecord = Record;
+		return true;
+	}
+	return false;
+}
+
+FSpoutSenderRecordReader::EResult FSpoutSenderRecordReader::Poll(FSpoutSenderRecord& OutRecord) const
+{
+	if (!Read(OutRecord))
+		return EResult::Unavailable;
+
+	return bHasConsumed && OutRecord.FrameNumber == ConsumedFrame ? EResult::Unchanged : EResult::NewFrame;
+}
+
+void FSpoutSenderRecordReader::MarkConsumed(uint64 Frame)
+{
+	ConsumedFrame = Frame;
+	bHasConsumed = true;
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "SpoutTextureRing.h"
+
+class ISpoutSharedMemoryRegion;
+
+/** Shared-memory layout of a sender's lock-free record. Plain data, no Windows types. */
+struct FSpoutSenderRecordLayout
+{
+	static constexpr uint32 ExpectedMagic = 0x52505355; // 'USPR'
+	static constexpr uint32 CurrentVersion = 1;
+
+	uint32 Magic;
+	uint32 Version;
+
+	/** Seqlock over everything below: odd while the sender writes. */
+	uint64 Sequence;
+
+	/** Sender frame number of the published slot. */
+	uint64 FrameNumber;
+	/** 0 once the sender has closed. */
+	uint32 Active;
+	/** Same meaning as the legacy SharedTextureInfo fields. */
+	uint32 ShareHandle;
+	uint32 Width;
+	uint32 Height;
+	uint32 Format;
+	uint32 NumSlots;
+	uint32 PublishedSlot;
+	uint32 SlotHandles[FSpoutTextureRing::MaxSlots];
+};
+
+static_assert(STRUCT_OFFSET(FSpoutSenderRecordLayout, Sequence) % 8 == 0, "Sender record sequence must be 8-byte aligned for 64-bit atomics");
+
+/** A consistent copy of a sender's record. */
+struct FSpoutSenderRecord
+{
+	uint64 FrameNumber = 0;
+	uint32 ShareHandle = 0;
+	uint32 Width = 0;
+	uint32 Height = 0;
+	/** DXGI_FORMAT */
+	uint32 Format = 0;
+	uint32 NumSlots = 0;
+	uint32 PublishedSlot = 0;
+	uint32 SlotHandles[FSpoutTextureRing::MaxSlots] = {};
+};
+
+/**
+ * Sender state published through a seqlock in its own mapping ("<sender>_record"), next to
+ * the SDK's SharedTextureInfo, which stays for legacy receivers. Publishing is a handful of
+ * atomic stores and never waits; readers copy the record and retry if a publish overlapped.
+ * Neither side takes the SDK's named mutex.
+ *
+ * Works on any ISpoutSharedMemoryRegion, including the POSIX one. One writer per name, since
+ * the sequence is kept locally; FSpoutSenderRegistry hands out the process's one.
+ */
+class FSpoutSenderRecordWriter
+{
+public:
+	/** Region must hold a full FSpoutSenderRecordLayout and be writable. */
+	explicit FSpoutSenderRecordWriter(TUniquePtr<ISpoutSharedMemoryRegion> InRegion);
+	~FSpoutSenderRecordWriter();
+
+	/** Creates or takes over SenderName's record. Null on failure. */
+	static TUniquePtr<FSpoutSenderRecordWriter> Create(const ANSICHAR* SenderName);
+
+	/** Shared-memory name of SenderName's record. */
+	static FString GetRegionName(const ANSICHAR* SenderName);
+
+	/** Replaces the record. Never blocks. */
+	void Publish(const FSpoutSenderRecord& Record);
+
+	/** Tells readers the sender is gone; they fall back to the legacy lookup. */
+	void Close();
+
+private:
+	FSpoutSenderRecordLayout& GetLayout() const;
+	void BeginWrite();
+	void EndWrite();
+
+	TUniquePtr<ISpoutSharedMemoryRegion> Region;
+	uint64 Sequence = 0;
+};
+
+class FSpoutSenderRecordReader
+{
+public:
+	enum class EResult : uint8
+	{
+		NewFrame,
+		Unchanged,
+		/** No open record, or a publish kept overlapping the read; use the legacy lookup. */
+		Unavailable,
+	};
+
+	/** Retries of a read that overlapped a publish before giving up. */
+	static constexpr int32 MaxReadAttempts = 16;
+
+	/** Region must hold a full FSpoutSenderRecordLayout. */
+	explicit FSpoutSenderRecordReader(TUniquePtr<ISpoutSharedMemoryRegion> InRegion);
+	~FSpoutSenderRecordReader();
+
+	/** Maps SenderName's record read-only, or returns null if the sender does not publish one. */
+	static TUniquePtr<FSpoutSenderRecordReader> Open(const ANSICHAR* SenderName);
+
+	/** Copies the record if it is consistent and the sender is still open. */
+	bool Read(FSpoutSenderRecord& OutRecord) const;
+
+	/** Reads the record and compares its frame against the last one consumed. */
+	EResult Poll(FSpoutSenderRecord& OutRecord) const;
+
+	/** Records the frame as copied; Poll reports Unchanged until the sender publishes another. */
+	void MarkConsumed(uint64 Frame);
+
+	/** Forgets the consumed frame so the next Poll reports NewFrame again. */
+	void Reset() { bHasConsumed = false; }
+
+	/** Reads that had to retry because a publish overlapped them, since creation. */
+	uint64 GetNumRetries() const { return NumRetries; }
+
+private:
+	const FSpoutSenderRecordLayout& GetLayout() const;
+
+	TUniquePtr<ISpoutSharedMemoryRegion> Region;
+	uint64 ConsumedFrame = 0;
+	bool bHasConsumed = false;
+	mutable uint64 NumRetries = 0;
+};
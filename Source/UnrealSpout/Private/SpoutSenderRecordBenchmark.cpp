@@ -0,0 +1,168 @@
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/OutputDevice.h"
+
+#include "SpoutSenderRecord.h"
+#include "SpoutSharedMemoryRegion.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#if !UE_BUILD_SHIPPING
+
+namespace
+{
+	/** Every field derives from the frame number, so a torn copy shows as a mismatch. */
+	FSpoutSenderRecord MakeRecord(uint64 Frame)
+	{
+		FSpoutSenderRecord Record;
+		Record.FrameNumber = Frame;
+		Record.ShareHandle = static_cast<uint32>(Frame * 7);
+		Record.Width = static_cast<uint32>(Frame);
+		Record.Height = static_cast<uint32>(Frame >> 1);
+		Record.Format = 28;
+		Record.NumSlots = FSpoutTextureRing::MaxSlots;
+		Record.PublishedSlot = static_cast<uint32>(Frame % FSpoutTextureRing::MaxSlots);
+		for (int32 i = 0; i < FSpoutTextureRing::MaxSlots; ++i)
+			Record.SlotHandles[i] = static_cast<uint32>(Frame + i);
+		return Record;
+	}
+
+	bool IsConsistent(const FSpoutSenderRecord& Record)
+	{
+		const FSpoutSenderRecord Expected = MakeRecord(Record.FrameNumber);
+		return FMemory::Memcmp(&Record, &Expected, sizeof(Record)) == 0;
+	}
+
+	struct FContentionResult
+	{
+		uint64 Publishes = 0;
+		uint64 Reads = 0;
+		uint64 Retries = 0;
+		uint64 Failed = 0;
+		uint64 Torn = 0;
+	};
+
+	/** One publishing thread against NumReaders reading threads for Seconds. Read gets the reader's index. */
+	template <typename PublishFn, typename ReadFn>
+	FContentionResult RunContention(int32 NumReaders, double Seconds, PublishFn&& Publish, ReadFn&& Read)
+	{
+		std::atomic<bool> bStop { false };
+		std::atomic<uint64> Reads { 0 }, Retries { 0 }, Failed { 0 }, Torn { 0 };
+
+		std::vector<std::thread> Readers;
+		for (int32 i = 0; i < NumReaders; ++i)
+		{
+			Readers.emplace_back([&, i]()
+			{
+				uint64 LocalReads = 0, LocalRetries = 0, LocalFailed = 0, LocalTorn = 0;
+				while (!bStop.load(std::memory_order_relaxed))
+				{
+					FSpoutSenderRecord Record;
+					if (Read(i, Record, LocalRetries))
+						LocalTorn += IsConsistent(Record) ? 0 : 1;
+					else
+						++LocalFailed;
+					++LocalReads;
+				}
+				Reads += LocalReads;
+				Retries += LocalRetries;
+				Failed += LocalFailed;
+				Torn += LocalTorn;
+			});
+		}
+
+		FContentionResult Result;
+		const double End = FPlatformTime::Seconds() + Seconds;
+		while (FPlatformTime::Seconds() < End)
+		{
+			for (int32 i = 0; i < 64; ++i)
+				Publish(MakeRecord(++Result.Publishes));
+		}
+
+		bStop = true;
+		for (std::thread& Reader : Readers)
+			Reader.join();
+
+		Result.Reads = Reads;
+		Result.Retries = Retries;
+		Result.Failed = Failed;
+		Result.Torn = Torn;
+		return Result;
+	}
+
+	void LogResult(FOutputDevice& Ar, const TCHAR* Label, int32 NumReaders, double Seconds, const FContentionResult& Result)
+	{
+		Ar.Logf(TEXT("  %-8s %d readers  publish %7.2f M/s  read %7.2f M/s  retried %llu  failed %llu  torn %llu"),
+			Label, NumReaders,
+			Result.Publishes / Seconds / 1.0e6, Result.Reads / Seconds / 1.0e6,
+			Result.Retries, Result.Failed, Result.Torn);
+	}
+
+	void BenchmarkSenderRecord(const TArray<FString>& Args, FOutputDevice& Ar)
+	{
+		const FString SenderName = FString::Printf(TEXT("UnrealSpoutRecordBenchmark_%u"), FPlatformProcess::GetCurrentProcessId());
+		TUniquePtr<FSpoutSenderRecordWriter> Writer = FSpoutSenderRecordWriter::Create(TCHAR_TO_ANSI(*SenderName));
+		if (!Writer.IsValid())
+		{
+			Ar.Log(TEXT("Spout sender record: could not create the shared memory region."));
+			return;
+		}
+
+		const double Seconds = Args.Num() > 0 ? FMath::Max(0.1, FCString::Atod(*Args[0])) : 1.0;
+		const int32 MaxReaders = FMath::Max(1, static_cast<int32>(std::thread::hardware_concurrency()) - 1);
+
+		// Readers map the record separately, as receivers in other processes would.
+		TArray<TUniquePtr<FSpoutSenderRecordReader>> RecordReaders;
+		for (int32 i = 0; i < MaxReaders; ++i)
+		{
+			RecordReaders.Add(FSpoutSenderRecordReader::Open(TCHAR_TO_ANSI(*SenderName)));
+			if (!RecordReaders.Last().IsValid())
+			{
+				Ar.Log(TEXT("Spout sender record: could not open the shared memory region."));
+				return;
+			}
+		}
+
+		for (int32 NumReaders = 1; NumReaders <= MaxReaders; NumReaders *= 2)
+		{
+			// Seqlock record: readers on their own mappings, the writer never waits.
+			Writer->Publish(MakeRecord(0));
+			const FContentionResult Seqlock = RunContention(NumReaders, Seconds,
+				[&](const FSpoutSenderRecord& Record) { Writer->Publish(Record); },
+				[&](int32 ReaderIndex, FSpoutSenderRecord& Out, uint64& OutRetries)
+				{
+					FSpoutSenderRecordReader& Reader = *RecordReaders[ReaderIndex];
+					const uint64 Before = Reader.GetNumRetries();
+					const bool bRead = Reader.Read(Out);
+					OutRetries += Reader.GetNumRetries() - Before;
+					return bRead;
+				});
+			LogResult(Ar, TEXT("seqlock"), NumReaders, Seconds, Seqlock);
+
+			// Baseline: the same copy under one lock, as the SDK's named mutex serializes it.
+			FCriticalSection Lock;
+			FSpoutSenderRecord Locked = MakeRecord(0);
+			const FContentionResult Mutex = RunContention(NumReaders, Seconds,
+				[&](const FSpoutSenderRecord& Record) { FScopeLock ScopeLock(&Lock); Locked = Record; },
+				[&](int32, FSpoutSenderRecord& Out, uint64&) { FScopeLock ScopeLock(&Lock); Out = Locked; return true; });
+			LogResult(Ar, TEXT("mutex"), NumReaders, Seconds, Mutex);
+		}
+
+		RecordReaders.Reset();
+		Writer->Close();
+		Writer.Reset();
+		SpoutSharedMemory::Remove(TCHAR_TO_ANSI(*FSpoutSenderRecordWriter::GetRegionName(TCHAR_TO_ANSI(*SenderName))));
+	}
+
+	FAutoConsoleCommandWithArgsAndOutputDevice BenchmarkSenderRecordCommand(
+		TEXT("Spout.BenchmarkSenderRecord"),
+		TEXT("Publishes a private Spout sender record from one thread while 1..N threads read it, then repeats with a lock instead of the seqlock. Optional argument: seconds per run (default 1)."),
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&BenchmarkSenderRecord));
+}
+
+#endif
@@ -0,0 +1,126 @@
+#include "SpoutSenderRegistry.h"
+
+#include "HAL/PlatformProcess.h"
+#include "Misc/ScopeLock.h"
+
+#include "SpoutFrameSignal.h"
+#include "SpoutMemoryShare.h"
+#include "SpoutSenderDirectory.h"
+#include "SpoutSenderRecord.h"
+
+FSpoutSenderRegistry::FSpoutSenderRegistry(FSpoutSenderDirectory* InDirectory, int64 InOwnerId, int64 InTimeoutMs, bool bInCreateWriters)
+	: Directory(InDirectory)
+	, OwnerId(InOwnerId)
+	, TimeoutMs(InTimeoutMs)
+	, bCreateWriters(bInCreateWriters)
+{
+	check(OwnerId != 0);
+}
+
+FSpoutSenderRegistry& FSpoutSenderRegistry::Get()
+{
+	static FSpoutSenderRegistry Instance(FSpoutSenderDirectory::Get(), static_cast<int64>(FPlatformProcess::GetCurrentProcessId()), FSpoutSenderDirectory::DefaultTimeoutMs, true);
+	return Instance;
+}
+
+FSpoutSenderRegistry::FWriters FSpoutSenderRegistry::CreateWriters(const ANSICHAR* Name)
+{
+	FWriters Writers;
+	if (TUniquePtr<FSpoutSenderRecordWriter> Record = FSpoutSenderRecordWriter::Create(Name))
+		Writers.Record = MakeShareable(Record.Release());
+	if (TUniquePtr<FSpoutFrameSignalSender> FrameSignal = FSpoutFrameSignalSender::Create(Name))
+		Writers.FrameSignal = MakeShareable(FrameSignal.Release());
+	return Writers;
+}
+
+FSpoutSenderRegistry::FWriters FSpoutSenderRegistry::Acquire(const ANSICHAR* Name, int64 Now, int32* OutCount)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	FEntry& Entry = Entries.FindOrAdd(FString(ANSI_TO_TCHAR(Name)));
+	if (++Entry.Count == 1)
+	{
+		if (bCreateWriters)
+			Entry.Writers = CreateWriters(Name);
+
+		if (Directory)
+			Entry.Slot = Directory->Register(Name, OwnerId, Now, TimeoutMs);
+	}
+
+	if (OutCount)
+		*OutCount = Entry.Count;
+	return Entry.Writers;
+}
+
+int32 FSpoutSenderRegistry::Release(const ANSICHAR* Name)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const FString Key(ANSI_TO_TCHAR(Name));
+	FEntry* Entry = Entries.Find(Key);
+	if (!ensure(Entry && Entry->Count > 0))
+		return 0;
+
+	if (--Entry->Count > 0)
+		return Entry->Count;
+
+	if (Directory && Entry->Slot != INDEX_NONE)
+		Directory->Unregister(Name, OwnerId);
+
+	Entries.Remove(Key);
+	return 0;
+}
+
+TSharedPtr<FSpoutMemoryShareWriter, ESPMode::ThreadSafe> FSpoutSenderRegistry::AcquireMemoryShare(const ANSICHAR* Name)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	TWeakPtr<FSpoutMemoryShareWriter, ESPMode::ThreadSafe>& Weak = MemoryShares.FindOrAdd(FString(ANSI_TO_TCHAR(Name)));
+	if (TSharedPtr<FSpoutMemoryShareWriter, ESPMode::ThreadSafe> Existing = Weak.Pin())
+		return Existing;
+
+	TSharedPtr<FSpoutMemoryShareWriter, ESPMode::ThreadSafe> Created;
+	if (TUniquePtr<FSpoutMemoryShareWriter> Writer = FSpoutMemoryShareWriter::Create(Name))
+		Created = MakeShareable(Writer.Release());
+
+	Weak = Created;
+	return Created;
+}
+
+int32 FSpoutSenderRegistry::GetCount(const ANSICHAR* Name) const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	const FEntry* Entry = Entries.Find(FString(ANSI_TO_TCHAR(Name)));
+	return Entry ? Entry->Count : 0;
+}
+
+int32 FSpoutSenderRegistry::Num() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Entries.Num();
+}
+
+void FSpoutSenderRegistry::Tick(int64 Now)
+{
+	if (!Directory)
+		return;
+
+	FScopeLock ScopeLock(&Lock);
+
+	if (Now - LastTickMs < TickIntervalMs)
+		return;
+	LastTickMs = Now;
+
+	for (TPair<FString, FEntry>& Pair : Entries)
+	{
+		FEntry& Entry = Pair.Value;
+		if (Entry.Slot != INDEX_NONE && Directory->Heartbeat(Entry.Slot, OwnerId, Now))
+			continue;
+
+		// Reclaimed after a stall, or held by another process that may have died since.
+		Entry.Slot = Directory->Register(TCHAR_TO_ANSI(*Pair.Key), OwnerId, Now, TimeoutMs);
+	}
+
+	Directory->ReclaimStale(Now, TimeoutMs);
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+class FSpoutFrameSignalSender;
+class FSpoutMemoryShareWriter;
+class FSpoutSenderDirectory;
+class FSpoutSenderRecordWriter;
+
+/**
+ * Counts this process's senders per name, and keeps each name's entry in the sender
+ * directory owned and alive while the count is above zero. Several components may publish
+ * under one name; the first creates the SDK sender and the last releases it.
+ *
+ * The shared-memory writers of a name allow one writer each, so they live here too and every
+ * sender of the name publishes through the same ones (on the render thread).
+ *
+ * Safe to use from any thread. Heartbeats and reclaiming dead entries of other processes
+ * happen in Tick. Timestamps are passed in so the protocol can be driven by a fake clock.
+ */
+class FSpoutSenderRegistry
+{
+public:
+	/** How often (ms) Tick heartbeats our entries and reclaims dead ones. */
+	static constexpr int64 TickIntervalMs = 500;
+
+	/**
+	 * Directory may be null, which leaves only the in-process counting. OwnerId is never 0.
+	 * Without bInCreateWriters names come with no writers, so no sender regions are created.
+	 */
+	FSpoutSenderRegistry(FSpoutSenderDirectory* InDirectory, int64 InOwnerId, int64 InTimeoutMs, bool bInCreateWriters = false);
+
+	/** The process's registry over FSpoutSenderDirectory::Get(), owned by its process id, with writers. */
+	static FSpoutSenderRegistry& Get();
+
+	/** Writers a name's senders share; either may be null if its region could not be created. */
+	struct FWriters
+	{
+		TSharedPtr<FSpoutSenderRecordWriter, ESPMode::ThreadSafe> Record;
+		TSharedPtr<FSpoutFrameSignalSender, ESPMode::ThreadSafe> FrameSignal;
+	};
+
+	/**
+	 * Adds a reference to Name and returns its writers, created with the first reference and
+	 * before the directory lists the name, so receivers that look it up find them. OutCount
+	 * gets the new count; 1 means the name is new to this process.
+	 */
+	FWriters Acquire(const ANSICHAR* Name, int64 Now, int32* OutCount = nullptr);
+
+	/** Drops a reference to Name. Returns the count left; 0 means the name is no longer ours and its writers are dropped. */
+	int32 Release(const ANSICHAR* Name);
+
+	/** Name's memory-share writer, shared by everyone publishing it; it ends the stream once the last reference goes. Null on failure. */
+	TSharedPtr<FSpoutMemoryShareWriter, ESPMode::ThreadSafe> AcquireMemoryShare(const ANSICHAR* Name);
+
+	/** References this process holds on Name. */
+	int32 GetCount(const ANSICHAR* Name) const;
+
+	/** Names held; with or without a directory entry. */
+	int32 Num() const;
+
+	/** Every TickIntervalMs: refreshes our entries, re-registers lost ones and reclaims dead ones. */
+	void Tick(int64 Now);
+
+private:
+	static FWriters CreateWriters(const ANSICHAR* Name);
+
+	struct FEntry
+	{
+		int32 Count = 0;
+		/** Directory slot, or INDEX_NONE while another live process holds the name. */
+		int32 Slot = INDEX_NONE;
+		FWriters Writers;
+	};
+
+	FSpoutSenderDirectory* Directory;
+	const int64 OwnerId;
+	const int64 TimeoutMs;
+	const bool bCreateWriters;
+
+	mutable FCriticalSection Lock;
+	TMap<FString, FEntry> Entries;
+	TMap<FString, TWeakPtr<FSpoutMemoryShareWriter, ESPMode::ThreadSafe>> MemoryShares;
+	int64 LastTickMs = 0;
+};
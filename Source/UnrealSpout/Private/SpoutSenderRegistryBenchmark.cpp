@@ -0,0 +1,117 @@
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/OutputDevice.h"
+
+#include "SpoutConsumerTable.h"
+#include "SpoutSenderDirectory.h"
+#include "SpoutSenderRegistry.h"
+#include "SpoutSharedMemoryRegion.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#if !UE_BUILD_SHIPPING
+
+namespace
+{
+	/** Names the churn threads fight over, so most acquires hit a name another thread holds. */
+	constexpr int32 NumNames = 64;
+
+	void BenchmarkSenderRegistry(const TArray<FString>& Args, FOutputDevice& Ar)
+	{
+		const double Seconds = Args.Num() > 0 ? FMath::Max(0.1, FCString::Atod(*Args[0])) : 1.0;
+		const int32 MaxThreads = FMath::Max(1, static_cast<int32>(std::thread::hardware_concurrency()));
+
+		const FString RegionName = FString::Printf(TEXT("UnrealSpoutRegistryBenchmark_%u"), FPlatformProcess::GetCurrentProcessId());
+		TUniquePtr<FSpoutSenderDirectory> Directory = FSpoutSenderDirectory::OpenOrCreate(TCHAR_TO_ANSI(*RegionName));
+		if (!Directory.IsValid())
+		{
+			Ar.Log(TEXT("Spout sender registry: could not create the shared memory region."));
+			return;
+		}
+
+		TArray<TArray<ANSICHAR>> Names;
+		for (int32 i = 0; i < NumNames; ++i)
+		{
+			const auto Converted = StringCast<ANSICHAR>(*FString::Printf(TEXT("Stage Camera %02d"), i));
+			Names.Emplace(Converted.Get(), Converted.Length() + 1);
+		}
+
+		// Parallel create/destroy: every thread acquires random names and releases them in random order.
+		for (int32 NumThreads = 1; NumThreads <= MaxThreads; NumThreads *= 2)
+		{
+			const int64 OwnerId = static_cast<int64>(FPlatformProcess::GetCurrentProcessId());
+			FSpoutSenderRegistry Registry(Directory.Get(), OwnerId, FSpoutSenderDirectory::DefaultTimeoutMs);
+
+			std::atomic<bool> bStop { false };
+			std::atomic<uint64> Ops { 0 };
+			std::atomic<int32> Errors { 0 };
+			std::vector<std::thread> Threads;
+			for (int32 t = 0; t < NumThreads; ++t)
+			{
+				Threads.emplace_back([&, t]()
+				{
+					FRandomStream Random(t + 1);
+					TArray<int32, TInlineAllocator<8>> Held;
+					uint64 LocalOps = 0;
+					while (!bStop.load(std::memory_order_relaxed))
+					{
+						if (Held.Num() < 8 && (Held.Num() == 0 || Random.RandRange(0, 1) == 0))
+						{
+							const int32 Name = Random.RandRange(0, NumNames - 1);
+							int32 Count = 0;
+							Registry.Acquire(Names[Name].GetData(), FSpoutConsumerTable::NowMs(), &Count);
+							Errors += Count < 1 ? 1 : 0;
+							Held.Add(Name);
+						}
+						else
+						{
+							const int32 Index = Random.RandRange(0, Held.Num() - 1);
+							const int32 Count = Registry.Release(Names[Held[Index]].GetData());
+							Errors += Count < 0 ? 1 : 0;
+							Held.RemoveAtSwap(Index);
+						}
+						++LocalOps;
+					}
+
+					for (const int32 Name : Held)
+						Registry.Release(Names[Name].GetData());
+					Ops += LocalOps;
+				});
+			}
+
+			FPlatformProcess::Sleep(static_cast<float>(Seconds));
+			bStop = true;
+			for (std::thread& Thread : Threads)
+				Thread.join();
+
+			// Everything released: nothing may be left, here or in the directory.
+			Ar.Logf(TEXT("  %2d threads  %7.2f M acquire/release per s  left in registry %d, in directory %d  errors %d"),
+				NumThreads, Ops / Seconds / 1.0e6, Registry.Num(), Directory->Num(), Errors.load());
+		}
+
+		// Reclaiming the entries of a process that stopped heartbeating.
+		const int64 Now = FSpoutConsumerTable::NowMs();
+		const int64 DeadOwner = -1;
+		for (const TArray<ANSICHAR>& Name : Names)
+			Directory->Register(Name.GetData(), DeadOwner, Now - 2 * FSpoutSenderDirectory::DefaultTimeoutMs);
+
+		const double Start = FPlatformTime::Seconds();
+		const int32 Reclaimed = Directory->ReclaimStale(Now);
+		Ar.Logf(TEXT("  reclaimed %d dead entries in %.1f us, %d left"), Reclaimed, (FPlatformTime::Seconds() - Start) * 1.0e6, Directory->Num());
+
+		Directory.Reset();
+		SpoutSharedMemory::Remove(TCHAR_TO_ANSI(*RegionName));
+	}
+
+	FAutoConsoleCommandWithArgsAndOutputDevice BenchmarkSenderRegistryCommand(
+		TEXT("Spout.BenchmarkSenderRegistry"),
+		TEXT("Acquires and releases random sender names from 1..N threads against a private Spout sender directory, checks nothing leaks, then times reclaiming a dead process's entries. Optional argument: seconds per run (default 1)."),
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&BenchmarkSenderRegistry));
+}
+
+#endif
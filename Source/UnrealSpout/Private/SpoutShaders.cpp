@@ -0,0 +1,46 @@
+#include "SpoutShaders.h"
+
+#include "PixelShaderUtils.h"
+#include "RenderGraphBuilder.h"
+#include "RHIStaticStates.h"
+
+IMPLEMENT_GLOBAL_SHADER(FSpoutConvertPS, "/Plugin/UnrealSpout/SpoutReceiverCopyShader.usf", "MainPixelShader", SF_Pixel);
+IMPLEMENT_GLOBAL_SHADER(FSpoutConvertRDGPS, "/Plugin/UnrealSpout/SpoutReceiverCopyShader.usf", "MainPixelShader", SF_Pixel);
+
+void SetSpoutConversionParameters(FSpoutConversionParameters& Parameters, const FSpoutConversionSettings& Settings, FIntPoint SrcSize, FIntPoint OutputSize, FIntRect SrcRect)
+{
+	if (SrcRect.IsEmpty())
+		SrcRect = FIntRect(FIntPoint::ZeroValue, SrcSize);
+
+	const FVector2f InvSrcSize(1.0f / FMath::Max(SrcSize.X, 1), 1.0f / FMath::Max(SrcSize.Y, 1));
+
+	Parameters.SrcSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+	Parameters.SrcSize = FVector2f(SrcSize);
+	Parameters.SrcUVRect = FVector4f(
+		SrcRect.Min.X * InvSrcSize.X, SrcRect.Min.Y * InvSrcSize.Y,
+		SrcRect.Max.X * InvSrcSize.X, SrcRect.Max.Y * InvSrcSize.Y);
+	Parameters.OutputSize = FVector2f(OutputSize);
+	Parameters.Filter = static_cast<uint32>(Settings.Filter);
+	Parameters.SwapRedBlue = Settings.bSwapRedBlue ? 1 : 0;
+	Parameters.ColorConversion = static_cast<uint32>(Settings.ColorConversion);
+	Parameters.FlipVertically = Settings.bFlipVertically ? 1 : 0;
+}
+
+void AddSpoutConversionPass(FRDGBuilder& GraphBuilder, FRDGTextureRef Src, FRDGTextureRef Dst, const FSpoutConversionSettings& Settings, FIntRect SrcRect)
+{
+	const FIntPoint OutputSize = Dst->Desc.Extent;
+
+	FSpoutConvertRDGPS::FParameters* Parameters = GraphBuilder.AllocParameters<FSpoutConvertRDGPS::FParameters>();
+	Parameters->SrcTexture = Src;
+	SetSpoutConversionParameters(Parameters->Conversion, Settings, Src->Desc.Extent, OutputSize, SrcRect);
+	Parameters->RenderTargets[0] = FRenderTargetBinding(Dst, ERenderTargetLoadAction::ENoAction);
+
+	TShaderMapRef<FSpoutConvertRDGPS> PixelShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+	FPixelShaderUtils::AddFullscreenPass(
+		GraphBuilder,
+		GetGlobalShaderMap(GMaxRHIFeatureLevel),
+		RDG_EVENT_NAME("SpoutConvert %dx%d", OutputSize.X, OutputSize.Y),
+		PixelShader,
+		Parameters,
+		FIntRect(FIntPoint::ZeroValue, OutputSize));
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GlobalShader.h"
+#include "RenderGraphDefinitions.h"
+#include "ShaderParameterStruct.h"
+#include "SpoutTypes.h"
+
+/** Conversion inputs shared by the RHI and RDG variants of the pass; see FSpoutConversionSettings. */
+BEGIN_SHADER_PARAMETER_STRUCT(FSpoutConversionParameters, )
+	SHADER_PARAMETER_SAMPLER(SamplerState, SrcSampler)
+	SHADER_PARAMETER(FVector2f, SrcSize)
+	SHADER_PARAMETER(FVector4f, SrcUVRect)
+	SHADER_PARAMETER(FVector2f, OutputSize)
+	SHADER_PARAMETER(uint32, Filter)
+	SHADER_PARAMETER(uint32, SwapRedBlue)
+	SHADER_PARAMETER(uint32, ColorConversion)
+	SHADER_PARAMETER(uint32, FlipVertically)
+END_SHADER_PARAMETER_STRUCT()
+
+/** Fills the conversion inputs from the settings and the two extents. An empty SrcRect reads the whole source. */
+void SetSpoutConversionParameters(FSpoutConversionParameters& Parameters, const FSpoutConversionSettings& Settings, FIntPoint SrcSize, FIntPoint OutputSize, FIntRect SrcRect = FIntRect());
+
+/**
+ * Fullscreen pass that resamples SrcTexture into the bound render target, with the
+ * optional filter, red/blue swap, transfer-function change and vertical flip of
+ * FSpoutConversionSettings. Driven by FPixelShaderUtils' fullscreen triangle; the pixel
+ * position alone is used to find the source texel, so any output size works.
+ * SpoutConversion::ConvertReference is the CPU mirror.
+ */
+class FSpoutConvertPS : public FGlobalShader
+{
+public:
+	DECLARE_GLOBAL_SHADER(FSpoutConvertPS);
+	SHADER_USE_PARAMETER_STRUCT(FSpoutConvertPS, FGlobalShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_SRV(Texture2D<float4>, SrcTexture)
+		SHADER_PARAMETER_STRUCT_INCLUDE(FSpoutConversionParameters, Conversion)
+	END_SHADER_PARAMETER_STRUCT()
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+	}
+};
+
+/** FSpoutConvertPS for render graph passes: same shader source, RDG-tracked input and output. */
+class FSpoutConvertRDGPS : public FGlobalShader
+{
+public:
+	DECLARE_GLOBAL_SHADER(FSpoutConvertRDGPS);
+	SHADER_USE_PARAMETER_STRUCT(FSpoutConvertRDGPS, FGlobalShader);
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float4>, SrcTexture)
+		SHADER_PARAMETER_STRUCT_INCLUDE(FSpoutConversionParameters, Conversion)
+		RENDER_TARGET_BINDING_SLOTS()
+	END_SHADER_PARAMETER_STRUCT()
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+	}
+};
+
+/** Adds one fullscreen pass converting SrcRect of Src (all of it if empty) into the whole of Dst. */
+void AddSpoutConversionPass(FRDGBuilder& GraphBuilder, FRDGTextureRef Src, FRDGTextureRef Dst, const FSpoutConversionSettings& Settings, FIntRect SrcRect = FIntRect());
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Atomic access to the fields of the shared-memory layouts (sender record and directory,
+ * memory share, frame signal, consumer table). The layouts keep plain unsigned fields so they
+ * stay identical across processes; FPlatformAtomics wants signed volatile integers, so every
+ * access goes through these. Loads and stores are sequentially consistent.
+ */
+namespace SpoutSharedAtomics
+{
+	inline volatile int32* AsAtomic(uint32& Value)
+	{
+		return reinterpret_cast<volatile int32*>(&Value);
+	}
+
+	inline const volatile int32* AsAtomic(const uint32& Value)
+	{
+		return reinterpret_cast<const volatile int32*>(&Value);
+	}
+
+	inline volatile int64* AsAtomic(uint64& Value)
+	{
+		return reinterpret_cast<volatile int64*>(&Value);
+	}
+
+	inline const volatile int64* AsAtomic(const uint64& Value)
+	{
+		return reinterpret_cast<const volatile int64*>(&Value);
+	}
+
+	inline volatile int64* AsAtomic(int64& Value)
+	{
+		return &Value;
+	}
+
+	inline const volatile int64* AsAtomic(const int64& Value)
+	{
+		return &Value;
+	}
+
+	inline uint32 Load(const uint32& Value)
+	{
+		return static_cast<uint32>(FPlatformAtomics::AtomicRead(AsAtomic(Value)));
+	}
+
+	inline uint64 Load(const uint64& Value)
+	{
+		return static_cast<uint64>(FPlatformAtomics::AtomicRead(AsAtomic(Value)));
+	}
+
+	inline void Store(uint32& Value, uint32 NewValue)
+	{
+		FPlatformAtomics::AtomicStore(AsAtomic(Value), static_cast<int32>(NewValue));
+	}
+
+	inline void Store(uint64& Value, uint64 NewValue)
+	{
+		FPlatformAtomics::AtomicStore(AsAtomic(Value), static_cast<int64>(NewValue));
+	}
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include "Spout.h"
+#include "Windows/HideWindowsPlatformTypes.h"
+
+#include "SpoutSenderInfoLayout.h"
+
+static_assert(sizeof(FSpoutSharedTextureInfoLayout) == sizeof(SharedTextureInfo), "FSpoutSharedTextureInfoLayout must mirror SharedTextureInfo");
+static_assert(STRUCT_OFFSET(FSpoutSharedTextureInfoLayout, Description) == STRUCT_OFFSET(SharedTextureInfo, description), "FSpoutSharedTextureInfoLayout must mirror SharedTextureInfo");
+
+namespace SpoutSharedInfo
+{
+	/** Spout stores 64-bit share handles truncated to 32 bits, which is what DXGI guarantees for shared resources. */
+	inline uint32 HandleToUint32(HANDLE Handle)
+	{
+		return static_cast<uint32>(reinterpret_cast<UPTRINT>(Handle));
+	}
+
+	inline HANDLE Uint32ToHandle(uint32 Value)
+	{
+		return reinterpret_cast<HANDLE>(static_cast<UPTRINT>(Value));
+	}
+
+	inline void WriteExt(SharedTextureInfo& Info, const FSpoutSenderInfoExt& Ext)
+	{
+		FMemory::Memzero(Info.description, sizeof(Info.description));
+		FMemory::Memcpy(Info.description, &Ext, sizeof(Ext));
+	}
+
+	/** Returns false if the record was written by a sender that does not know about the extension. */
+	inline bool ReadExt(const SharedTextureInfo& Info, FSpoutSenderInfoExt& OutExt)
+	{
+		return SpoutSenderInfoLayout::ReadExt(reinterpret_cast<const FSpoutSharedTextureInfoLayout&>(Info), OutExt);
+	}
+}
@@ -0,0 +1,164 @@
+#include "SpoutSharedMemoryRegion.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <windows.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+#else
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+#if PLATFORM_WINDOWS
+	class FSpoutWindowsSharedMemoryRegion final : public ISpoutSharedMemoryRegion
+	{
+	public:
+		FSpoutWindowsSharedMemoryRegion(HANDLE InMapping, uint8* InData, SIZE_T InSize, bool bInWritable)
+			: Mapping(InMapping)
+			, Data(InData)
+			, Size(InSize)
+			, bWritable(bInWritable)
+		{}
+
+		virtual ~FSpoutWindowsSharedMemoryRegion() override
+		{
+			UnmapViewOfFile(Data);
+			CloseHandle(Mapping);
+		}
+
+		virtual uint8* GetData() const override { return Data; }
+		virtual SIZE_T GetSize() const override { return Size; }
+		virtual bool IsWritable() const override { return bWritable; }
+
+		static TUniquePtr<ISpoutSharedMemoryRegion> Map(HANDLE Mapping, SIZE_T Size, bool bWritable)
+		{
+			if (!Mapping)
+				return nullptr;
+
+			void* View = MapViewOfFile(Mapping, bWritable ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, Size);
+			if (!View)
+			{
+				CloseHandle(Mapping);
+				return nullptr;
+			}
+			return MakeUnique<FSpoutWindowsSharedMemoryRegion>(Mapping, static_cast<uint8*>(View), Size, bWritable);
+		}
+
+	private:
+		HANDLE Mapping;
+		uint8* Data;
+		SIZE_T Size;
+		bool bWritable;
+	};
+#else
+	class FSpoutPosixSharedMemoryRegion final : public ISpoutSharedMemoryRegion
+	{
+	public:
+		FSpoutPosixSharedMemoryRegion(uint8* InData, SIZE_T InSize, bool bInWritable)
+			: Data(InData)
+			, Size(InSize)
+			, bWritable(bInWritable)
+		{}
+
+		virtual ~FSpoutPosixSharedMemoryRegion() override
+		{
+			munmap(Data, Size);
+		}
+
+		virtual uint8* GetData() const override { return Data; }
+		virtual SIZE_T GetSize() const override { return Size; }
+		virtual bool IsWritable() const override { return bWritable; }
+
+		/** Takes ownership of Fd; the mapping stays valid after it is closed. */
+		static TUniquePtr<ISpoutSharedMemoryRegion> Map(int Fd, SIZE_T Size, bool bWritable)
+		{
+			if (Fd < 0)
+				return nullptr;
+
+			struct stat Stat;
+			if (fstat(Fd, &Stat) != 0 || static_cast<SIZE_T>(Stat.st_size) < Size)
+			{
+				close(Fd);
+				return nullptr;
+			}
+
+			void* View = mmap(nullptr, Size, bWritable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, Fd, 0);
+			close(Fd);
+			if (View == MAP_FAILED)
+				return nullptr;
+
+			return MakeUnique<FSpoutPosixSharedMemoryRegion>(static_cast<uint8*>(View), Size, bWritable);
+		}
+
+		/** POSIX shared memory names are a single path component starting with '/'. */
+		static std::string MakeName(const ANSICHAR* Name)
+		{
+			return std::string("/") + Name;
+		}
+
+	private:
+		uint8* Data;
+		SIZE_T Size;
+		bool bWritable;
+	};
+#endif
+}
+
+TUniquePtr<ISpoutSharedMemoryRegion> SpoutSharedMemory::Open(const ANSICHAR* Name, SIZE_T Size, ESpoutSharedMemoryAccess Access)
+{
+	if (!Name || !Name[0] || Size == 0)
+		return nullptr;
+
+	const bool bWritable = Access == ESpoutSharedMemoryAccess::ReadWrite;
+
+#if PLATFORM_WINDOWS
+	HANDLE Mapping = OpenFileMappingA(bWritable ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, FALSE, Name);
+	return FSpoutWindowsSharedMemoryRegion::Map(Mapping, Size, bWritable);
+#else
+	const int Fd = shm_open(FSpoutPosixSharedMemoryRegion::MakeName(Name).c_str(), bWritable ? O_RDWR : O_RDONLY, 0);
+	return FSpoutPosixSharedMemoryRegion::Map(Fd, Size, bWritable);
+#endif
+}
+
+TUniquePtr<ISpoutSharedMemoryRegion> SpoutSharedMemory::Create(const ANSICHAR* Name, SIZE_T Size)
+{
+	if (!Name || !Name[0] || Size == 0)
+		return nullptr;
+
+#if PLATFORM_WINDOWS
+	// Page-file backed mappings start zero-filled; an existing one is simply opened.
+	HANDLE Mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+		static_cast<DWORD>(static_cast<uint64>(Size) >> 32), static_cast<DWORD>(Size), Name);
+	return FSpoutWindowsSharedMemoryRegion::Map(Mapping, Size, true);
+#else
+	const std::string PosixName = FSpoutPosixSharedMemoryRegion::MakeName(Name);
+	const int Fd = shm_open(PosixName.c_str(), O_RDWR | O_CREAT, 0666);
+	if (Fd < 0)
+		return nullptr;
+
+	// ftruncate zero-fills; only grow, so an existing region keeps its contents.
+	struct stat Stat;
+	if (fstat(Fd, &Stat) != 0
+		|| (static_cast<SIZE_T>(Stat.st_size) < Size && ftruncate(Fd, static_cast<off_t>(Size)) != 0))
+	{
+		close(Fd);
+		return nullptr;
+	}
+	return FSpoutPosixSharedMemoryRegion::Map(Fd, Size, true);
+#endif
+}
+
+void SpoutSharedMemory::Remove(const ANSICHAR* Name)
+{
+	if (!Name || !Name[0])
+		return;
+
+#if !PLATFORM_WINDOWS
+	shm_unlink(FSpoutPosixSharedMemoryRegion::MakeName(Name).c_str());
+#endif
+}
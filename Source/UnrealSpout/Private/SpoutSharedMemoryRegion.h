@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * A named block of memory shared between processes, mapped for the lifetime of the
+ * object. Backed by a Win32 file mapping, or by POSIX shm_open where Windows is not
+ * available, so code written against it can run on either.
+ *
+ * The region provides no locking; callers that need consistency across fields build
+ * it on top (atomics, seqlocks).
+ */
+class ISpoutSharedMemoryRegion
+{
+public:
+	virtual ~ISpoutSharedMemoryRegion() = default;
+
+	virtual uint8* GetData() const = 0;
+	virtual SIZE_T GetSize() const = 0;
+	virtual bool IsWritable() const = 0;
+};
+
+enum class ESpoutSharedMemoryAccess : uint8
+{
+	ReadOnly,
+	ReadWrite,
+};
+
+namespace SpoutSharedMemory
+{
+	/** Maps an existing region, or returns null if nobody has created it (yet). */
+	TUniquePtr<ISpoutSharedMemoryRegion> Open(const ANSICHAR* Name, SIZE_T Size, ESpoutSharedMemoryAccess Access);
+
+	/** Creates the region, or maps it if another process already did. New regions are zero-filled. */
+	TUniquePtr<ISpoutSharedMemoryRegion> Create(const ANSICHAR* Name, SIZE_T Size);
+
+	/**
+	 * Drops the name so the region goes away once everyone has unmapped it. Needed for
+	 * POSIX, where regions otherwise outlive every process; a no-op on Windows, where
+	 * the last handle closing frees the mapping.
+	 */
+	void Remove(const ANSICHAR* Name);
+}
@@ -0,0 +1,142 @@
+#include "SpoutSharedTexturePool.h"
+
+#include "HAL/PlatformTime.h"
+
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include "Spout.h"
+#include "Windows/HideWindowsPlatformTypes.h"
+
+#include "SpoutStats.h"
+
+namespace
+{
+	uint64 NowMs()
+	{
+		return static_cast<uint64>(FPlatformTime::Seconds() * 1000.0);
+	}
+
+	void ReleaseTexture(FSpoutSharedTexture& Texture)
+	{
+		if (Texture.Texture)
+			Texture.Texture->Release();
+
+		Texture.Texture = nullptr;
+		Texture.Handle = nullptr;
+		Texture.NativeRHI.SafeRelease();
+	}
+}
+
+FSpoutSharedTexturePool& FSpoutSharedTexturePool::Get()
+{
+	static FSpoutSharedTexturePool Instance;
+	return Instance;
+}
+
+FSpoutSharedTexturePool::FSpoutSharedTexturePool()
+	: Pool(MaxIdle, MaxIdleMs, [](const FKey&, FSpoutSharedTexture& Texture) { ReleaseTexture(Texture); })
+{
+}
+
+bool FSpoutSharedTexturePool::Acquire(const FKey& Key, FSpoutSharedTexture& Out)
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (Pool.Acquire(Key, Out))
+		{
+			INC_DWORD_STAT(STAT_SpoutPoolHits);
+			return true;
+		}
+	}
+
+	INC_DWORD_STAT(STAT_SpoutPoolMisses);
+
+	spoutDirectX sdx;
+	HANDLE Handle = nullptr;
+	ID3D11Texture2D* Texture = nullptr;
+	if (!sdx.CreateSharedDX11Texture(Key.Device, Key.Width, Key.Height, static_cast<DXGI_FORMAT>(Key.Format), &Texture, Handle))
+		return false;
+
+	Out.Handle = Handle;
+	Out.Texture = Texture;
+	Out.NativeRHI.SafeRelease();
+	return true;
+}
+
+void FSpoutSharedTexturePool::Release(const FKey& Key, FSpoutSharedTexture&& Texture)
+{
+	FScopeLock ScopeLock(&Lock);
+	Pool.Release(Key, MoveTemp(Texture), NowMs());
+	Texture = FSpoutSharedTexture();
+}
+
+void FSpoutSharedTexturePool::ReleaseWhenIdle(const FKey& Key, TArray<FSpoutSharedTexture>&& Textures, TFunction<bool()> IsIdle)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	FRetiring& Entry = Retiring.AddDefaulted_GetRef();
+	Entry.Key = Key;
+	Entry.Textures = MoveTemp(Textures);
+	Entry.IsIdle = MoveTemp(IsIdle);
+	Entry.ReleasedAt = NowMs();
+}
+
+void FSpoutSharedTexturePool::PoolIdle_RenderThread()
+{
+	check(IsInRenderingThread());
+
+	// Polled outside the lock: IsIdle may ask the GPU.
+	TArray<FRetiring> Candidates;
+	{
+		FScopeLock ScopeLock(&Lock);
+		Candidates = MoveTemp(Retiring);
+	}
+
+	const uint64 Now = NowMs();
+	TArray<FRetiring> StillBusy;
+	for (FRetiring& Entry : Candidates)
+	{
+		if (!Entry.IsIdle || Entry.IsIdle())
+		{
+			for (FSpoutSharedTexture& Texture : Entry.Textures)
+				Release(Entry.Key, MoveTemp(Texture));
+		}
+		// Never finished (device removed, say): too risky to hand out, so let it go.
+		else if (Now - Entry.ReleasedAt > MaxIdleMs)
+		{
+			for (FSpoutSharedTexture& Texture : Entry.Textures)
+				ReleaseTexture(Texture);
+		}
+		else
+		{
+			StillBusy.Add(MoveTemp(Entry));
+		}
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	Retiring.Append(MoveTemp(StillBusy));
+}
+
+bool FSpoutSharedTexturePool::HasRetiring()
+{
+	FScopeLock ScopeLock(&Lock);
+	return Retiring.Num() > 0;
+}
+
+void FSpoutSharedTexturePool::Trim()
+{
+	FScopeLock ScopeLock(&Lock);
+	Pool.Trim(NowMs());
+}
+
+void FSpoutSharedTexturePool::Empty()
+{
+	FScopeLock ScopeLock(&Lock);
+	Pool.Empty();
+
+	for (FRetiring& Entry : Retiring)
+	{
+		for (FSpoutSharedTexture& Texture : Entry.Textures)
+			ReleaseTexture(Texture);
+	}
+	Retiring.Empty();
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RHIResources.h"
+#include "Misc/ScopeLock.h"
+
+#include "SpoutResourcePool.h"
+
+struct ID3D11Device;
+struct ID3D11Texture2D;
+
+/** A DX11 shared texture a sender publishes, with its share handle. */
+struct FSpoutSharedTexture
+{
+	void* Handle = nullptr;
+	ID3D11Texture2D* Texture = nullptr;
+	/** NativeD3D12 path: the same texture opened on the RHI's D3D12 device. Kept while pooled. */
+	FTextureRHIRef NativeRHI;
+};
+
+/**
+ * Process-wide pool of DX11 shared textures, so a sender recreated at a size and format
+ * it used before (window resize back and forth, source swap) reuses its textures and
+ * share handles instead of allocating new ones. The device is part of the key; a pooled
+ * texture keeps its device alive until it is evicted.
+ *
+ * So is the sender name: receivers in other processes may still hold a published handle,
+ * so it only ever comes back under the name they opened it for. Textures handed back wait
+ * until the GPU has finished writing them before anyone can take them again.
+ *
+ * Thread safe: sender contexts are destroyed on whichever thread drops them last.
+ */
+class FSpoutSharedTexturePool
+{
+public:
+	struct FKey
+	{
+		ID3D11Device* Device = nullptr;
+		uint32 Width = 0;
+		uint32 Height = 0;
+		/** Typed DXGI_FORMAT */
+		uint32 Format = 0;
+		/** Sender the textures were published under. */
+		FName Name;
+
+		bool operator==(const FKey& Other) const
+		{
+			return Device == Other.Device && Width == Other.Width && Height == Other.Height && Format == Other.Format && Name == Other.Name;
+		}
+	};
+
+	/** Idle textures kept, and how long (ms) one may stay idle. */
+	static constexpr int32 MaxIdle = 8;
+	static constexpr uint64 MaxIdleMs = 10000;
+
+	static FSpoutSharedTexturePool& Get();
+
+	/** A pooled texture for Key, or a new one. False if the texture could not be created. */
+	bool Acquire(const FKey& Key, FSpoutSharedTexture& Out);
+
+	/** Hands a texture from Acquire back that the GPU is done with. Any thread. */
+	void Release(const FKey& Key, FSpoutSharedTexture&& Texture);
+
+	/**
+	 * Hands textures from Acquire back once IsIdle, polled on the render thread, says the GPU
+	 * has finished with them; nobody can take them before. Any thread.
+	 */
+	void ReleaseWhenIdle(const FKey& Key, TArray<FSpoutSharedTexture>&& Textures, TFunction<bool()> IsIdle);
+
+	/** Pools the textures from ReleaseWhenIdle that have gone idle; drops those still busy after MaxIdleMs. Render thread. */
+	void PoolIdle_RenderThread();
+
+	/** Whether textures from ReleaseWhenIdle are still waiting for the GPU. Any thread. */
+	bool HasRetiring();
+
+	/** Releases textures idle for longer than MaxIdleMs. */
+	void Trim();
+
+	/** Releases every idle and waiting texture, e.g. on module shutdown. */
+	void Empty();
+
+private:
+	FSpoutSharedTexturePool();
+
+	struct FRetiring
+	{
+		FKey Key;
+		TArray<FSpoutSharedTexture> Textures;
+		TFunction<bool()> IsIdle;
+		uint64 ReleasedAt = 0;
+	};
+
+	FCriticalSection Lock;
+	TSpoutResourcePool<FKey, FSpoutSharedTexture> Pool;
+	TArray<FRetiring> Retiring;
+};
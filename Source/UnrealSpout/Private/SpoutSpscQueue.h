@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <atomic>
+
+/**
+ * Bounded single-producer / single-consumer queue. Lock free and allocation free after
+ * construction: Enqueue fails rather than grows when the consumer falls behind, so the
+ * producer (typically the render thread) never waits.
+ *
+ * Exactly one thread may call Enqueue and one (possibly different) thread Dequeue.
+ */
+template <typename T>
+class TSpoutSpscQueue
+{
+public:
+	/** Capacity is rounded up to a power of two. */
+	explicit TSpoutSpscQueue(uint32 InCapacity)
+		: Capacity(FMath::RoundUpToPowerOfTwo(FMath::Max(InCapacity, 2u)))
+		, Mask(Capacity - 1)
+	{
+		Items.SetNum(Capacity);
+	}
+
+	/** Producer only. False, leaving Item untouched, when the queue is full. */
+	bool Enqueue(T&& Item)
+	{
+		const uint64 Tail = TailIndex.load(std::memory_order_relaxed);
+		if (Tail - HeadIndex.load(std::memory_order_acquire) >= Capacity)
+			return false;
+
+		Items[Tail & Mask] = MoveTemp(Item);
+		TailIndex.store(Tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/** Consumer only. False when the queue is empty. */
+	bool Dequeue(T& OutItem)
+	{
+		const uint64 Head = HeadIndex.load(std::memory_order_relaxed);
+		if (Head == TailIndex.load(std::memory_order_acquire))
+			return false;
+
+		OutItem = MoveTemp(Items[Head & Mask]);
+		Items[Head & Mask] = T();
+		HeadIndex.store(Head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/** Snapshot; exact only on the producer or consumer thread while the other is idle. */
+	uint32 Num() const
+	{
+		return static_cast<uint32>(TailIndex.load(std::memory_order_acquire) - HeadIndex.load(std::memory_order_acquire));
+	}
+
+	uint32 GetCapacity() const { return Capacity; }
+
+private:
+	const uint32 Capacity;
+	const uint64 Mask;
+	TArray<T> Items;
+
+	// Separate cache lines so producer and consumer do not false-share.
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> HeadIndex { 0 };
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> TailIndex { 0 };
+};
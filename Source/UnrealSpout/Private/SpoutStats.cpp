@@ -0,0 +1,25 @@
+#include "SpoutStats.h"
+
+DEFINE_STAT(STAT_SpoutBatch);
+DEFINE_STAT(STAT_SpoutStreams);
+DEFINE_STAT(STAT_SpoutSubmits);
+DEFINE_STAT(STAT_SpoutCapturesDue);
+DEFINE_STAT(STAT_SpoutCaptures);
+DEFINE_STAT(STAT_SpoutWrappedCalls);
+DEFINE_STAT(STAT_SpoutWrappedTransitions);
+DEFINE_STAT(STAT_SpoutInteropFlushes);
+
+DEFINE_STAT(STAT_SpoutTextureCacheHits);
+DEFINE_STAT(STAT_SpoutTextureCacheMisses);
+DEFINE_STAT(STAT_SpoutTextureCacheEvictions);
+DEFINE_STAT(STAT_SpoutReceiverReallocations);
+DEFINE_STAT(STAT_SpoutReadbackFrames);
+DEFINE_STAT(STAT_SpoutReadbackDropped);
+DEFINE_STAT(STAT_SpoutPoolHits);
+DEFINE_STAT(STAT_SpoutPoolMisses);
+DEFINE_STAT(STAT_SpoutMemoryShareFrames);
+DEFINE_STAT(STAT_SpoutMemoryShareTorn);
+DEFINE_STAT(STAT_SpoutSenderRecordRetries);
+DEFINE_STAT(STAT_SpoutSenderRecordFallbacks);
+DEFINE_STAT(STAT_SpoutReceiveWorkerFrames);
+DEFINE_STAT(STAT_SpoutReceiveWorkerIdleWakeups);
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("Spout"), STATGROUP_Spout, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Batch (render thread)"), STAT_SpoutBatch, STATGROUP_Spout, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Streams per frame"), STAT_SpoutStreams, STATGROUP_Spout, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Submits per frame"), STAT_SpoutSubmits, STATGROUP_Spout, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Scheduled captures due per frame"), STAT_SpoutCapturesDue, STATGROUP_Spout, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Scheduled captures run per frame"), STAT_SpoutCaptures, STATGROUP_Spout, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Wrapped resource acquire/release calls per frame"), STAT_SpoutWrappedCalls, STATGROUP_Spout, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Wrapped resource transitions per frame"), STAT_SpoutWrappedTransitions, STATGROUP_Spout, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("11on12 flushes per frame"), STAT_SpoutInteropFlushes, STATGROUP_Spout, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Shared texture cache hits"), STAT_SpoutTextureCacheHits, STATGROUP_Spout, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Shared texture cache misses"), STAT_SpoutTextureCacheMisses, STATGROUP_Spout, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Shared texture cache evictions"), STAT_SpoutTextureCacheEvictions, STATGROUP_Spout, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Receiver reallocations"), STAT_SpoutReceiverReallocations, STATGROUP_Spout, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Readback frames delivered"), STAT_SpoutReadbackFrames, STATGROUP_Spout, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Readback frames dropped"), STAT_SpoutReadbackDropped, STATGROUP_Spout, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Resource pool hits"), STAT_SpoutPoolHits, STATGROUP_Spout, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Resource pool misses"), STAT_SpoutPoolMisses, STATGROUP_Spout, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Memory-share frames published"), STAT_SpoutMemoryShareFrames, STATGROUP_Spout, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Memory-share frames overwritten while read"), STAT_SpoutMemoryShareTorn, STATGROUP_Spout, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Sender record reads retried"), STAT_SpoutSenderRecordRetries, STATGROUP_Spout, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Sender record fallbacks to FindSender"), STAT_SpoutSenderRecordFallbacks, STATGROUP_Spout, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Frames staged by receive workers"), STAT_SpoutReceiveWorkerFrames, STATGROUP_Spout, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Receive worker wake-ups without a new frame"), STAT_SpoutReceiveWorkerIdleWakeups, STATGROUP_Spout, );
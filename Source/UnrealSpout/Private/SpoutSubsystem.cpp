@@ -0,0 +1,170 @@
+#include "SpoutSubsystem.h"
+
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "RenderingThread.h"
+
+#include "SpoutBatch.h"
+#include "SpoutCaptureScheduler.h"
+#include "SpoutConsumerTable.h"
+#include "SpoutRenderTargetPool.h"
+#include "SpoutSenderDirectory.h"
+#include "SpoutSenderRegistry.h"
+#include "SpoutSharedTexturePool.h"
+#include "SpoutStats.h"
+
+static TAutoConsoleVariable<int32> CVarSpoutMaxCapturesPerFrame(
+	TEXT("Spout.MaxCapturesPerFrame"),
+	0,
+	TEXT("Most scheduled Spout captures allowed in one frame; the rest wait for later frames. 0 = no limit."),
+	ECVF_Default);
+
+USpoutSubsystem* USpoutSubsystem::Get()
+{
+	return GEngine ? GEngine->GetEngineSubsystem<USpoutSubsystem>() : nullptr;
+}
+
+void USpoutSubsystem::QueueStream(const TSharedRef<ISpoutStream, ESPMode::ThreadSafe>& Stream)
+{
+	check(IsInGameThread());
+	PendingStreams.AddUnique(Stream);
+}
+
+int32 USpoutSubsystem::RegisterCapture(const FSpoutCaptureSettings& Settings)
+{
+	check(IsInGameThread());
+	if (!CaptureScheduler)
+		CaptureScheduler = MakeShared<FSpoutCaptureScheduler>();
+
+	return CaptureScheduler->Add(Settings);
+}
+
+void USpoutSubsystem::UpdateCapture(int32 Handle, const FSpoutCaptureSettings& Settings)
+{
+	check(IsInGameThread());
+	if (CaptureScheduler)
+		CaptureScheduler->Update(Handle, Settings);
+}
+
+void USpoutSubsystem::UnregisterCapture(int32 Handle)
+{
+	check(IsInGameThread());
+	if (CaptureScheduler)
+		CaptureScheduler->Remove(Handle);
+}
+
+bool USpoutSubsystem::ShouldCapture(int32 Handle)
+{
+	check(IsInGameThread());
+	if (!CaptureScheduler)
+		return false;
+
+	// Senders tick before the subsystem, so the frame is scheduled on its first query.
+	if (ScheduledFrame != GFrameCounter)
+	{
+		ScheduledFrame = GFrameCounter;
+		CaptureScheduler->BeginFrame(GFrameCounter, FPlatformTime::Seconds(), CVarSpoutMaxCapturesPerFrame.GetValueOnGameThread());
+
+		SET_DWORD_STAT(STAT_SpoutCapturesDue, CaptureScheduler->GetNumDue());
+		SET_DWORD_STAT(STAT_SpoutCaptures, CaptureScheduler->GetNumCaptures());
+	}
+
+	return CaptureScheduler->ShouldCapture(Handle);
+}
+
+UTextureRenderTarget2D* USpoutSubsystem::AcquireRenderTarget(const FIntPoint& Size, EPixelFormat Format)
+{
+	if (!RenderTargetPool)
+		RenderTargetPool = MakeShared<FSpoutRenderTargetPool>();
+
+	return RenderTargetPool->Acquire(Size, Format);
+}
+
+void USpoutSubsystem::ReleaseRenderTarget(UTextureRenderTarget2D* RenderTarget)
+{
+	if (RenderTargetPool)
+		RenderTargetPool->Release(RenderTarget);
+}
+
+TArray<FName> USpoutSubsystem::GetSenderNames()
+{
+	FSpoutSenderDirectory* Directory = FSpoutSenderDirectory::Get();
+	if (!Directory)
+		return {};
+
+	if (Directory->GetGeneration() != SenderNamesGeneration)
+	{
+		const FSpoutSenderDirectory::FSnapshot Snapshot = Directory->TakeSnapshot();
+		SenderNames.Reset(Snapshot.Num());
+		for (const FString& Name : Snapshot)
+			SenderNames.Add(FName(*Name));
+		SenderNamesGeneration = Snapshot.Generation;
+	}
+	return SenderNames;
+}
+
+void USpoutSubsystem::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	USpoutSubsystem* This = CastChecked<USpoutSubsystem>(InThis);
+	if (This->RenderTargetPool)
+		This->RenderTargetPool->AddReferencedObjects(Collector);
+
+	Super::AddReferencedObjects(InThis, Collector);
+}
+
+void USpoutSubsystem::Deinitialize()
+{
+	FlushBatch();
+	if (RenderTargetPool)
+		RenderTargetPool->Empty();
+	Super::Deinitialize();
+}
+
+void USpoutSubsystem::Tick(float DeltaTime)
+{
+	FlushBatch();
+
+	if (RenderTargetPool)
+		RenderTargetPool->Trim();
+	FSpoutSharedTexturePool::Get().Trim();
+
+	// Slots of senders that went away return to the pool once the GPU has finished with them.
+	if (FSpoutSharedTexturePool::Get().HasRetiring())
+	{
+		ENQUEUE_RENDER_COMMAND(SpoutPoolIdleSlots)([](FRHICommandListImmediate&) {
+			FSpoutSharedTexturePool::Get().PoolIdle_RenderThread();
+		});
+	}
+
+	// Keeps our senders listed and drops those of processes that died.
+	FSpoutSenderRegistry::Get().Tick(FSpoutConsumerTable::NowMs());
+}
+
+TStatId USpoutSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USpoutSubsystem, STATGROUP_Tickables);
+}
+
+void USpoutSubsystem::FlushBatch()
+{
+	const int32 NumStreams = PendingStreams.Num();
+	if (NumStreams == 0)
+		return;
+
+	// The render command keeps the contexts alive until it has run, even if their
+	// components are destroyed in the meantime.
+	ENQUEUE_RENDER_COMMAND(SpoutBatchRenderThreadOp)(
+		[Streams = MoveTemp(PendingStreams)](FRHICommandListImmediate& RHICmdList) {
+		SCOPE_CYCLE_COUNTER(STAT_SpoutBatch);
+
+		FSpoutFrameBatch Batch(&RHICmdList);
+		Batch.Execute(Streams);
+
+		SET_DWORD_STAT(STAT_SpoutStreams, Batch.GetNumStreams());
+		SET_DWORD_STAT(STAT_SpoutSubmits, Batch.GetNumSubmits());
+	});
+
+	// Size next frame's queue up front instead of growing it one stream at a time.
+	PendingStreams.Reserve(NumStreams);
+}
@@ -0,0 +1,99 @@
+#include "SpoutTextureRing.h"
+
+FSpoutTextureRing::FSpoutTextureRing(int32 InNumSlots)
+	: NumSlots(FMath::Clamp(InNumSlots, MinSlots, MaxSlots))
+{
+	for (int32 i = 0; i < MaxSlots; ++i)
+	{
+		States[i] = ESlotState::Free;
+		LastPublished[i] = 0;
+		PendingFrame[i] = 0;
+	}
+}
+
+int32 FSpoutTextureRing::BeginWrite()
+{
+	if (WritingSlot != INDEX_NONE)
+		return INDEX_NONE;
+
+	int32 Best = INDEX_NONE;
+	for (int32 i = 0; i < NumSlots; ++i)
+	{
+		if (States[i] != ESlotState::Free)
+			continue;
+
+		if (Best == INDEX_NONE || LastPublished[i] < LastPublished[Best])
+			Best = i;
+	}
+
+	if (Best != INDEX_NONE)
+	{
+		States[Best] = ESlotState::Writing;
+		WritingSlot = Best;
+	}
+	return Best;
+}
+
+void FSpoutTextureRing::EndWrite(int32 Slot, uint64 Frame)
+{
+	check(Slot == WritingSlot && States[Slot] == ESlotState::Writing);
+
+	States[Slot] = ESlotState::Pending;
+	PendingFrame[Slot] = Frame;
+	WritingSlot = INDEX_NONE;
+}
+
+int32 FSpoutTextureRing::Retire(uint64 CompletedFrame)
+{
+	int32 Newest = INDEX_NONE;
+	for (int32 i = 0; i < NumSlots; ++i)
+	{
+		if (States[i] != ESlotState::Pending || PendingFrame[i] > CompletedFrame)
+			continue;
+
+		if (Newest == INDEX_NONE || PendingFrame[i] > PendingFrame[Newest])
+			Newest = i;
+	}
+
+	if (Newest == INDEX_NONE)
+		return INDEX_NONE;
+
+	// Older completed frames were superseded before anyone could see them.
+	for (int32 i = 0; i < NumSlots; ++i)
+	{
+		if (i != Newest && States[i] == ESlotState::Pending && PendingFrame[i] <= PendingFrame[Newest])
+			States[i] = ESlotState::Free;
+	}
+
+	const int32 Previous = PublishedSlot.load(std::memory_order_relaxed);
+	if (Previous != INDEX_NONE)
+		States[Previous] = ESlotState::Free;
+
+	const uint64 Count = PublishCount.load(std::memory_order_relaxed) + 1;
+	States[Newest] = ESlotState::Published;
+	LastPublished[Newest] = Count;
+
+	PublishedSlot.store(Newest, std::memory_order_release);
+	PublishCount.store(Count, std::memory_order_release);
+	return Newest;
+}
+
+void FSpoutTextureRing::AbortWrite(int32 Slot)
+{
+	check(Slot == WritingSlot && States[Slot] == ESlotState::Writing);
+
+	States[Slot] = ESlotState::Free;
+	WritingSlot = INDEX_NONE;
+}
+
+FSpoutTextureRing::ESlotState FSpoutTextureRing::GetSlotState(int32 Slot) const
+{
+	check(Slot >= 0 && Slot < NumSlots);
+	return States[Slot];
+}
+
+uint64 FSpoutTextureRing::GetSlotFrame(int32 Slot) const
+{
+	check(Slot >= 0 && Slot < NumSlots);
+	return PendingFrame[Slot];
+}
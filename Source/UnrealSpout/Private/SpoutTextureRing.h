@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <atomic>
+
+/**
+ * Slot-selection / ownership state machine for a sender's ring of shared textures.
+ *
+ * Only tracks indices, so it carries no graphics types: the owner keeps one texture
+ * per slot and asks the ring which one to write next and which one is safe to publish.
+ * The producer always writes to a slot other than the published one, so a receiver
+ * that has just opened the published handle is never written over mid-copy.
+ *
+ * A finished write is Pending until the GPU reports its frame complete; Retire()
+ * then publishes the newest completed slot. When every slot is pending or published
+ * BeginWrite fails and the producer drops the frame instead of waiting on the GPU.
+ *
+ * BeginWrite/EndWrite/AbortWrite/Retire are called from a single producer thread (the
+ * render thread); GetPublishedSlot/GetPublishCount may be read from any thread.
+ */
+class FSpoutTextureRing
+{
+public:
+	static constexpr int32 MinSlots = 2;
+	static constexpr int32 MaxSlots = 4;
+
+	enum class ESlotState : uint8
+	{
+		Free,		// Available to the producer
+		Writing,	// Producer is copying into it
+		Pending,	// Copy queued, waiting for the GPU to finish its frame
+		Published,	// Latest complete frame, advertised to receivers
+	};
+
+	explicit FSpoutTextureRing(int32 InNumSlots = 3);
+
+	int32 Num() const { return NumSlots; }
+
+	/** Claims the least recently published free slot. Returns INDEX_NONE if a write is in progress or no slot is free. */
+	int32 BeginWrite();
+
+	/** Marks the copy into the slot as queued; it becomes publishable once Frame completes. */
+	void EndWrite(int32 Slot, uint64 Frame);
+
+	/** Returns a slot claimed by BeginWrite to the free list without publishing it. */
+	void AbortWrite(int32 Slot);
+
+	/**
+	 * Publishes the newest pending slot whose frame is <= CompletedFrame and frees the
+	 * slot it replaces, along with any older pending slots. Returns the newly published
+	 * slot, or INDEX_NONE if nothing changed.
+	 */
+	int32 Retire(uint64 CompletedFrame);
+
+	/** Latest complete slot, or INDEX_NONE before the first publish. */
+	int32 GetPublishedSlot() const { return PublishedSlot.load(std::memory_order_acquire); }
+
+	/** Number of frames published so far. */
+	uint64 GetPublishCount() const { return PublishCount.load(std::memory_order_acquire); }
+
+	ESlotState GetSlotState(int32 Slot) const;
+
+	/** Frame number last written into the slot. */
+	uint64 GetSlotFrame(int32 Slot) const;
+
+private:
+	int32 NumSlots = 0;
+	int32 WritingSlot = INDEX_NONE;
+
+	ESlotState States[MaxSlots];
+	/** Publish count at which each slot was last published, used to pick the oldest free slot. */
+	uint64 LastPublished[MaxSlots];
+	/** Frame number each slot was last written with; pending slots wait on it. */
+	uint64 PendingFrame[MaxSlots];
+
+	std::atomic<int32> PublishedSlot { INDEX_NONE };
+	std::atomic<uint64> PublishCount { 0 };
+};
@@ -0,0 +1,105 @@
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/OutputDevice.h"
+
+#include "SpoutFrameSync.h"
+#include "SpoutTextureRing.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace
+{
+	/** Longest GPU latency tried, in ticks between a copy being signalled and completing. */
+	constexpr int32 MaxLatency = 3;
+
+	struct FRingRun
+	{
+		uint64 Sent = 0;
+		uint64 Skipped = 0;
+		uint64 Published = 0;
+		/** Writes into the published slot, publishes of incomplete or older frames. */
+		int32 Errors = 0;
+	};
+
+	/**
+	 * One sender tick as the render thread runs it: retire what the GPU finished, then copy
+	 * into a new slot. The scripted sync completes each frame Latency ticks (give or take
+	 * one, at random) after it was signalled, and never out of order.
+	 */
+	FRingRun RunRing(int32 NumSlots, int32 Latency, int32 Ticks)
+	{
+		FSpoutTextureRing Ring(NumSlots);
+		FSpoutScriptedFrameSync Sync;
+		FRandomStream Random(NumSlots * 16 + Latency);
+		TArray<uint64> SignalledAt;
+		uint64 LastPublishedFrame = 0;
+		FRingRun Run;
+
+		for (int32 Tick = 0; Tick < Ticks; ++Tick)
+		{
+			const int32 Delay = FMath::Max(0, Latency + Random.RandRange(-1, 1));
+			for (int32 Frame = SignalledAt.Num(); Frame > 0; --Frame)
+			{
+				if (Tick - static_cast<int32>(SignalledAt[Frame - 1]) >= Delay)
+				{
+					Sync.Complete(Frame);
+					break;
+				}
+			}
+
+			const uint64 Completed = Sync.GetCompletedFrame();
+			const int32 Retired = Ring.Retire(Completed);
+			if (Retired != INDEX_NONE)
+			{
+				const uint64 Frame = Ring.GetSlotFrame(Retired);
+				Run.Errors += Frame > Completed || Frame <= LastPublishedFrame ? 1 : 0;
+				LastPublishedFrame = Frame;
+				++Run.Published;
+			}
+
+			const int32 Slot = Ring.BeginWrite();
+			if (Slot == INDEX_NONE)
+			{
+				++Run.Skipped;
+				continue;
+			}
+
+			Run.Errors += Slot == Ring.GetPublishedSlot() ? 1 : 0;
+
+			const uint64 Frame = Sync.GetLastSignalled() + 1;
+			Ring.EndWrite(Slot, Frame);
+			Sync.Signal(Frame);
+			SignalledAt.Add(Tick);
+			++Run.Sent;
+		}
+		return Run;
+	}
+
+	void BenchmarkTextureRing(const TArray<FString>& Args, FOutputDevice& Ar)
+	{
+		const int32 Ticks = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100000;
+
+		for (int32 NumSlots = FSpoutTextureRing::MinSlots; NumSlots <= FSpoutTextureRing::MaxSlots; ++NumSlots)
+		{
+			for (int32 Latency = 0; Latency <= MaxLatency; ++Latency)
+			{
+				const double Start = FPlatformTime::Seconds();
+				const FRingRun Run = RunRing(NumSlots, Latency, Ticks);
+				const double Elapsed = FPlatformTime::Seconds() - Start;
+
+				Ar.Logf(TEXT("  %d slots  latency %d  sent %6.2f%%  skipped %6.2f%%  published %6.2f%%  %5.1f ns/tick  errors %d"),
+					NumSlots, Latency, 100.0 * Run.Sent / Ticks, 100.0 * Run.Skipped / Ticks, 100.0 * Run.Published / Ticks,
+					Elapsed / Ticks * 1.0e9, Run.Errors);
+			}
+		}
+	}
+
+	FAutoConsoleCommandWithArgsAndOutputDevice BenchmarkTextureRingCommand(
+		TEXT("Spout.BenchmarkTextureRing"),
+		TEXT("Drives a sender's texture ring through a scripted GPU fence at 0..3 ticks of latency, for every ring size, checks that only completed frames are published, in order, and never written over, and reports how many frames get skipped. Optional argument: ticks per run (default 100000)."),
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&BenchmarkTextureRing));
+}
+
+#endif
@@ -0,0 +1,127 @@
+#include "Misc/AutomationTest.h"
+#include "SpoutBatch.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** What a batch did, in order: 'P' process, 'S' submit, 'A' post-submit. */
+	struct FBatchLog
+	{
+		FString Calls;
+	};
+
+	class FStubSubmitQueue final : public ISpoutSubmitQueue
+	{
+	public:
+		explicit FStubSubmitQueue(FBatchLog& InLog)
+			: Log(InLog)
+		{}
+
+		virtual void Submit() override
+		{
+			Log.Calls.AppendChar(TEXT('S'));
+			++NumSubmits;
+		}
+
+		FBatchLog& Log;
+		int32 NumSubmits = 0;
+	};
+
+	/** Records a copy on Queue, if any, like a sender or receiver on the 11on12 path. */
+	class FStubStream final : public ISpoutStream
+	{
+	public:
+		FStubStream(FBatchLog& InLog, ISpoutSubmitQueue* InQueue)
+			: Log(InLog)
+			, Queue(InQueue)
+		{}
+
+		virtual void Process_RenderThread(FSpoutFrameBatch& Batch) override
+		{
+			Log.Calls.AppendChar(TEXT('P'));
+			Batch.RequestSubmit(Queue);
+		}
+
+		virtual void PostSubmit_RenderThread(FSpoutFrameBatch& Batch) override
+		{
+			Log.Calls.AppendChar(TEXT('A'));
+		}
+
+		FBatchLog& Log;
+		ISpoutSubmitQueue* Queue;
+	};
+
+	TArray<FSpoutStreamRef> MakeStreams(FBatchLog& Log, int32 Num, ISpoutSubmitQueue* Queue)
+	{
+		TArray<FSpoutStreamRef> Streams;
+		for (int32 i = 0; i < Num; ++i)
+			Streams.Add(MakeShared<FStubStream, ESPMode::ThreadSafe>(Log, Queue));
+		return Streams;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutFrameBatchSubmitOnceTest, "UnrealSpout.FrameBatch.SubmitOnce", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutFrameBatchSubmitOnceTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumStreams = 8;
+	constexpr int32 NumFrames = 3;
+
+	FBatchLog Log;
+	FStubSubmitQueue Queue(Log);
+	const TArray<FSpoutStreamRef> Streams = MakeStreams(Log, NumStreams, &Queue);
+
+	FSpoutFrameBatch Batch;
+	TestNull(TEXT("no command list off the render thread"), Batch.GetRHICmdList());
+
+	for (int32 Frame = 1; Frame <= NumFrames; ++Frame)
+	{
+		Log.Calls.Reset();
+		Batch.Execute(Streams);
+
+		// Every stream records, the shared queue is submitted once, then every stream publishes.
+		TestEqual(TEXT("process, one submit, post-submit"), Log.Calls, FString::ChrN(NumStreams, TEXT('P')) + TEXT("S") + FString::ChrN(NumStreams, TEXT('A')));
+		TestEqual(TEXT("one submit per batch"), Queue.NumSubmits, Frame);
+	}
+
+	TestEqual(TEXT("streams counted"), Batch.GetNumStreams(), NumStreams * NumFrames);
+	TestEqual(TEXT("submits counted"), Batch.GetNumSubmits(), NumFrames);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutFrameBatchQueuesTest, "UnrealSpout.FrameBatch.Queues", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutFrameBatchQueuesTest::RunTest(const FString& Parameters)
+{
+	FBatchLog Log;
+	FStubSubmitQueue First(Log);
+	FStubSubmitQueue Second(Log);
+
+	// Streams on two queues, and D3D11 ones that need no submit at all.
+	TArray<FSpoutStreamRef> Streams = MakeStreams(Log, 3, &First);
+	Streams.Append(MakeStreams(Log, 2, nullptr));
+	Streams.Append(MakeStreams(Log, 3, &Second));
+
+	FSpoutFrameBatch Batch;
+	Batch.Execute(Streams);
+	TestEqual(TEXT("first queue submitted once"), First.NumSubmits, 1);
+	TestEqual(TEXT("second queue submitted once"), Second.NumSubmits, 1);
+	TestEqual(TEXT("submits come after every stream recorded"), Log.Calls, FString(TEXT("PPPPPPPPSSAAAAAAAA")));
+	TestEqual(TEXT("submits counted per queue"), Batch.GetNumSubmits(), 2);
+
+	// A frame without any queue submits nothing, and earlier requests don't carry over.
+	FSpoutFrameBatch Plain;
+	Plain.Execute(MakeStreams(Log, 4, nullptr));
+	TestEqual(TEXT("nothing to submit"), Plain.GetNumSubmits(), 0);
+	Batch.Execute(MakeStreams(Log, 4, nullptr));
+	TestEqual(TEXT("requests reset between batches"), Batch.GetNumSubmits(), 2);
+	TestEqual(TEXT("no further submits"), First.NumSubmits + Second.NumSubmits, 2);
+
+	// An empty frame is a no-op.
+	Batch.Execute(TConstArrayView<FSpoutStreamRef>());
+	TestEqual(TEXT("empty batch"), Batch.GetNumStreams(), 12);
+	return true;
+}
+
+#endif
@@ -0,0 +1,196 @@
+#include "Misc/AutomationTest.h"
+#include "SpoutCaptureScheduler.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr double FrameRate = 60.0;
+
+	FSpoutCaptureSettings MakeSettings(float TargetFps, int32 EveryNth = 1, bool bAutoPhase = true, float PhaseOffset = 0.0f)
+	{
+		FSpoutCaptureSettings Settings;
+		Settings.TargetFps = TargetFps;
+		Settings.EveryNth = EveryNth;
+		Settings.bAutoPhase = bAutoPhase;
+		Settings.PhaseOffset = PhaseOffset;
+		return Settings;
+	}
+
+	/** The frames each handle captured on, over NumFrames frames of a steady 60 Hz clock. */
+	struct FScript
+	{
+		TMap<int32, TArray<uint64>> Captures;
+		int32 MaxPerFrame = 0;
+
+		void Run(FSpoutCaptureScheduler& Scheduler, const TArray<int32>& Handles, uint64 NumFrames, int32 MaxCapturesPerFrame = 0)
+		{
+			for (uint64 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				Scheduler.BeginFrame(Frame, Frame / FrameRate, MaxCapturesPerFrame);
+
+				int32 Captured = 0;
+				for (const int32 Handle : Handles)
+				{
+					if (Scheduler.ShouldCapture(Handle))
+					{
+						Captures.FindOrAdd(Handle).Add(Frame);
+						++Captured;
+					}
+				}
+				MaxPerFrame = FMath::Max(MaxPerFrame, Captured);
+			}
+		}
+
+		int32 Num(int32 Handle) const
+		{
+			const TArray<uint64>* Frames = Captures.Find(Handle);
+			return Frames ? Frames->Num() : 0;
+		}
+
+		uint64 First(int32 Handle) const
+		{
+			const TArray<uint64>* Frames = Captures.Find(Handle);
+			return Frames && Frames->Num() > 0 ? (*Frames)[0] : MAX_uint64;
+		}
+
+		/** Whether Handle captured exactly every Interval frames after its first. */
+		bool IsSteady(int32 Handle, uint64 Interval) const
+		{
+			const TArray<uint64>* Frames = Captures.Find(Handle);
+			if (!Frames)
+				return false;
+
+			for (int32 i = 1; i < Frames->Num(); ++i)
+			{
+				if ((*Frames)[i] - (*Frames)[i - 1] != Interval)
+					return false;
+			}
+			return true;
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutCaptureSchedulerCadenceTest, "UnrealSpout.CaptureScheduler.Cadence", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutCaptureSchedulerCadenceTest::RunTest(const FString& Parameters)
+{
+	FSpoutCaptureScheduler Scheduler;
+	const int32 Every = Scheduler.Add(MakeSettings(0.0f));
+	const int32 Half = Scheduler.Add(MakeSettings(30.0f, 1, false));
+	const int32 Tenth = Scheduler.Add(MakeSettings(6.0f, 1, false));
+	const int32 Third = Scheduler.Add(MakeSettings(0.0f, 3, false));
+
+	FScript Script;
+	Script.Run(Scheduler, { Every, Half, Tenth, Third }, 120);
+
+	TestEqual(TEXT("no rate captures every frame"), Script.Num(Every), 120);
+	TestEqual(TEXT("30 fps at 60 Hz"), Script.Num(Half), 60);
+	TestTrue(TEXT("30 fps every other frame"), Script.IsSteady(Half, 2));
+	TestEqual(TEXT("6 fps at 60 Hz"), Script.Num(Tenth), 12);
+	TestTrue(TEXT("6 fps every tenth frame"), Script.IsSteady(Tenth, 10));
+	TestEqual(TEXT("every third frame"), Script.Num(Third), 40);
+	TestTrue(TEXT("every third frame, steadily"), Script.IsSteady(Third, 3));
+	TestEqual(TEXT("phase 0 starts at once"), Script.First(Half), uint64(0));
+
+	// A manual phase moves the first capture by that fraction of the period.
+	FSpoutCaptureScheduler Offset;
+	const int32 Late = Offset.Add(MakeSettings(6.0f, 1, false, 0.5f));
+	FScript OffsetScript;
+	OffsetScript.Run(Offset, { Late }, 60);
+	TestEqual(TEXT("half a period in"), OffsetScript.First(Late), uint64(5));
+
+	// After a hitch the sender captures once and goes back on its grid, without a burst.
+	FSpoutCaptureScheduler Hitch;
+	const int32 Sender = Hitch.Add(MakeSettings(30.0f, 1, false));
+	Hitch.BeginFrame(0, 0.0);
+	Hitch.BeginFrame(1, 1.0 / FrameRate);
+	Hitch.BeginFrame(2, 0.5);
+	TestTrue(TEXT("captures after the hitch"), Hitch.ShouldCapture(Sender));
+	Hitch.BeginFrame(3, 0.5 + 1.0 / FrameRate);
+	TestFalse(TEXT("no catch-up capture"), Hitch.ShouldCapture(Sender));
+	Hitch.BeginFrame(4, 0.5 + 2.0 / FrameRate);
+	TestTrue(TEXT("back on the 30 fps grid"), Hitch.ShouldCapture(Sender));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutCaptureSchedulerStaggerTest, "UnrealSpout.CaptureScheduler.Stagger", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutCaptureSchedulerStaggerTest::RunTest(const FString& Parameters)
+{
+	// Three 10 fps senders at 60 Hz: auto phase puts them on different frames of the six.
+	FSpoutCaptureScheduler Scheduler;
+	const TArray<int32> Handles = { Scheduler.Add(MakeSettings(10.0f)), Scheduler.Add(MakeSettings(10.0f)), Scheduler.Add(MakeSettings(10.0f)) };
+
+	FScript Script;
+	Script.Run(Scheduler, Handles, 600);
+	TestEqual(TEXT("never two on one frame"), Script.MaxPerFrame, 1);
+	for (const int32 Handle : Handles)
+	{
+		TestEqual(TEXT("each keeps its rate"), Script.Num(Handle), 100);
+		TestTrue(TEXT("each keeps its cadence"), Script.IsSteady(Handle, 6));
+	}
+	TestEqual(TEXT("first sender at phase 0"), Script.First(Handles[0]), uint64(0));
+	TestEqual(TEXT("second sender"), Script.First(Handles[1]), uint64(4));
+	TestEqual(TEXT("third sender"), Script.First(Handles[2]), uint64(2));
+
+	// The same senders with a fixed phase all land on one frame.
+	FSpoutCaptureScheduler Fixed;
+	const TArray<int32> FixedHandles = { Fixed.Add(MakeSettings(10.0f, 1, false)), Fixed.Add(MakeSettings(10.0f, 1, false)), Fixed.Add(MakeSettings(10.0f, 1, false)) };
+	FScript FixedScript;
+	FixedScript.Run(Fixed, FixedHandles, 600);
+	TestEqual(TEXT("fixed phase stacks up"), FixedScript.MaxPerFrame, 3);
+
+	// Frame dividers are staggered too.
+	FSpoutCaptureScheduler Divided;
+	const TArray<int32> DividedHandles = { Divided.Add(MakeSettings(0.0f, 2)), Divided.Add(MakeSettings(0.0f, 2)) };
+	FScript DividedScript;
+	DividedScript.Run(Divided, DividedHandles, 100);
+	TestEqual(TEXT("alternate frames"), DividedScript.MaxPerFrame, 1);
+	TestEqual(TEXT("even frames"), DividedScript.First(DividedHandles[0]), uint64(0));
+	TestEqual(TEXT("odd frames"), DividedScript.First(DividedHandles[1]), uint64(1));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutCaptureSchedulerCapTest, "UnrealSpout.CaptureScheduler.Cap", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutCaptureSchedulerCapTest::RunTest(const FString& Parameters)
+{
+	// Four 30 fps senders on one phase, at most two captures a frame: the deferred pair goes
+	// first next frame, as the most overdue, and everyone still gets 30 fps.
+	FSpoutCaptureScheduler Scheduler;
+	TArray<int32> Handles;
+	for (int32 i = 0; i < 4; ++i)
+		Handles.Add(Scheduler.Add(MakeSettings(30.0f, 1, false)));
+
+	Scheduler.BeginFrame(0, 0.0, 2);
+	TestEqual(TEXT("all due"), Scheduler.GetNumDue(), 4);
+	TestEqual(TEXT("two let through"), Scheduler.GetNumCaptures(), 2);
+	TestTrue(TEXT("registration order breaks the tie"), Scheduler.ShouldCapture(Handles[0]) && Scheduler.ShouldCapture(Handles[1]));
+
+	Scheduler.BeginFrame(1, 1.0 / FrameRate, 2);
+	TestEqual(TEXT("only the deferred pair due"), Scheduler.GetNumDue(), 2);
+	TestTrue(TEXT("deferred pair captures"), Scheduler.ShouldCapture(Handles[2]) && Scheduler.ShouldCapture(Handles[3]));
+
+	FSpoutCaptureScheduler Capped;
+	TArray<int32> CappedHandles;
+	for (int32 i = 0; i < 4; ++i)
+		CappedHandles.Add(Capped.Add(MakeSettings(30.0f, 1, false)));
+
+	FScript Script;
+	Script.Run(Capped, CappedHandles, 120, 2);
+	TestEqual(TEXT("cap holds"), Script.MaxPerFrame, 2);
+	for (const int32 Handle : CappedHandles)
+		TestEqual(TEXT("each keeps its rate"), Script.Num(Handle), 60);
+
+	// Settings changes restart the schedule; removed senders never capture.
+	Scheduler.Update(Handles[0], MakeSettings(0.0f));
+	Scheduler.Remove(Handles[3]);
+	Scheduler.BeginFrame(200, 200 / FrameRate, 0);
+	TestTrue(TEXT("updated to every frame"), Scheduler.ShouldCapture(Handles[0]));
+	TestFalse(TEXT("removed"), Scheduler.ShouldCapture(Handles[3]));
+	TestEqual(TEXT("three left"), Scheduler.Num(), 3);
+	return true;
+}
+
+#endif
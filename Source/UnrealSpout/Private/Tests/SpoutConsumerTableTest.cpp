@@ -0,0 +1,162 @@
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/ScopeExit.h"
+
+#include "SpoutConsumerTable.h"
+#include "SpoutSharedMemoryRegion.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** A zero-filled region in this process's heap, so the table can be tested without a shared-memory name. */
+	class FHeapRegion final : public ISpoutSharedMemoryRegion
+	{
+	public:
+		explicit FHeapRegion(SIZE_T InSize)
+			: Data(static_cast<uint8*>(FMemory::MallocZeroed(InSize, 16)))
+			, Size(InSize)
+		{}
+
+		virtual ~FHeapRegion() override { FMemory::Free(Data); }
+
+		virtual uint8* GetData() const override { return Data; }
+		virtual SIZE_T GetSize() const override { return Size; }
+		virtual bool IsWritable() const override { return true; }
+
+	private:
+		uint8* Data;
+		SIZE_T Size;
+	};
+
+	constexpr int64 Timeout = FSpoutConsumerTable::DefaultTimeoutMs;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutConsumerTableLifecycleTest, "UnrealSpout.ConsumerTable.Lifecycle", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutConsumerTableLifecycleTest::RunTest(const FString& Parameters)
+{
+	FSpoutConsumerTable Table(MakeUnique<FHeapRegion>(sizeof(FSpoutConsumerTableLayout)));
+	TestEqual(TEXT("empty table"), Table.CountLive(0), 0);
+
+	const int64 A = FSpoutConsumerTable::MakeConsumerId();
+	const int64 B = FSpoutConsumerTable::MakeConsumerId();
+	TestTrue(TEXT("ids are distinct and non-zero"), A != B && A != 0 && B != 0);
+
+	const int32 SlotA = Table.Register(A, 1000);
+	const int32 SlotB = Table.Register(B, 1000);
+	TestEqual(TEXT("first free slot"), SlotA, 0);
+	TestEqual(TEXT("next free slot"), SlotB, 1);
+	TestEqual(TEXT("two live"), Table.CountLive(1000), 2);
+
+	TestTrue(TEXT("owner heartbeat"), Table.Heartbeat(SlotA, A, 1500));
+	TestFalse(TEXT("heartbeat on someone else's slot"), Table.Heartbeat(SlotB, A, 1500));
+	TestFalse(TEXT("heartbeat out of range"), Table.Heartbeat(FSpoutConsumerTableLayout::NumSlots, A, 1500));
+	TestFalse(TEXT("heartbeat on no slot"), Table.Heartbeat(INDEX_NONE, A, 1500));
+
+	// Only the owner frees a slot.
+	Table.Unregister(SlotA, B);
+	TestEqual(TEXT("wrong owner can't unregister"), Table.CountLive(1500), 2);
+	Table.Unregister(SlotA, A);
+	TestEqual(TEXT("unregistered"), Table.CountLive(1500), 1);
+	TestFalse(TEXT("no heartbeat after unregistering"), Table.Heartbeat(SlotA, A, 1600));
+	Table.Unregister(INDEX_NONE, A);
+
+	// A freed slot is reused first.
+	TestEqual(TEXT("freed slot reused"), Table.Register(A, 1700), SlotA);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutConsumerTableExpiryTest, "UnrealSpout.ConsumerTable.Expiry", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutConsumerTableExpiryTest::RunTest(const FString& Parameters)
+{
+	FSpoutConsumerTable Table(MakeUnique<FHeapRegion>(sizeof(FSpoutConsumerTableLayout)));
+	const int64 Crashed = FSpoutConsumerTable::MakeConsumerId();
+	const int64 Alive = FSpoutConsumerTable::MakeConsumerId();
+	const int64 Newcomer = FSpoutConsumerTable::MakeConsumerId();
+
+	const int32 CrashedSlot = Table.Register(Crashed, 0);
+	const int32 AliveSlot = Table.Register(Alive, 0);
+
+	// Heartbeats keep one consumer live; the other stops without unregistering.
+	for (int64 Now = 500; Now <= Timeout; Now += 500)
+		Table.Heartbeat(AliveSlot, Alive, Now);
+
+	TestEqual(TEXT("live up to the timeout"), Table.CountLive(Timeout), 2);
+	TestEqual(TEXT("stale just past it"), Table.CountLive(Timeout + 1), 1);
+	TestEqual(TEXT("a shorter timeout expires sooner"), Table.CountLive(Timeout, Timeout / 2), 1);
+
+	// Registering reclaims the stale slot before touching a free one.
+	const int32 NewSlot = Table.Register(Newcomer, 3000);
+	TestEqual(TEXT("stale slot reclaimed"), NewSlot, CrashedSlot);
+	TestEqual(TEXT("two live again"), Table.CountLive(3000), 2);
+
+	// The old owner finds out on its next heartbeat and registers again elsewhere.
+	TestFalse(TEXT("reclaimed owner's heartbeat fails"), Table.Heartbeat(CrashedSlot, Crashed, 3000));
+	const int32 Again = Table.Register(Crashed, 3000);
+	TestTrue(TEXT("re-registered in another slot"), Again != INDEX_NONE && Again != CrashedSlot && Again != AliveSlot);
+
+	// Its late unregister of the old slot must not free the newcomer.
+	Table.Unregister(CrashedSlot, Crashed);
+	TestTrue(TEXT("newcomer keeps the slot"), Table.Heartbeat(NewSlot, Newcomer, 3100));
+	TestEqual(TEXT("three live"), Table.CountLive(3100), 3);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutConsumerTableFullTest, "UnrealSpout.ConsumerTable.Full", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutConsumerTableFullTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumSlots = FSpoutConsumerTableLayout::NumSlots;
+	FSpoutConsumerTable Table(MakeUnique<FHeapRegion>(sizeof(FSpoutConsumerTableLayout)));
+
+	TArray<int64> Ids;
+	for (int32 i = 0; i < NumSlots; ++i)
+	{
+		Ids.Add(FSpoutConsumerTable::MakeConsumerId());
+		TestEqual(TEXT("slots fill in order"), Table.Register(Ids[i], i * 10), i);
+	}
+	TestEqual(TEXT("every slot live"), Table.CountLive(NumSlots * 10), NumSlots);
+
+	const int64 Extra = FSpoutConsumerTable::MakeConsumerId();
+	TestEqual(TEXT("full table refuses"), Table.Register(Extra, NumSlots * 10), int32(INDEX_NONE));
+
+	// Unregistering makes room.
+	Table.Unregister(7, Ids[7]);
+	TestEqual(TEXT("freed slot taken"), Table.Register(Extra, NumSlots * 10), 7);
+	TestEqual(TEXT("full again"), Table.Register(FSpoutConsumerTable::MakeConsumerId(), NumSlots * 10), int32(INDEX_NONE));
+
+	// So does the oldest heartbeat going stale: slot 0 registered at 0, slot 1 at 10.
+	const int64 Late = FSpoutConsumerTable::MakeConsumerId();
+	TestEqual(TEXT("oldest slot reclaimed once stale"), Table.Register(Late, Timeout + 1), 0);
+	TestEqual(TEXT("the rest still live"), Table.Register(FSpoutConsumerTable::MakeConsumerId(), Timeout + 1), int32(INDEX_NONE));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutConsumerTableSharedTest, "UnrealSpout.ConsumerTable.Shared", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutConsumerTableSharedTest::RunTest(const FString& Parameters)
+{
+	// A sender and a receiver opening the same name see one table.
+	const FString SenderName = FString::Printf(TEXT("UnrealSpoutConsumerTableTest_%u"), FPlatformProcess::GetCurrentProcessId());
+	const auto SenderAnsi = StringCast<ANSICHAR>(*SenderName);
+	ON_SCOPE_EXIT { SpoutSharedMemory::Remove(TCHAR_TO_ANSI(*FSpoutConsumerTable::GetRegionName(SenderAnsi.Get()))); };
+
+	TUniquePtr<FSpoutConsumerTable> Sender = FSpoutConsumerTable::OpenOrCreate(SenderAnsi.Get());
+	TUniquePtr<FSpoutConsumerTable> Receiver = FSpoutConsumerTable::OpenOrCreate(SenderAnsi.Get());
+	if (!TestTrue(TEXT("opened twice"), Sender.IsValid() && Receiver.IsValid()))
+		return false;
+
+	const int64 Now = FSpoutConsumerTable::NowMs();
+	const int64 Id = FSpoutConsumerTable::MakeConsumerId();
+	const int32 Slot = Receiver->Register(Id, Now);
+	TestEqual(TEXT("the sender sees the receiver"), Sender->CountLive(Now), 1);
+	Receiver->Unregister(Slot, Id);
+	TestEqual(TEXT("and sees it leave"), Sender->CountLive(Now), 0);
+
+	TestNull(TEXT("no table without a name"), FSpoutConsumerTable::OpenOrCreate("").Get());
+	return true;
+}
+
+#endif
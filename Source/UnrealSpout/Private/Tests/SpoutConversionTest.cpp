@@ -0,0 +1,158 @@
+#include "Misc/AutomationTest.h"
+#include "SpoutConversion.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Golden images for SpoutConversion::ConvertReference. Expected texels are worked out by hand
+ * from SpoutReceiverCopyShader.usf (pixel-centre UVs, clamp addressing, half-texel bilinear,
+ * box taps over the footprint), so a change to either side that breaks the mirror shows up here.
+ */
+namespace
+{
+	constexpr float GoldenTolerance = 1e-5f;
+
+	TArray<FLinearColor> Convert(const TArray<FLinearColor>& Src, FIntPoint SrcSize, FIntPoint DstSize, const FSpoutConversionSettings& Settings, FIntRect SrcRect = FIntRect())
+	{
+		TArray<FLinearColor> Dst;
+		Dst.SetNumZeroed(DstSize.X * DstSize.Y);
+		SpoutConversion::ConvertReference(Src, SrcSize, Dst, DstSize, Settings, SrcRect);
+		return Dst;
+	}
+
+	bool TestImage(FAutomationTestBase& Test, const TCHAR* What, const TArray<FLinearColor>& Actual, const TArray<FLinearColor>& Expected)
+	{
+		if (!Test.TestEqual(FString::Printf(TEXT("%s: texel count"), What), Actual.Num(), Expected.Num()))
+			return false;
+
+		bool bMatches = true;
+		for (int32 Index = 0; Index < Expected.Num(); ++Index)
+		{
+			bMatches &= Test.TestTrue(FString::Printf(TEXT("%s: texel %d is %s, expected %s"), What, Index, *Actual[Index].ToString(), *Expected[Index].ToString()),
+				Actual[Index].Equals(Expected[Index], GoldenTolerance));
+		}
+		return bMatches;
+	}
+
+	FSpoutConversionSettings MakeSettings(ESpoutResampleFilter Filter)
+	{
+		FSpoutConversionSettings Settings;
+		Settings.Filter = Filter;
+		return Settings;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutConversionSwizzleTest, "UnrealSpout.Conversion.Swizzle", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutConversionSwizzleTest::RunTest(const FString& Parameters)
+{
+	const TArray<FLinearColor> Src = { FLinearColor(0.1f, 0.2f, 0.3f, 0.4f), FLinearColor(0.9f, 0.8f, 0.7f, 0.6f) };
+
+	FSpoutConversionSettings Settings = MakeSettings(ESpoutResampleFilter::Point);
+	TestImage(*this, TEXT("identity"), Convert(Src, FIntPoint(2, 1), FIntPoint(2, 1), Settings), Src);
+
+	// Color.bgra: red and blue trade places, green and alpha stay.
+	Settings.bSwapRedBlue = true;
+	TestImage(*this, TEXT("swap"), Convert(Src, FIntPoint(2, 1), FIntPoint(2, 1), Settings),
+		{ FLinearColor(0.3f, 0.2f, 0.1f, 0.4f), FLinearColor(0.7f, 0.8f, 0.9f, 0.6f) });
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutConversionTransferTest, "UnrealSpout.Conversion.TransferFunction", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutConversionTransferTest::RunTest(const FString& Parameters)
+{
+	// Both branches of each curve, plus the saturate() the shader applies first.
+	const TArray<FLinearColor> Src = { FLinearColor(0.5f, 0.04f, 1.5f, 0.25f), FLinearColor(0.0f, -0.5f, 1.0f, 1.0f) };
+
+	FSpoutConversionSettings Settings = MakeSettings(ESpoutResampleFilter::Point);
+	Settings.ColorConversion = ESpoutColorConversion::SRGBToLinear;
+	TestImage(*this, TEXT("sRGB to linear"), Convert(Src, FIntPoint(2, 1), FIntPoint(2, 1), Settings),
+		{ FLinearColor(0.2140411f, 0.04f / 12.92f, 1.0f, 0.25f), FLinearColor(0.0f, 0.0f, 1.0f, 1.0f) });
+
+	Settings.ColorConversion = ESpoutColorConversion::LinearToSRGB;
+	TestImage(*this, TEXT("linear to sRGB"), Convert(Src, FIntPoint(2, 1), FIntPoint(2, 1), Settings),
+		{ FLinearColor(0.7353570f, 0.2209164f, 1.0f, 0.25f), FLinearColor(0.0f, 0.0f, 1.0f, 1.0f) });
+
+	// Decode then encode gets back to where it started, to the curve's precision.
+	for (float Value = 0.0f; Value <= 1.0f; Value += 1.0f / 64.0f)
+	{
+		TestEqual(FString::Printf(TEXT("round trip of %f"), Value), SpoutConversion::LinearToSRGB(SpoutConversion::SRGBToLinear(Value)), Value, 1e-4f);
+	}
+
+	// Alpha is never converted.
+	Settings.bSwapRedBlue = true;
+	TestEqual(TEXT("alpha after swap and encode"), Convert(Src, FIntPoint(2, 1), FIntPoint(2, 1), Settings)[0].A, 0.25f);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutConversionFlipTest, "UnrealSpout.Conversion.Flip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutConversionFlipTest::RunTest(const FString& Parameters)
+{
+	const TArray<FLinearColor> Src = { FLinearColor(0.0f, 0, 0, 1), FLinearColor(0.25f, 0, 0, 1), FLinearColor(0.5f, 0, 0, 1), FLinearColor(0.75f, 0, 0, 1) };
+
+	FSpoutConversionSettings Settings = MakeSettings(ESpoutResampleFilter::Point);
+	Settings.bFlipVertically = true;
+	TestImage(*this, TEXT("flip"), Convert(Src, FIntPoint(1, 4), FIntPoint(1, 4), Settings),
+		{ Src[3], Src[2], Src[1], Src[0] });
+
+	// The flip happens before the source rect is applied: rows 1..2 come out as 2, 1.
+	TestImage(*this, TEXT("flip within rect"), Convert(Src, FIntPoint(1, 4), FIntPoint(1, 2), Settings, FIntRect(0, 1, 1, 3)),
+		{ Src[2], Src[1] });
+
+	// Bilinear at the same size lands on texel centres, so a flip is still exact.
+	Settings.Filter = ESpoutResampleFilter::Bilinear;
+	TestImage(*this, TEXT("bilinear flip"), Convert(Src, FIntPoint(1, 4), FIntPoint(1, 4), Settings),
+		{ Src[3], Src[2], Src[1], Src[0] });
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutConversionResizeTest, "UnrealSpout.Conversion.Resize", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutConversionResizeTest::RunTest(const FString& Parameters)
+{
+	// 2x1 -> 4x1 bilinear: output centres at source x = -0.25, 0.25, 0.75, 1.25 (in texel-centre space), clamped at the edges.
+	{
+		const TArray<FLinearColor> Src = { FLinearColor(0.0f, 1.0f, 0.0f, 1.0f), FLinearColor(1.0f, 0.0f, 0.0f, 1.0f) };
+		TestImage(*this, TEXT("bilinear upscale"), Convert(Src, FIntPoint(2, 1), FIntPoint(4, 1), MakeSettings(ESpoutResampleFilter::Bilinear)),
+			{ FLinearColor(0.0f, 1.0f, 0.0f, 1.0f), FLinearColor(0.25f, 0.75f, 0.0f, 1.0f), FLinearColor(0.75f, 0.25f, 0.0f, 1.0f), FLinearColor(1.0f, 0.0f, 0.0f, 1.0f) });
+	}
+
+	// 4x4 -> 2x2 box: a 2x2 footprint, two taps per axis, each output the mean of its quad.
+	TArray<FLinearColor> Src;
+	for (int32 Index = 0; Index < 16; ++Index)
+	{
+		Src.Add(FLinearColor(float(Index), 0.0f, 0.0f, 1.0f));
+	}
+	TestImage(*this, TEXT("box 2x"), Convert(Src, FIntPoint(4, 4), FIntPoint(2, 2), MakeSettings(ESpoutResampleFilter::Box)),
+		{ FLinearColor(2.5f, 0, 0, 1), FLinearColor(4.5f, 0, 0, 1), FLinearColor(10.5f, 0, 0, 1), FLinearColor(12.5f, 0, 0, 1) });
+
+	// 4x4 -> 1x1 box: every texel under one footprint.
+	TestImage(*this, TEXT("box 4x"), Convert(Src, FIntPoint(4, 4), FIntPoint(1, 1), MakeSettings(ESpoutResampleFilter::Box)),
+		{ FLinearColor(7.5f, 0, 0, 1) });
+
+	// Box over a source rect only averages inside it.
+	TestImage(*this, TEXT("box in rect"), Convert(Src, FIntPoint(4, 4), FIntPoint(1, 1), MakeSettings(ESpoutResampleFilter::Box), FIntRect(2, 2, 4, 4)),
+		{ FLinearColor(12.5f, 0, 0, 1) });
+
+	// Footprints wider than MaxBoxTaps are sampled with MaxBoxTaps evenly spaced taps.
+	{
+		constexpr int32 Width = SpoutConversion::MaxBoxTaps * 2;
+		TArray<FLinearColor> Ramp;
+		for (int32 X = 0; X < Width; ++X)
+		{
+			Ramp.Add(FLinearColor(float(X), 0.0f, 0.0f, 1.0f));
+		}
+		// Eight taps, two texels apart, land on 1, 3, ... 15; their mean is 8.
+		TestImage(*this, TEXT("box capped taps"), Convert(Ramp, FIntPoint(Width, 1), FIntPoint(1, 1), MakeSettings(ESpoutResampleFilter::Box)),
+			{ FLinearColor(float(SpoutConversion::MaxBoxTaps), 0, 0, 1) });
+	}
+
+	// Point at 2x down picks the texel under each output centre: 1 and 3 of a 4-wide row.
+	TestImage(*this, TEXT("point 2x"), Convert(Src, FIntPoint(4, 1), FIntPoint(2, 1), MakeSettings(ESpoutResampleFilter::Point)),
+		{ Src[1], Src[3] });
+	return true;
+}
+
+#endif
@@ -0,0 +1,125 @@
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+#include "SpoutInteropDevice.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** Hands out placeholder handles and counts what FSpoutInteropDevice asks of it. Never dereferences them. */
+	class FMockInteropDeviceFactory final : public ISpoutInteropDeviceFactory
+	{
+	public:
+		explicit FMockInteropDeviceFactory(bool bInSucceed)
+			: bSucceed(bInSucceed)
+		{}
+
+		virtual bool Create(FSpoutInteropDeviceHandles& Out) override
+		{
+			++NumCreated;
+			if (!bSucceed)
+				return false;
+
+			Out.Device = reinterpret_cast<ID3D11Device*>(UPTRINT(0x10));
+			Out.Context = reinterpret_cast<ID3D11DeviceContext*>(UPTRINT(0x20));
+			Out.On12Device = reinterpret_cast<ID3D11On12Device*>(UPTRINT(0x30));
+			return true;
+		}
+
+		virtual void Destroy(FSpoutInteropDeviceHandles& Handles) override
+		{
+			++NumDestroyed;
+			Handles = FSpoutInteropDeviceHandles();
+		}
+
+		virtual void ExecuteCopies(const FSpoutInteropDeviceHandles& Handles, TConstArrayView<ID3D11Resource*> Wrapped, TConstArrayView<FSpoutInteropCopy> Copies) override
+		{
+			++NumExecutes;
+		}
+
+		virtual void Flush(const FSpoutInteropDeviceHandles& Handles) override
+		{
+			++NumFlushes;
+		}
+
+		bool bSucceed;
+		int32 NumCreated = 0;
+		int32 NumDestroyed = 0;
+		int32 NumExecutes = 0;
+		int32 NumFlushes = 0;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutInteropDeviceLifetimeTest, "UnrealSpout.InteropDevice.Lifetime", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutInteropDeviceLifetimeTest::RunTest(const FString& Parameters)
+{
+	// A live device keeps the factory it was made with, so the mock would never be asked.
+	if (FSpoutInteropDevice::IsAlive())
+	{
+		AddWarning(TEXT("Skipped: Spout streams on the D3D12 RHI are holding the interop device."));
+		return true;
+	}
+
+	const TSharedRef<FMockInteropDeviceFactory, ESPMode::ThreadSafe> Factory = MakeShared<FMockInteropDeviceFactory, ESPMode::ThreadSafe>(true);
+	FSpoutInteropDevice::SetFactory(Factory);
+	ON_SCOPE_EXIT { FSpoutInteropDevice::SetFactory(nullptr); };
+
+	{
+		TSharedPtr<FSpoutInteropDevice, ESPMode::ThreadSafe> First = FSpoutInteropDevice::Acquire();
+		TSharedPtr<FSpoutInteropDevice, ESPMode::ThreadSafe> Second = FSpoutInteropDevice::Acquire();
+
+		TestTrue(TEXT("first acquire creates"), First.IsValid());
+		TestTrue(TEXT("second acquire shares it"), First == Second);
+		TestEqual(TEXT("one device created"), Factory->NumCreated, 1);
+		TestTrue(TEXT("alive while referenced"), FSpoutInteropDevice::IsAlive());
+		TestTrue(TEXT("handles come from the factory"), First.IsValid() && First->GetDevice() == reinterpret_cast<ID3D11Device*>(UPTRINT(0x10)));
+
+		// A submit with nothing queued still flushes, once.
+		if (First.IsValid())
+			First->Submit();
+		TestEqual(TEXT("empty submit does not execute"), Factory->NumExecutes, 0);
+		TestEqual(TEXT("empty submit flushes"), Factory->NumFlushes, 1);
+
+		First.Reset();
+		TestTrue(TEXT("alive while one reference is left"), FSpoutInteropDevice::IsAlive());
+		TestEqual(TEXT("not destroyed early"), Factory->NumDestroyed, 0);
+	}
+
+	TestFalse(TEXT("last release destroys"), FSpoutInteropDevice::IsAlive());
+	TestEqual(TEXT("destroyed once"), Factory->NumDestroyed, 1);
+
+	{
+		TSharedPtr<FSpoutInteropDevice, ESPMode::ThreadSafe> Again = FSpoutInteropDevice::Acquire();
+		TestTrue(TEXT("next acquire creates a fresh device"), Again.IsValid());
+		TestEqual(TEXT("two devices created"), Factory->NumCreated, 2);
+	}
+	TestEqual(TEXT("both destroyed"), Factory->NumDestroyed, 2);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutInteropDeviceFailureTest, "UnrealSpout.InteropDevice.FactoryFailure", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutInteropDeviceFailureTest::RunTest(const FString& Parameters)
+{
+	if (FSpoutInteropDevice::IsAlive())
+	{
+		AddWarning(TEXT("Skipped: Spout streams on the D3D12 RHI are holding the interop device."));
+		return true;
+	}
+
+	const TSharedRef<FMockInteropDeviceFactory, ESPMode::ThreadSafe> Factory = MakeShared<FMockInteropDeviceFactory, ESPMode::ThreadSafe>(false);
+	FSpoutInteropDevice::SetFactory(Factory);
+	ON_SCOPE_EXIT { FSpoutInteropDevice::SetFactory(nullptr); };
+
+	TestFalse(TEXT("failed create returns null"), FSpoutInteropDevice::Acquire().IsValid());
+	TestFalse(TEXT("nothing alive after a failure"), FSpoutInteropDevice::IsAlive());
+
+	// Failures are not cached: each acquire tries again.
+	FSpoutInteropDevice::Acquire();
+	TestEqual(TEXT("each acquire retries"), Factory->NumCreated, 2);
+	TestEqual(TEXT("nothing to destroy"), Factory->NumDestroyed, 0);
+	return true;
+}
+
+#endif
@@ -0,0 +1,116 @@
+#include "Misc/AutomationTest.h"
+#include "SpoutLruCache.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	using FTestCache = TSpoutLruCache<int32, int32>;
+
+	/** Keys evicted from a cache, in eviction order. */
+	struct FEvictions
+	{
+		TArray<int32> Keys;
+
+		FTestCache::FOnEvict Recorder()
+		{
+			return [this](const int32& Key, int32&) { Keys.Add(Key); };
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutLruCacheHitTest, "UnrealSpout.LruCache.Hit", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutLruCacheHitTest::RunTest(const FString& Parameters)
+{
+	FEvictions Evictions;
+	FTestCache Cache(4, Evictions.Recorder());
+
+	TestNull(TEXT("empty cache misses"), Cache.Find(1));
+	Cache.Add(1, 10);
+	Cache.Add(2, 20);
+
+	int32* Value = Cache.Find(1);
+	TestTrue(TEXT("hit returns the value"), Value && *Value == 10);
+	if (Value)
+		*Value = 11;
+	Value = Cache.Find(1);
+	TestTrue(TEXT("values are held in place"), Value && *Value == 11);
+	TestNull(TEXT("unknown key misses"), Cache.Find(3));
+
+	TestEqual(TEXT("hits"), Cache.GetStats().Hits, uint64(2));
+	TestEqual(TEXT("misses"), Cache.GetStats().Misses, uint64(2));
+	TestEqual(TEXT("nothing evicted"), Evictions.Keys.Num(), 0);
+	TestEqual(TEXT("two cached"), Cache.Num(), 2);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutLruCacheEvictionTest, "UnrealSpout.LruCache.EvictionOrder", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutLruCacheEvictionTest::RunTest(const FString& Parameters)
+{
+	FEvictions Evictions;
+	FTestCache Cache(3, Evictions.Recorder());
+	Cache.Add(1, 10);
+	Cache.Add(2, 20);
+	Cache.Add(3, 30);
+
+	// A lookup makes 1 the most recently used, so 2 goes first, then 3.
+	Cache.Find(1);
+	Cache.Add(4, 40);
+	TestEqual(TEXT("least recently used evicted"), Evictions.Keys, TArray<int32>({ 2 }));
+	Cache.Add(5, 50);
+	TestEqual(TEXT("then the next least recent"), Evictions.Keys, TArray<int32>({ 2, 3 }));
+	TestNotNull(TEXT("the looked-up entry survived"), Cache.Find(1));
+
+	// Now 4 is the oldest, 5 and 1 were used after it.
+	Cache.Add(6, 60);
+	TestEqual(TEXT("insertion counts as a use"), Evictions.Keys, TArray<int32>({ 2, 3, 4 }));
+	TestNull(TEXT("evicted key misses"), Cache.Find(2));
+
+	// Removal and emptying evict too, so values always get released.
+	TestEqual(TEXT("removed by predicate"), Cache.RemoveIf([](const int32& Key, const int32&) { return Key == 5; }), 1);
+	TestEqual(TEXT("removal evicts"), Evictions.Keys, TArray<int32>({ 2, 3, 4, 5 }));
+	Cache.Empty();
+	TestEqual(TEXT("empty evicts the rest"), Evictions.Keys.Num(), 6);
+	TestEqual(TEXT("evictions counted"), Cache.GetStats().Evictions, uint64(6));
+	TestEqual(TEXT("nothing cached"), Cache.Num(), 0);
+
+	// Destruction evicts what is left.
+	FEvictions OnDestroy;
+	{
+		FTestCache Scoped(2, OnDestroy.Recorder());
+		Scoped.Add(7, 70);
+	}
+	TestEqual(TEXT("destructor evicts"), OnDestroy.Keys, TArray<int32>({ 7 }));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutLruCacheCapacityTest, "UnrealSpout.LruCache.Capacity", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutLruCacheCapacityTest::RunTest(const FString& Parameters)
+{
+	FEvictions Evictions;
+	FTestCache Cache(4, Evictions.Recorder());
+	for (int32 Key = 0; Key < 100; ++Key)
+	{
+		Cache.Add(Key, Key);
+		if (Cache.Num() > Cache.GetCapacity())
+			break;
+	}
+	TestEqual(TEXT("never over capacity"), Cache.Num(), 4);
+	TestEqual(TEXT("everything else evicted"), Evictions.Keys.Num(), 96);
+	for (int32 Key = 96; Key < 100; ++Key)
+		TestNotNull(TEXT("the newest entries are kept"), Cache.Find(Key));
+
+	// A capacity below one still caches a single entry.
+	FTestCache Tiny(0);
+	TestEqual(TEXT("capacity clamped to one"), Tiny.GetCapacity(), 1);
+	Tiny.Add(1, 1);
+	Tiny.Add(2, 2);
+	TestEqual(TEXT("one entry"), Tiny.Num(), 1);
+	TestNotNull(TEXT("the last one"), Tiny.Find(2));
+	return true;
+}
+
+#endif
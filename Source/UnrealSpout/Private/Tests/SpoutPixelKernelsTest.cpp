@@ -0,0 +1,141 @@
+#include "Misc/AutomationTest.h"
+#include "Math/RandomStream.h"
+
+#include "SpoutPixelKernels.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	using namespace SpoutPixelKernels;
+
+	/** Bytes past the end of every destination row that no kernel may touch. */
+	constexpr int32 GuardBytes = 64;
+	constexpr uint8 GuardValue = 0xCD;
+
+	/** Widths around every vector size (4, 8 and 16 pixels) and their multiples, so each tail length is hit. */
+	TArray<int32> GetWidths()
+	{
+		TArray<int32> Widths;
+		for (int32 Width = 0; Width <= 67; ++Width)
+			Widths.Add(Width);
+		for (const int32 Width : { 127, 129, 255, 257, 1023, 1921 })
+			Widths.Add(Width);
+		return Widths;
+	}
+
+	/** Random source pixels. Halves are kept off NaN, whose payload no kernel promises to keep. */
+	void FillSource(EKernel Kernel, TArray<uint8>& Src, FRandomStream& Random)
+	{
+		for (uint8& Byte : Src)
+			Byte = static_cast<uint8>(Random.RandRange(0, 255));
+
+		if (Kernel == EKernel::HalfToUnorm8)
+		{
+			uint16* Halves = reinterpret_cast<uint16*>(Src.GetData());
+			for (int32 i = 0; i < Src.Num() / 2; ++i)
+			{
+				if ((Halves[i] & 0x7C00) == 0x7C00 && (Halves[i] & 0x03FF) != 0)
+					Halves[i] &= 0xFC00;
+			}
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutPixelKernelsMatchScalarTest, "UnrealSpout.PixelKernels.MatchScalar", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutPixelKernelsMatchScalarTest::RunTest(const FString& Parameters)
+{
+	const EIsa Supported = GetSupportedIsa();
+	if (Supported == EIsa::Scalar)
+		AddInfo(TEXT("This CPU only runs the scalar kernels; nothing to compare them with."));
+
+	const TArray<int32> Widths = GetWidths();
+	FRandomStream Random(0x5B0u);
+	TArray<uint8> Src;
+	TArray<uint8> Expected;
+	TArray<uint8> Actual;
+
+	for (int32 K = 0; K < static_cast<int32>(EKernel::Num); ++K)
+	{
+		const EKernel Kernel = static_cast<EKernel>(K);
+		const FRowKernel Reference = GetKernel(Kernel, EIsa::Scalar);
+		const int32 SrcBpp = GetSrcBytesPerPixel(Kernel);
+		const int32 DstBpp = GetDstBytesPerPixel(Kernel);
+
+		for (int32 I = static_cast<int32>(EIsa::Scalar) + 1; I <= static_cast<int32>(Supported); ++I)
+		{
+			const EIsa Isa = static_cast<EIsa>(I);
+			const FRowKernel Row = GetKernel(Kernel, Isa);
+			if (Row == GetKernel(Kernel, static_cast<EIsa>(I - 1)))
+				continue;
+
+			int32 Mismatches = 0;
+			int32 Overruns = 0;
+			int32 InPlaceMismatches = 0;
+			for (const int32 Width : Widths)
+			{
+				Src.SetNumUninitialized(FMath::Max(1, Width * SrcBpp));
+				FillSource(Kernel, Src, Random);
+
+				Expected.Init(GuardValue, Width * DstBpp + GuardBytes);
+				Actual.Init(GuardValue, Width * DstBpp + GuardBytes);
+				Reference(Expected.GetData(), Src.GetData(), Width);
+				Row(Actual.GetData(), Src.GetData(), Width);
+
+				Mismatches += FMemory::Memcmp(Expected.GetData(), Actual.GetData(), Width * DstBpp) != 0 ? 1 : 0;
+				for (int32 i = Width * DstBpp; i < Actual.Num(); ++i)
+					Overruns += Actual[i] != GuardValue ? 1 : 0;
+
+				// Kernels that keep the pixel size also work in place.
+				if (SrcBpp == DstBpp && Width > 0)
+				{
+					TArray<uint8> InPlace = Src;
+					Row(InPlace.GetData(), InPlace.GetData(), Width);
+					InPlaceMismatches += FMemory::Memcmp(Expected.GetData(), InPlace.GetData(), Width * DstBpp) != 0 ? 1 : 0;
+				}
+			}
+
+			const FString What = FString::Printf(TEXT("%s %s"), GetName(Kernel), GetName(Isa));
+			TestEqual(*(What + TEXT(": widths that differ from scalar")), Mismatches, 0);
+			TestEqual(*(What + TEXT(": bytes written past the row")), Overruns, 0);
+			TestEqual(*(What + TEXT(": in-place widths that differ from scalar")), InPlaceMismatches, 0);
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutPixelKernelsScalarTest, "UnrealSpout.PixelKernels.Scalar", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutPixelKernelsScalarTest::RunTest(const FString& Parameters)
+{
+	// The reference itself, on hand-worked pixels.
+	auto Run = [](EKernel Kernel, const TArray<uint8>& Src) -> TArray<uint8>
+	{
+		const int32 NumPixels = Src.Num() / GetSrcBytesPerPixel(Kernel);
+		TArray<uint8> Dst;
+		Dst.SetNumZeroed(NumPixels * GetDstBytesPerPixel(Kernel));
+		GetKernel(Kernel, EIsa::Scalar)(Dst.GetData(), Src.GetData(), NumPixels);
+		return Dst;
+	};
+
+	TestEqual(TEXT("swizzle"), Run(EKernel::SwizzleRB, { 1, 2, 3, 4 }), TArray<uint8>({ 3, 2, 1, 4 }));
+	TestEqual(TEXT("RGB to RGBA"), Run(EKernel::RGBToRGBA, { 1, 2, 3, 4, 5, 6 }), TArray<uint8>({ 1, 2, 3, 255, 4, 5, 6, 255 }));
+	TestEqual(TEXT("RGBA to RGB"), Run(EKernel::RGBAToRGB, { 1, 2, 3, 4, 5, 6, 7, 8 }), TArray<uint8>({ 1, 2, 3, 5, 6, 7 }));
+	TestEqual(TEXT("premultiply"), Run(EKernel::Premultiply, { 255, 128, 0, 128, 200, 100, 50, 0 }), TArray<uint8>({ 128, 64, 0, 128, 0, 0, 0, 0 }));
+
+	// Half 1.0 = 0x3C00, 0.5 = 0x3800, -1.0 = 0xBC00, 2.0 = 0x4000; little endian.
+	TestEqual(TEXT("half to unorm8 clamps and rounds"), Run(EKernel::HalfToUnorm8, { 0x00, 0x3C, 0x00, 0x38, 0x00, 0xBC, 0x00, 0x40 }), TArray<uint8>({ 255, 128, 0, 255 }));
+	TestEqual(TEXT("unorm8 to half"), Run(EKernel::Unorm8ToHalf, { 255, 0, 255, 0 }), TArray<uint8>({ 0x00, 0x3C, 0x00, 0x00, 0x00, 0x3C, 0x00, 0x00 }));
+
+	// Packing widens by bit replication and unpacking undoes it exactly, for the four alphas two bits hold.
+	TArray<uint8> Pixels;
+	for (int32 i = 0; i < 256; ++i)
+		Pixels.Append({ static_cast<uint8>(i), static_cast<uint8>(255 - i), static_cast<uint8>(i * 7), static_cast<uint8>((i & 3) * 85) });
+	const TArray<uint8> Packed = Run(EKernel::PackRGB10A2, Pixels);
+	TestEqual(TEXT("white packs to all ones"), Run(EKernel::PackRGB10A2, { 255, 255, 255, 255 }), TArray<uint8>({ 0xFF, 0xFF, 0xFF, 0xFF }));
+	TestEqual(TEXT("unpack inverts pack"), Run(EKernel::UnpackRGB10A2, Packed), Pixels);
+	return true;
+}
+
+#endif
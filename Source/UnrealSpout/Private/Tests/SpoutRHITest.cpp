@@ -0,0 +1,65 @@
+#include "Misc/AutomationTest.h"
+#include "SpoutRHI.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	FSpoutNativeShareCaps MakeCaps(bool bOpenedSharedTextures, bool bCreatedFence)
+	{
+		FSpoutNativeShareCaps Caps;
+		Caps.bOpenedSharedTextures = bOpenedSharedTextures;
+		Caps.bCreatedFence = bCreatedFence;
+		return Caps;
+	}
+
+	const TCHAR* ToString(ESpoutSharePath Path)
+	{
+		switch (Path)
+		{
+		case ESpoutSharePath::D3D11:		return TEXT("D3D11");
+		case ESpoutSharePath::D3D11On12:	return TEXT("D3D11On12");
+		case ESpoutSharePath::NativeD3D12:	return TEXT("NativeD3D12");
+		default:							return TEXT("Unsupported");
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutSelectSharePathTest, "UnrealSpout.RHI.SelectSharePath", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutSelectSharePathTest::RunTest(const FString& Parameters)
+{
+	const ESpoutRHIBackend Backends[] = { ESpoutRHIBackend::Unsupported, ESpoutRHIBackend::D3D11, ESpoutRHIBackend::D3D12 };
+
+	// Every backend, preference and capability combination against the expected path.
+	for (const ESpoutRHIBackend Backend : Backends)
+	{
+		for (int32 Bits = 0; Bits < 8; ++Bits)
+		{
+			const bool bPreferNative = (Bits & 1) != 0;
+			const FSpoutNativeShareCaps Caps = MakeCaps((Bits & 2) != 0, (Bits & 4) != 0);
+
+			ESpoutSharePath Expected = ESpoutSharePath::Unsupported;
+			if (Backend == ESpoutRHIBackend::D3D11)
+				Expected = ESpoutSharePath::D3D11;
+			else if (Backend == ESpoutRHIBackend::D3D12)
+				Expected = bPreferNative && Caps.bOpenedSharedTextures && Caps.bCreatedFence ? ESpoutSharePath::NativeD3D12 : ESpoutSharePath::D3D11On12;
+
+			const ESpoutSharePath Actual = SpoutRHI::SelectSharePath(Backend, bPreferNative, Caps);
+			TestTrue(FString::Printf(TEXT("backend %d, prefer native %d, opened textures %d, created fence %d: got %s, expected %s"),
+				static_cast<int32>(Backend), bPreferNative, Caps.bOpenedSharedTextures, Caps.bCreatedFence, ToString(Actual), ToString(Expected)),
+				Actual == Expected);
+		}
+	}
+
+	// The rows that matter most, spelled out.
+	TestEqual(TEXT("D3D11 ignores the native preference"), SpoutRHI::SelectSharePath(ESpoutRHIBackend::D3D11, true, MakeCaps(true, true)), ESpoutSharePath::D3D11);
+	TestEqual(TEXT("native when asked for and fully set up"), SpoutRHI::SelectSharePath(ESpoutRHIBackend::D3D12, true, MakeCaps(true, true)), ESpoutSharePath::NativeD3D12);
+	TestEqual(TEXT("11on12 when a texture failed to open"), SpoutRHI::SelectSharePath(ESpoutRHIBackend::D3D12, true, MakeCaps(false, true)), ESpoutSharePath::D3D11On12);
+	TestEqual(TEXT("11on12 without a fence"), SpoutRHI::SelectSharePath(ESpoutRHIBackend::D3D12, true, MakeCaps(true, false)), ESpoutSharePath::D3D11On12);
+	TestEqual(TEXT("11on12 unless native is preferred"), SpoutRHI::SelectSharePath(ESpoutRHIBackend::D3D12, false, MakeCaps(true, true)), ESpoutSharePath::D3D11On12);
+	TestEqual(TEXT("nothing on other RHIs"), SpoutRHI::SelectSharePath(ESpoutRHIBackend::Unsupported, true, MakeCaps(true, true)), ESpoutSharePath::Unsupported);
+	return true;
+}
+
+#endif
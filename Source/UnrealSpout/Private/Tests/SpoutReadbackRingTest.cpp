@@ -0,0 +1,166 @@
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformProcess.h"
+
+#include "SpoutReadbackRing.h"
+#include "SpoutSpscQueue.h"
+
+#include <atomic>
+#include <thread>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutReadbackRingTest, "UnrealSpout.Readback.Ring", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutReadbackRingTest::RunTest(const FString& Parameters)
+{
+	// Sizes and latency are clamped so one buffer is always free to copy into.
+	TestEqual(TEXT("at least MinBuffers"), FSpoutReadbackRing(1, 0).Num(), FSpoutReadbackRing::MinBuffers);
+	TestEqual(TEXT("latency at least 1"), FSpoutReadbackRing(1, 0).GetLatency(), 1);
+	TestEqual(TEXT("at most MaxBuffers"), FSpoutReadbackRing(100, 100).Num(), FSpoutReadbackRing::MaxBuffers);
+	TestEqual(TEXT("latency below the ring size"), FSpoutReadbackRing(100, 100).GetLatency(), FSpoutReadbackRing::MaxBuffers - 1);
+
+	FSpoutReadbackRing Ring(3, 2);
+	uint64 CopyFrame = 0;
+	TestEqual(TEXT("nothing in flight"), Ring.PeekReady(10), int32(INDEX_NONE));
+
+	TestEqual(TEXT("first copy"), Ring.BeginCopy(1), 0);
+	TestEqual(TEXT("not ready in its own frame"), Ring.PeekReady(1), int32(INDEX_NONE));
+	TestEqual(TEXT("not ready one frame later"), Ring.PeekReady(2), int32(INDEX_NONE));
+	TestEqual(TEXT("ready Latency frames later"), Ring.PeekReady(3, &CopyFrame), 0);
+	TestEqual(TEXT("reports its copy frame"), CopyFrame, uint64(1));
+
+	// Every buffer in flight: the next copy is dropped, not waited for.
+	TestEqual(TEXT("second copy"), Ring.BeginCopy(2), 1);
+	TestEqual(TEXT("third copy"), Ring.BeginCopy(3), 2);
+	TestEqual(TEXT("full ring drops"), Ring.BeginCopy(3), int32(INDEX_NONE));
+	TestEqual(TEXT("drop counted"), Ring.GetNumDropped(), uint64(1));
+
+	// Oldest first, and a younger buffer is not handed out ahead of its latency.
+	Ring.Release(0);
+	TestEqual(TEXT("next is not ready yet"), Ring.PeekReady(3), int32(INDEX_NONE));
+	TestEqual(TEXT("freed buffer reused"), Ring.BeginCopy(4), 0);
+	TestEqual(TEXT("oldest, not lowest index"), Ring.PeekReady(4, &CopyFrame), 1);
+	TestEqual(TEXT("oldest copy frame"), CopyFrame, uint64(2));
+	Ring.Release(INDEX_NONE);
+	Ring.Release(Ring.Num());
+
+	// Steady state: drain, then copy. Nothing is dropped and every frame comes out Latency later.
+	FSpoutReadbackRing Steady(3, 2);
+	int32 Delivered = 0;
+	int32 LateOrEarly = 0;
+	for (uint64 Frame = 1; Frame <= 100; ++Frame)
+	{
+		for (int32 Buffer = Steady.PeekReady(Frame, &CopyFrame); Buffer != INDEX_NONE; Buffer = Steady.PeekReady(Frame, &CopyFrame))
+		{
+			LateOrEarly += CopyFrame + Steady.GetLatency() == Frame ? 0 : 1;
+			++Delivered;
+			Steady.Release(Buffer);
+		}
+		Steady.BeginCopy(Frame);
+	}
+	TestEqual(TEXT("no drops in steady state"), Steady.GetNumDropped(), uint64(0));
+	TestEqual(TEXT("all but the last Latency frames delivered"), Delivered, 98);
+	TestEqual(TEXT("each exactly Latency frames old"), LateOrEarly, 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutReadbackFramePoolTest, "UnrealSpout.Readback.FramePool", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutReadbackFramePoolTest::RunTest(const FString& Parameters)
+{
+	FSpoutReadbackFramePool Pool(2);
+
+	TSharedPtr<FSpoutReadbackFrame, ESPMode::ThreadSafe> First = Pool.Acquire();
+	TestTrue(TEXT("first frame"), First.IsValid());
+	FSpoutReadbackFrame* const FirstFrame = First.Get();
+	First.Reset();
+
+	// Nobody else holds it, so it comes back instead of a new one.
+	First = Pool.Acquire();
+	TestTrue(TEXT("reused once released"), First.Get() == FirstFrame);
+	TestEqual(TEXT("still one frame"), Pool.Num(), 1);
+
+	TSharedPtr<FSpoutReadbackFrame, ESPMode::ThreadSafe> Second = Pool.Acquire();
+	TestTrue(TEXT("a new frame while the first is held"), Second.IsValid() && Second.Get() != FirstFrame);
+	TestEqual(TEXT("two frames"), Pool.Num(), 2);
+	TestFalse(TEXT("nothing while the consumer holds every frame"), Pool.Acquire().IsValid());
+
+	// Data kept across reuse, so the next copy needn't reallocate.
+	Second->Data.SetNumUninitialized(1024);
+	FSpoutReadbackFrame* const SecondFrame = Second.Get();
+	Second.Reset();
+	Second = Pool.Acquire();
+	TestTrue(TEXT("released frame comes back"), Second.Get() == SecondFrame);
+	TestEqual(TEXT("with its buffer"), Second->Data.Num(), 1024);
+
+	TestTrue(TEXT("at least one frame"), FSpoutReadbackFramePool(0).Acquire().IsValid());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutSpscQueueTest, "UnrealSpout.Readback.SpscQueue", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutSpscQueueTest::RunTest(const FString& Parameters)
+{
+	TSpoutSpscQueue<TUniquePtr<int32>> Queue(3);
+	TestEqual(TEXT("capacity rounded up to a power of two"), Queue.GetCapacity(), 4u);
+	TestEqual(TEXT("at least two"), TSpoutSpscQueue<int32>(0).GetCapacity(), 2u);
+
+	TUniquePtr<int32> Item;
+	TestFalse(TEXT("empty queue"), Queue.Dequeue(Item));
+
+	for (int32 i = 0; i < 4; ++i)
+		TestTrue(TEXT("fills to capacity"), Queue.Enqueue(MakeUnique<int32>(i)));
+
+	TUniquePtr<int32> Extra = MakeUnique<int32>(4);
+	TestFalse(TEXT("full queue refuses"), Queue.Enqueue(MoveTemp(Extra)));
+	TestTrue(TEXT("refused item left with the caller"), Extra.IsValid());
+	TestEqual(TEXT("four queued"), Queue.Num(), 4u);
+
+	// First in, first out, across the wrap-around.
+	int32 Expected = 0;
+	for (int32 Round = 0; Round < 10; ++Round)
+	{
+		TestTrue(TEXT("dequeue"), Queue.Dequeue(Item) && Item.IsValid() && *Item == Expected);
+		++Expected;
+		TestTrue(TEXT("room for one"), Queue.Enqueue(MakeUnique<int32>(Expected + 3)));
+	}
+	while (Queue.Dequeue(Item))
+	{
+		TestTrue(TEXT("in order"), Item.IsValid() && *Item == Expected);
+		++Expected;
+	}
+	TestEqual(TEXT("everything came out"), Expected, 14);
+	TestEqual(TEXT("empty again"), Queue.Num(), 0u);
+
+	// One producer, one consumer thread: nothing lost, duplicated or reordered.
+	constexpr int32 NumItems = 200000;
+	TSpoutSpscQueue<int32> Threaded(64);
+	std::atomic<int32> OutOfOrder { 0 };
+	std::atomic<int32> Received { 0 };
+	std::thread Consumer([&]()
+	{
+		int32 Next = 0;
+		int32 Value = 0;
+		while (Next < NumItems)
+		{
+			if (Threaded.Dequeue(Value))
+			{
+				OutOfOrder += Value == Next ? 0 : 1;
+				++Next;
+			}
+		}
+		Received = Next;
+	});
+	for (int32 i = 0; i < NumItems; ++i)
+	{
+		int32 Value = i;
+		while (!Threaded.Enqueue(MoveTemp(Value)))
+			FPlatformProcess::Yield();
+	}
+	Consumer.join();
+	TestEqual(TEXT("all received"), Received.load(), NumItems);
+	TestEqual(TEXT("in order"), OutOfOrder.load(), 0);
+	return true;
+}
+
+#endif
@@ -0,0 +1,95 @@
+#include "Misc/AutomationTest.h"
+#include "SpoutReceiverState.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** DXGI_FORMAT_B8G8R8A8_UNORM and DXGI_FORMAT_R16G16B16A16_FLOAT. */
+	constexpr uint32 FormatBGRA8 = 87;
+	constexpr uint32 FormatRGBA16F = 10;
+
+	FSpoutSenderDesc MakeSender(uint32 Width, uint32 Height, uint32 Handle, uint32 Format = FormatBGRA8)
+	{
+		FSpoutSenderDesc Desc;
+		Desc.Width = Width;
+		Desc.Height = Height;
+		Desc.Format = Format;
+		Desc.Handle = Handle;
+		return Desc;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutReceiverStateSequenceTest, "UnrealSpout.ReceiverState.Sequence", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutReceiverStateSequenceTest::RunTest(const FString& Parameters)
+{
+	FSpoutReceiverState State;
+	TestEqual(TEXT("nothing before the first sender"), State.Update(FSpoutSenderDesc()), ESpoutReceiverAction::None);
+	TestFalse(TEXT("not connected"), State.IsConnected());
+
+	TestEqual(TEXT("first sender allocates"), State.Update(MakeSender(1280, 720, 0x100)), ESpoutReceiverAction::Allocate);
+	TestTrue(TEXT("connected"), State.IsConnected());
+	TestEqual(TEXT("first allocation is not a reallocation"), State.GetNumReallocations(), 0u);
+
+	TestEqual(TEXT("same sender, nothing to do"), State.Update(MakeSender(1280, 720, 0x100)), ESpoutReceiverAction::None);
+
+	// Next ring slot: same size and format, new shared texture.
+	TestEqual(TEXT("handle change reopens"), State.Update(MakeSender(1280, 720, 0x104)), ESpoutReceiverAction::Reopen);
+	TestEqual(TEXT("reopen keeps the allocation"), State.GetNumReallocations(), 0u);
+	TestEqual(TEXT("sender tracks the new handle"), State.GetSender().Handle, 0x104u);
+
+	TestEqual(TEXT("size change reallocates"), State.Update(MakeSender(1920, 1080, 0x108)), ESpoutReceiverAction::Reallocate);
+	TestEqual(TEXT("one reallocation"), State.GetNumReallocations(), 1u);
+	TestEqual(TEXT("allocation follows the size"), State.GetAllocation().Width, 1920u);
+
+	TestEqual(TEXT("format change reallocates"), State.Update(MakeSender(1920, 1080, 0x108, FormatRGBA16F)), ESpoutReceiverAction::Reallocate);
+	TestEqual(TEXT("two reallocations"), State.GetNumReallocations(), 2u);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutReceiverStateDisconnectTest, "UnrealSpout.ReceiverState.Disconnect", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutReceiverStateDisconnectTest::RunTest(const FString& Parameters)
+{
+	FSpoutReceiverState State;
+	State.Update(MakeSender(640, 480, 0x200));
+
+	TestEqual(TEXT("sender gone"), State.Update(FSpoutSenderDesc()), ESpoutReceiverAction::Disconnect);
+	TestFalse(TEXT("not connected"), State.IsConnected());
+	TestEqual(TEXT("disconnect only once"), State.Update(FSpoutSenderDesc()), ESpoutReceiverAction::None);
+	TestEqual(TEXT("allocation outlives the sender"), State.GetAllocation().Width, 640u);
+
+	// A half-written description (no handle yet) counts as no sender.
+	TestEqual(TEXT("invalid sender is ignored"), State.Update(MakeSender(640, 480, 0)), ESpoutReceiverAction::None);
+
+	// Back at the same size: only the shared texture is reopened, even with an unchanged handle.
+	TestEqual(TEXT("return at the same size reopens"), State.Update(MakeSender(640, 480, 0x200)), ESpoutReceiverAction::Reopen);
+	TestEqual(TEXT("no reallocation for a return"), State.GetNumReallocations(), 0u);
+
+	State.Update(FSpoutSenderDesc());
+	TestEqual(TEXT("return at a new size reallocates"), State.Update(MakeSender(800, 600, 0x204)), ESpoutReceiverAction::Reallocate);
+	TestEqual(TEXT("one reallocation"), State.GetNumReallocations(), 1u);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutReceiverStateResetTest, "UnrealSpout.ReceiverState.Reset", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutReceiverStateResetTest::RunTest(const FString& Parameters)
+{
+	FSpoutReceiverState State;
+	State.Update(MakeSender(640, 480, 0x300));
+	State.Update(MakeSender(320, 240, 0x300));
+
+	State.Reset();
+	TestFalse(TEXT("not connected after reset"), State.IsConnected());
+	TestFalse(TEXT("no allocation after reset"), State.GetAllocation().IsValid());
+	TestFalse(TEXT("no sender after reset"), State.GetSender().IsValid());
+
+	// The intermediate texture is gone, so even the same sender needs a fresh one.
+	TestEqual(TEXT("same sender allocates again"), State.Update(MakeSender(320, 240, 0x300)), ESpoutReceiverAction::Allocate);
+	TestEqual(TEXT("reallocations are kept across a reset"), State.GetNumReallocations(), 1u);
+	return true;
+}
+
+#endif
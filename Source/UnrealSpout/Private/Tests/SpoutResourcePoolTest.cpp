@@ -0,0 +1,116 @@
+#include "Misc/AutomationTest.h"
+#include "SpoutResourcePool.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	using FTestPool = TSpoutResourcePool<int32, int32>;
+
+	/** Values evicted from a pool, in eviction order. */
+	struct FEvictions
+	{
+		TArray<int32> Values;
+
+		FTestPool::FOnEvict Recorder()
+		{
+			return [this](const int32&, int32& Value) { Values.Add(Value); };
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutResourcePoolHitMissTest, "UnrealSpout.ResourcePool.HitMiss", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutResourcePoolHitMissTest::RunTest(const FString& Parameters)
+{
+	FEvictions Evictions;
+	FTestPool Pool(4, 100, Evictions.Recorder());
+
+	int32 Value = 0;
+	TestFalse(TEXT("empty pool misses"), Pool.Acquire(1, Value));
+
+	Pool.Release(1, 10, 0);
+	Pool.Release(2, 20, 1);
+	Pool.Release(1, 11, 2);
+	TestEqual(TEXT("three idle"), Pool.NumIdle(), 3);
+
+	TestTrue(TEXT("hit on key 1"), Pool.Acquire(1, Value));
+	TestEqual(TEXT("most recently released value first"), Value, 11);
+	TestTrue(TEXT("second hit on key 1"), Pool.Acquire(1, Value));
+	TestEqual(TEXT("then the older one"), Value, 10);
+	TestFalse(TEXT("key 1 drained"), Pool.Acquire(1, Value));
+	TestFalse(TEXT("unknown key misses"), Pool.Acquire(3, Value));
+
+	TestEqual(TEXT("hits"), Pool.GetStats().Hits, uint64(2));
+	TestEqual(TEXT("misses"), Pool.GetStats().Misses, uint64(3));
+	TestEqual(TEXT("acquired values are not evicted"), Evictions.Values.Num(), 0);
+	TestEqual(TEXT("one idle"), Pool.NumIdle(), 1);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutResourcePoolMaxIdleTest, "UnrealSpout.ResourcePool.MaxIdle", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutResourcePoolMaxIdleTest::RunTest(const FString& Parameters)
+{
+	FEvictions Evictions;
+	FTestPool Pool(3, 1000, Evictions.Recorder());
+
+	for (int32 i = 0; i < 3; ++i)
+		Pool.Release(i, 100 + i, i);
+	TestEqual(TEXT("at capacity, nothing evicted"), Evictions.Values.Num(), 0);
+
+	// Over capacity: the least recently released go first, whatever their key.
+	Pool.Release(0, 103, 3);
+	Pool.Release(5, 104, 4);
+	TestEqual(TEXT("still at capacity"), Pool.NumIdle(), 3);
+	TestEqual(TEXT("two evicted"), Evictions.Values, TArray<int32>({ 100, 101 }));
+
+	// Taking a value out and putting it back makes it the newest.
+	int32 Value = 0;
+	Pool.Acquire(2, Value);
+	Pool.Release(2, Value, 5);
+	Pool.Release(6, 105, 6);
+	TestEqual(TEXT("the oldest after the round trip"), Evictions.Values, TArray<int32>({ 100, 101, 103 }));
+	TestEqual(TEXT("evictions counted"), Pool.GetStats().Evictions, uint64(3));
+
+	Pool.Empty();
+	TestEqual(TEXT("empty evicts the rest"), Evictions.Values.Num(), 6);
+	TestEqual(TEXT("nothing idle"), Pool.NumIdle(), 0);
+
+	// With MaxIdle 0 nothing is kept.
+	FEvictions NoneKept;
+	FTestPool Passthrough(0, 1000, NoneKept.Recorder());
+	Passthrough.Release(1, 1, 0);
+	TestEqual(TEXT("zero capacity evicts at once"), NoneKept.Values, TArray<int32>({ 1 }));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutResourcePoolTrimTest, "UnrealSpout.ResourcePool.Trim", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutResourcePoolTrimTest::RunTest(const FString& Parameters)
+{
+	FEvictions Evictions;
+	FTestPool Pool(8, 10, Evictions.Recorder());
+
+	Pool.Release(1, 1, 0);
+	Pool.Release(2, 2, 5);
+	Pool.Release(3, 3, 8);
+
+	TestEqual(TEXT("nothing older than the limit"), Pool.Trim(10), 0);
+	TestEqual(TEXT("the first ages out"), Pool.Trim(11), 1);
+	TestEqual(TEXT("it was the oldest"), Evictions.Values, TArray<int32>({ 1 }));
+	TestEqual(TEXT("the rest age out together"), Pool.Trim(100), 2);
+	TestEqual(TEXT("in release order"), Evictions.Values, TArray<int32>({ 1, 2, 3 }));
+	TestEqual(TEXT("nothing idle"), Pool.NumIdle(), 0);
+
+	// A value taken and released again restarts its age.
+	Pool.Release(4, 4, 100);
+	int32 Value = 0;
+	Pool.Acquire(4, Value);
+	Pool.Release(4, Value, 120);
+	TestEqual(TEXT("re-released value is young"), Pool.Trim(125), 0);
+	TestEqual(TEXT("still idle"), Pool.NumIdle(), 1);
+	return true;
+}
+
+#endif
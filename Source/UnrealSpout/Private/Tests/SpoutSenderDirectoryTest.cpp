@@ -0,0 +1,247 @@
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformProcess.h"
+
+#include "SpoutSenderDirectory.h"
+#include "SpoutSharedMemoryRegion.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	using FLayout = FSpoutSenderDirectoryLayout;
+
+	/** A sender directory no real sender or receiver uses, removed again when the test ends. Raw maps it too, to look at slot states. */
+	struct FPrivateDirectory
+	{
+		explicit FPrivateDirectory(const TCHAR* Test)
+			: RegionName(FString::Printf(TEXT("UnrealSpout%sTest_%u"), Test, FPlatformProcess::GetCurrentProcessId()))
+			, Directory(FSpoutSenderDirectory::OpenOrCreate(TCHAR_TO_ANSI(*RegionName)))
+			, Raw(SpoutSharedMemory::Create(TCHAR_TO_ANSI(*RegionName), sizeof(FLayout)))
+		{}
+
+		~FPrivateDirectory()
+		{
+			Directory.Reset();
+			Raw.Reset();
+			SpoutSharedMemory::Remove(TCHAR_TO_ANSI(*RegionName));
+		}
+
+		bool IsValid() const { return Directory.IsValid() && Raw.IsValid(); }
+
+		FLayout::ESlotTag GetTag(int32 Slot) const
+		{
+			const FLayout& Layout = *reinterpret_cast<const FLayout*>(Raw->GetData());
+			return static_cast<FLayout::ESlotTag>(Layout.Slots[Slot & (FLayout::NumSlots - 1)].State & 3);
+		}
+
+		FString RegionName;
+		TUniquePtr<FSpoutSenderDirectory> Directory;
+		TUniquePtr<ISpoutSharedMemoryRegion> Raw;
+	};
+
+	/** Count names that all hash to one home slot, so they share a probe chain. OutHome is that slot. */
+	TArray<TArray<ANSICHAR>> MakeCollidingNames(const TCHAR* Prefix, int32 Count, int32& OutHome)
+	{
+		constexpr uint64 Mask = FLayout::NumSlots - 1;
+
+		TArray<TArray<ANSICHAR>> Names;
+		OutHome = INDEX_NONE;
+		for (int32 i = 0; Names.Num() < Count; ++i)
+		{
+			const auto Converted = StringCast<ANSICHAR>(*FString::Printf(TEXT("%s %d"), Prefix, i));
+			const int32 Home = static_cast<int32>(FSpoutSenderDirectory::HashName(Converted.Get()) & Mask);
+			if (OutHome == INDEX_NONE)
+				OutHome = Home;
+			if (Home == OutHome)
+				Names.Emplace(Converted.Get(), Converted.Length() + 1);
+		}
+		return Names;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutSenderDirectoryRegisterTest, "UnrealSpout.SenderDirectory.Register", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutSenderDirectoryRegisterTest::RunTest(const FString& Parameters)
+{
+	FPrivateDirectory Private(TEXT("DirectoryRegister"));
+	if (!TestTrue(TEXT("private directory"), Private.IsValid()))
+		return false;
+	FSpoutSenderDirectory& Directory = *Private.Directory;
+
+	const uint64 Generation = Directory.GetGeneration();
+	const int32 Slot = Directory.Register("Camera", 1, 0);
+	TestTrue(TEXT("registered"), Slot != INDEX_NONE);
+	TestEqual(TEXT("found"), Directory.Find("Camera"), Slot);
+	TestEqual(TEXT("one entry"), Directory.Num(), 1);
+	TestTrue(TEXT("generation moved"), Directory.GetGeneration() != Generation);
+
+	// Registering again is idempotent for the owner, and refused for anyone else while it lives.
+	const uint64 Registered = Directory.GetGeneration();
+	TestEqual(TEXT("same owner, same slot"), Directory.Register("Camera", 1, 10), Slot);
+	TestEqual(TEXT("generation unchanged"), Directory.GetGeneration(), Registered);
+	TestEqual(TEXT("other live owner refused"), Directory.Register("Camera", 2, 10), int32(INDEX_NONE));
+
+	// Names the SDK couldn't hold are refused.
+	TestEqual(TEXT("empty name refused"), Directory.Register("", 1, 0), int32(INDEX_NONE));
+	TArray<ANSICHAR> Long;
+	Long.Init('x', FLayout::MaxNameLength);
+	Long.Last() = '\0';
+	TestTrue(TEXT("longest name accepted"), Directory.Register(Long.GetData(), 1, 0) != INDEX_NONE);
+	Long.Init('y', FLayout::MaxNameLength + 1);
+	Long.Last() = '\0';
+	TestEqual(TEXT("too long refused"), Directory.Register(Long.GetData(), 1, 0), int32(INDEX_NONE));
+
+	Directory.Register("Projector", 1, 0);
+	const FSpoutSenderDirectory::FSnapshot Snapshot = Directory.TakeSnapshot();
+	TestEqual(TEXT("snapshot at the current generation"), Snapshot.Generation, Directory.GetGeneration());
+	TestEqual(TEXT("snapshot size"), Snapshot.Num(), 3);
+	TestTrue(TEXT("snapshot names"), Snapshot.Names.Contains(TEXT("Camera")) && Snapshot.Names.Contains(TEXT("Projector")));
+
+	// Only the owner unregisters.
+	TestFalse(TEXT("other owner can't unregister"), Directory.Unregister("Camera", 2));
+	TestTrue(TEXT("owner unregisters"), Directory.Unregister("Camera", 1));
+	TestFalse(TEXT("gone"), Directory.Unregister("Camera", 1));
+	TestEqual(TEXT("not found"), Directory.Find("Camera"), int32(INDEX_NONE));
+	TestEqual(TEXT("two entries"), Directory.Num(), 2);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutSenderDirectoryChainTest, "UnrealSpout.SenderDirectory.Chains", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutSenderDirectoryChainTest::RunTest(const FString& Parameters)
+{
+	FPrivateDirectory Private(TEXT("DirectoryChains"));
+	if (!TestTrue(TEXT("private directory"), Private.IsValid()))
+		return false;
+	FSpoutSenderDirectory& Directory = *Private.Directory;
+
+	int32 Home = 0;
+	const TArray<TArray<ANSICHAR>> Names = MakeCollidingNames(TEXT("Chain"), 4, Home);
+	const ANSICHAR* A = Names[0].GetData();
+	const ANSICHAR* B = Names[1].GetData();
+	const ANSICHAR* C = Names[2].GetData();
+	const ANSICHAR* D = Names[3].GetData();
+
+	// One home slot: each name probes on to the next.
+	TestEqual(TEXT("first at home"), Directory.Register(A, 1, 0), Home);
+	TestEqual(TEXT("second next"), Directory.Register(B, 1, 0), (Home + 1) & (FLayout::NumSlots - 1));
+	TestEqual(TEXT("third after it"), Directory.Register(C, 1, 0), (Home + 2) & (FLayout::NumSlots - 1));
+
+	// Removing from the middle leaves a tombstone the chain runs through.
+	Directory.Unregister(B, 1);
+	TestEqual(TEXT("tombstone in the middle"), Private.GetTag(Home + 1), FLayout::Removed);
+	TestEqual(TEXT("found past the tombstone"), Directory.Find(C), (Home + 2) & (FLayout::NumSlots - 1));
+	TestEqual(TEXT("tombstone reused"), Directory.Register(D, 1, 0), (Home + 1) & (FLayout::NumSlots - 1));
+
+	// A name already past a tombstone is found, not registered twice.
+	Directory.Unregister(D, 1);
+	TestEqual(TEXT("existing entry past a tombstone"), Directory.Register(C, 1, 0), (Home + 2) & (FLayout::NumSlots - 1));
+
+	// Removing the end of the chain empties the tombstones before it too.
+	Directory.Unregister(C, 1);
+	TestEqual(TEXT("end of chain emptied"), Private.GetTag(Home + 2), FLayout::Empty);
+	TestEqual(TEXT("tombstone before it emptied"), Private.GetTag(Home + 1), FLayout::Empty);
+	TestEqual(TEXT("live head kept"), Private.GetTag(Home), FLayout::Live);
+	Directory.Unregister(A, 1);
+	TestEqual(TEXT("whole chain empty"), Private.GetTag(Home), FLayout::Empty);
+	TestEqual(TEXT("nothing left"), Directory.Num(), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutSenderDirectoryStaleTest, "UnrealSpout.SenderDirectory.Stale", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutSenderDirectoryStaleTest::RunTest(const FString& Parameters)
+{
+	constexpr int64 Timeout = FSpoutSenderDirectory::DefaultTimeoutMs;
+
+	FPrivateDirectory Private(TEXT("DirectoryStale"));
+	if (!TestTrue(TEXT("private directory"), Private.IsValid()))
+		return false;
+	FSpoutSenderDirectory& Directory = *Private.Directory;
+
+	// A crashed process's entry is taken over once its heartbeat is older than the timeout.
+	const int32 Crashed = Directory.Register("Crashed", 1, 0);
+	TestEqual(TEXT("refused while live"), Directory.Register("Crashed", 2, Timeout), int32(INDEX_NONE));
+	const int32 TakenOver = Directory.Register("Crashed", 2, Timeout + 1);
+	TestTrue(TEXT("taken over once dead"), TakenOver != INDEX_NONE);
+	TestFalse(TEXT("old owner's heartbeat fails"), Directory.Heartbeat(Crashed, 1, Timeout + 1));
+	TestTrue(TEXT("new owner's heartbeat"), Directory.Heartbeat(TakenOver, 2, Timeout + 1));
+	TestEqual(TEXT("one entry"), Directory.Num(), 1);
+
+	// Heartbeats keep entries alive through ReclaimStale; silent ones go.
+	const int32 Alive = Directory.Register("Alive", 3, 0);
+	Directory.Register("Silent", 4, 0);
+	Directory.Heartbeat(Alive, 3, 2 * Timeout);
+	Directory.Heartbeat(TakenOver, 2, 2 * Timeout);
+	TestEqual(TEXT("nothing stale yet"), Directory.ReclaimStale(Timeout), 0);
+	TestEqual(TEXT("silent entry reclaimed"), Directory.ReclaimStale(2 * Timeout), 1);
+	TestEqual(TEXT("silent gone"), Directory.Find("Silent"), int32(INDEX_NONE));
+	TestTrue(TEXT("alive kept"), Directory.Find("Alive") == Alive);
+	TestEqual(TEXT("two entries"), Directory.Num(), 2);
+	TestFalse(TEXT("out of range heartbeat"), Directory.Heartbeat(FLayout::NumSlots, 3, 0));
+
+	// A writer that died between claiming a slot and making it live: reclaimed, never counted.
+	FLayout& Layout = *reinterpret_cast<FLayout*>(Private.Raw->GetData());
+	int32 Orphan = 0;
+	while (Private.GetTag(Orphan) != FLayout::Empty)
+		++Orphan;
+	Layout.Slots[Orphan].HeartbeatMs = 0;
+	Layout.Slots[Orphan].State = (Layout.Slots[Orphan].State & ~uint64(3)) | FLayout::Claimed;
+	TestEqual(TEXT("orphaned claim reclaimed"), Directory.ReclaimStale(2 * Timeout), 1);
+	TestTrue(TEXT("no longer claimed"), Private.GetTag(Orphan) != FLayout::Claimed);
+	TestEqual(TEXT("still two entries"), Directory.Num(), 2);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutSenderDirectoryParallelTest, "UnrealSpout.SenderDirectory.ParallelChains", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutSenderDirectoryParallelTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumThreads = 4;
+	constexpr int32 NamesPerThread = 4;
+	constexpr int32 Rounds = 5000;
+
+	FPrivateDirectory Private(TEXT("DirectoryParallel"));
+	if (!TestTrue(TEXT("private directory"), Private.IsValid()))
+		return false;
+	FSpoutSenderDirectory& Directory = *Private.Directory;
+
+	// Every name on one probe chain, so registering, tombstoning and emptying all race on it.
+	int32 Home = 0;
+	const TArray<TArray<ANSICHAR>> Names = MakeCollidingNames(TEXT("Parallel"), NumThreads * NamesPerThread, Home);
+
+	std::atomic<int32> Refused { 0 };
+	std::atomic<int32> Lost { 0 };
+	std::vector<std::thread> Threads;
+	for (int32 t = 0; t < NumThreads; ++t)
+	{
+		Threads.emplace_back([&, t]()
+		{
+			const int64 Owner = t + 1;
+			for (int32 Round = 0; Round < Rounds; ++Round)
+			{
+				for (int32 n = 0; n < NamesPerThread; ++n)
+					Refused += Directory.Register(Names[t * NamesPerThread + n].GetData(), Owner, 0) == INDEX_NONE ? 1 : 0;
+				for (int32 n = 0; n < NamesPerThread; ++n)
+					Lost += Directory.Find(Names[t * NamesPerThread + n].GetData()) == INDEX_NONE ? 1 : 0;
+				for (int32 n = 0; n < NamesPerThread; ++n)
+					Lost += Directory.Unregister(Names[t * NamesPerThread + n].GetData(), Owner) ? 0 : 1;
+			}
+		});
+	}
+	for (std::thread& Thread : Threads)
+		Thread.join();
+
+	TestEqual(TEXT("no register refused"), Refused.load(), 0);
+	TestEqual(TEXT("no held name missing"), Lost.load(), 0);
+	TestEqual(TEXT("nothing left"), Directory.Num(), 0);
+	for (const TArray<ANSICHAR>& Name : Names)
+		TestEqual(TEXT("unlisted"), Directory.Find(Name.GetData()), int32(INDEX_NONE));
+	return true;
+}
+
+#endif
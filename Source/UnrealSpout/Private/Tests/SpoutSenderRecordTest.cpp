@@ -0,0 +1,193 @@
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformProcess.h"
+
+#include "SpoutSenderRecord.h"
+#include "SpoutSharedMemoryRegion.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** A sender name no real sender uses, whose record region is removed again when the test ends. */
+	struct FPrivateSender
+	{
+		explicit FPrivateSender(const TCHAR* Test)
+		{
+			const auto Converted = StringCast<ANSICHAR>(*FString::Printf(TEXT("UnrealSpout%sTest_%u"), Test, FPlatformProcess::GetCurrentProcessId()));
+			Name.Append(Converted.Get(), Converted.Length() + 1);
+		}
+
+		~FPrivateSender()
+		{
+			SpoutSharedMemory::Remove(TCHAR_TO_ANSI(*FSpoutSenderRecordWriter::GetRegionName(*Name)));
+		}
+
+		const ANSICHAR* operator*() const { return Name.GetData(); }
+
+		TArray<ANSICHAR> Name;
+	};
+
+	/** Every field derives from the frame number, so a torn copy shows as a mismatch. */
+	FSpoutSenderRecord MakeRecord(uint64 Frame)
+	{
+		FSpoutSenderRecord Record;
+		Record.FrameNumber = Frame;
+		Record.ShareHandle = static_cast<uint32>(Frame * 7);
+		Record.Width = static_cast<uint32>(Frame);
+		Record.Height = static_cast<uint32>(Frame >> 1);
+		Record.Format = 28;
+		Record.NumSlots = FSpoutTextureRing::MaxSlots;
+		Record.PublishedSlot = static_cast<uint32>(Frame % FSpoutTextureRing::MaxSlots);
+		for (int32 i = 0; i < FSpoutTextureRing::MaxSlots; ++i)
+			Record.SlotHandles[i] = static_cast<uint32>(Frame + i);
+		return Record;
+	}
+
+	bool IsConsistent(const FSpoutSenderRecord& Record)
+	{
+		const FSpoutSenderRecord Expected = MakeRecord(Record.FrameNumber);
+		return FMemory::Memcmp(&Record, &Expected, sizeof(Record)) == 0;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutSenderRecordPublishTest, "UnrealSpout.SenderRecord.Publish", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutSenderRecordPublishTest::RunTest(const FString& Parameters)
+{
+	FPrivateSender Sender(TEXT("RecordPublish"));
+	TestNull(TEXT("no record before the sender creates one"), FSpoutSenderRecordReader::Open(*Sender).Get());
+
+	TUniquePtr<FSpoutSenderRecordWriter> Writer = FSpoutSenderRecordWriter::Create(*Sender);
+	TUniquePtr<FSpoutSenderRecordReader> Reader = FSpoutSenderRecordReader::Open(*Sender);
+	if (!TestTrue(TEXT("writer and reader"), Writer.IsValid() && Reader.IsValid()))
+		return false;
+
+	FSpoutSenderRecord Record;
+	TestFalse(TEXT("nothing to read before the first publish"), Reader->Read(Record));
+
+	Writer->Publish(MakeRecord(10));
+	TestTrue(TEXT("read after publish"), Reader->Read(Record));
+	TestTrue(TEXT("every field as published"), IsConsistent(Record) && Record.FrameNumber == 10);
+
+	// Poll reports each frame once.
+	TestEqual(TEXT("new frame"), Reader->Poll(Record), FSpoutSenderRecordReader::EResult::NewFrame);
+	Reader->MarkConsumed(Record.FrameNumber);
+	TestEqual(TEXT("consumed"), Reader->Poll(Record), FSpoutSenderRecordReader::EResult::Unchanged);
+	Writer->Publish(MakeRecord(11));
+	TestEqual(TEXT("next frame"), Reader->Poll(Record), FSpoutSenderRecordReader::EResult::NewFrame);
+	Reader->MarkConsumed(Record.FrameNumber);
+	Reader->Reset();
+	TestEqual(TEXT("new again after a reset"), Reader->Poll(Record), FSpoutSenderRecordReader::EResult::NewFrame);
+
+	// Slot counts beyond the ring are clamped.
+	FSpoutSenderRecord TooMany = MakeRecord(12);
+	TooMany.NumSlots = 100;
+	Writer->Publish(TooMany);
+	TestTrue(TEXT("read clamped record"), Reader->Read(Record));
+	TestEqual(TEXT("slot count clamped"), Record.NumSlots, uint32(FSpoutTextureRing::MaxSlots));
+
+	// A closed sender sends readers back to the legacy lookup.
+	Writer->Close();
+	TestFalse(TEXT("nothing to read once closed"), Reader->Read(Record));
+	TestEqual(TEXT("unavailable once closed"), Reader->Poll(Record), FSpoutSenderRecordReader::EResult::Unavailable);
+	TestEqual(TEXT("no retries without contention"), Reader->GetNumRetries(), uint64(0));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutSenderRecordTakeoverTest, "UnrealSpout.SenderRecord.Takeover", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutSenderRecordTakeoverTest::RunTest(const FString& Parameters)
+{
+	FPrivateSender Sender(TEXT("RecordTakeover"));
+	TUniquePtr<FSpoutSenderRecordWriter> Writer = FSpoutSenderRecordWriter::Create(*Sender);
+	TUniquePtr<FSpoutSenderRecordReader> Reader = FSpoutSenderRecordReader::Open(*Sender);
+	TUniquePtr<ISpoutSharedMemoryRegion> Raw = SpoutSharedMemory::Create(TCHAR_TO_ANSI(*FSpoutSenderRecordWriter::GetRegionName(*Sender)), sizeof(FSpoutSenderRecordLayout));
+	if (!TestTrue(TEXT("writer, reader and raw mapping"), Writer.IsValid() && Reader.IsValid() && Raw.IsValid()))
+		return false;
+
+	FSpoutSenderRecordLayout& Layout = *reinterpret_cast<FSpoutSenderRecordLayout*>(Raw->GetData());
+	Writer->Publish(MakeRecord(5));
+	const uint64 Published = Layout.Sequence;
+	TestTrue(TEXT("even after a publish"), Published != 0 && (Published & 1) == 0);
+
+	// A sender that died mid-publish leaves the sequence odd: readers give up rather than spin.
+	Writer.Reset();
+	Layout.Sequence = Published + 1;
+	FSpoutSenderRecord Record;
+	TestFalse(TEXT("no read while a publish is open"), Reader->Read(Record));
+	TestEqual(TEXT("retried up to the limit"), Reader->GetNumRetries(), uint64(FSpoutSenderRecordReader::MaxReadAttempts - 1));
+
+	// The next sender of that name closes the open publish and carries the sequence on.
+	Writer = FSpoutSenderRecordWriter::Create(*Sender);
+	TestEqual(TEXT("open publish closed"), Layout.Sequence, Published + 2);
+	TestTrue(TEXT("readable again"), Reader->Read(Record) && Record.FrameNumber == 5);
+	Writer->Publish(MakeRecord(6));
+	TestEqual(TEXT("sequence carried on"), Layout.Sequence, Published + 4);
+	TestTrue(TEXT("new sender's frame"), Reader->Read(Record) && Record.FrameNumber == 6);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutSenderRecordConcurrentTest, "UnrealSpout.SenderRecord.Concurrent", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutSenderRecordConcurrentTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumReaders = 4;
+	constexpr uint64 NumPublishes = 50000;
+
+	FPrivateSender Sender(TEXT("RecordConcurrent"));
+	TUniquePtr<FSpoutSenderRecordWriter> Writer = FSpoutSenderRecordWriter::Create(*Sender);
+	if (!TestTrue(TEXT("writer"), Writer.IsValid()))
+		return false;
+	Writer->Publish(MakeRecord(1));
+
+	// Readers copy the record while it is republished as fast as possible: every copy they
+	// accept must be whole, and frames must never go backwards.
+	std::atomic<bool> bStop { false };
+	std::atomic<int32> Torn { 0 };
+	std::atomic<int32> Backwards { 0 };
+	std::atomic<uint64> Accepted { 0 };
+	std::atomic<int32> NumOpened { 0 };
+	std::vector<std::thread> Readers;
+	for (int32 i = 0; i < NumReaders; ++i)
+	{
+		Readers.emplace_back([&]()
+		{
+			TUniquePtr<FSpoutSenderRecordReader> Reader = FSpoutSenderRecordReader::Open(*Sender);
+			++NumOpened;
+			if (!Reader.IsValid())
+				return;
+
+			uint64 LastFrame = 0;
+			while (!bStop.load(std::memory_order_relaxed))
+			{
+				FSpoutSenderRecord Record;
+				if (!Reader->Read(Record))
+					continue;
+
+				Torn += IsConsistent(Record) ? 0 : 1;
+				Backwards += Record.FrameNumber < LastFrame ? 1 : 0;
+				LastFrame = Record.FrameNumber;
+				++Accepted;
+			}
+		});
+	}
+
+	while (NumOpened.load() < NumReaders)
+		FPlatformProcess::Yield();
+	for (uint64 Frame = 2; Frame <= NumPublishes; ++Frame)
+		Writer->Publish(MakeRecord(Frame));
+	bStop = true;
+	for (std::thread& Thread : Readers)
+		Thread.join();
+
+	TestEqual(TEXT("no torn reads"), Torn.load(), 0);
+	TestEqual(TEXT("frames never go backwards"), Backwards.load(), 0);
+	TestTrue(TEXT("readers got through"), Accepted.load() > 0);
+	return true;
+}
+
+#endif
@@ -0,0 +1,145 @@
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformProcess.h"
+#include "Math/RandomStream.h"
+#include "Algo/Count.h"
+
+#include "SpoutConsumerTable.h"
+#include "SpoutSenderDirectory.h"
+#include "SpoutSenderRegistry.h"
+#include "SpoutSharedMemoryRegion.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** A sender directory no real sender or receiver uses, removed again when the test ends. */
+	struct FPrivateDirectory
+	{
+		explicit FPrivateDirectory(const TCHAR* Test)
+			: RegionName(FString::Printf(TEXT("UnrealSpout%sTest_%u"), Test, FPlatformProcess::GetCurrentProcessId()))
+			, Directory(FSpoutSenderDirectory::OpenOrCreate(TCHAR_TO_ANSI(*RegionName)))
+		{}
+
+		~FPrivateDirectory()
+		{
+			Directory.Reset();
+			SpoutSharedMemory::Remove(TCHAR_TO_ANSI(*RegionName));
+		}
+
+		FString RegionName;
+		TUniquePtr<FSpoutSenderDirectory> Directory;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutSenderRegistryCountTest, "UnrealSpout.SenderRegistry.Count", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutSenderRegistryCountTest::RunTest(const FString& Parameters)
+{
+	FPrivateDirectory Private(TEXT("RegistryCount"));
+	if (!TestNotNull(TEXT("private directory"), Private.Directory.Get()))
+		return false;
+
+	const int64 Now = FSpoutConsumerTable::NowMs();
+	FSpoutSenderRegistry Registry(Private.Directory.Get(), 1, FSpoutSenderDirectory::DefaultTimeoutMs);
+
+	int32 Count = 0;
+	const FSpoutSenderRegistry::FWriters Writers = Registry.Acquire("Camera", Now, &Count);
+	TestEqual(TEXT("first reference"), Count, 1);
+	TestFalse(TEXT("no writers unless asked for"), Writers.Record.IsValid() || Writers.FrameSignal.IsValid());
+	TestTrue(TEXT("listed in the directory"), Private.Directory->Find("Camera") != INDEX_NONE);
+
+	Registry.Acquire("Camera", Now, &Count);
+	TestEqual(TEXT("second reference"), Count, 2);
+	TestEqual(TEXT("one name held"), Registry.Num(), 1);
+
+	TestEqual(TEXT("one reference left"), Registry.Release("Camera"), 1);
+	TestTrue(TEXT("still listed"), Private.Directory->Find("Camera") != INDEX_NONE);
+	TestEqual(TEXT("last reference gone"), Registry.Release("Camera"), 0);
+	TestEqual(TEXT("unlisted"), Private.Directory->Find("Camera"), int32(INDEX_NONE));
+	TestEqual(TEXT("nothing held"), Registry.Num(), 0);
+
+	// Another live owner holds the name: counted here, but not listed as ours.
+	Private.Directory->Register("Shared", 2, Now);
+	Registry.Acquire("Shared", Now, &Count);
+	TestEqual(TEXT("counted despite the other owner"), Count, 1);
+	TestEqual(TEXT("released"), Registry.Release("Shared"), 0);
+	TestTrue(TEXT("the other owner keeps its entry"), Private.Directory->Find("Shared") != INDEX_NONE);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutSenderRegistryChurnTest, "UnrealSpout.SenderRegistry.ParallelChurn", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutSenderRegistryChurnTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumNames = 16;
+	constexpr int32 NumThreads = 8;
+	constexpr int32 OpsPerThread = 20000;
+	constexpr int32 MaxHeld = 8;
+
+	FPrivateDirectory Private(TEXT("RegistryChurn"));
+	if (!TestNotNull(TEXT("private directory"), Private.Directory.Get()))
+		return false;
+
+	TArray<TArray<ANSICHAR>> Names;
+	for (int32 i = 0; i < NumNames; ++i)
+	{
+		const auto Converted = StringCast<ANSICHAR>(*FString::Printf(TEXT("Churn %02d"), i));
+		Names.Emplace(Converted.Get(), Converted.Length() + 1);
+	}
+
+	FSpoutSenderRegistry Registry(Private.Directory.Get(), 1, FSpoutSenderDirectory::DefaultTimeoutMs);
+
+	// Few names, many threads: acquires and releases of one name race all the time. While a
+	// thread holds a name its count can't drop below one, and it must stay listed.
+	std::atomic<int32> BadCounts { 0 };
+	std::atomic<int32> Unlisted { 0 };
+	std::vector<std::thread> Threads;
+	for (int32 t = 0; t < NumThreads; ++t)
+	{
+		Threads.emplace_back([&, t]()
+		{
+			FRandomStream Random(t + 1);
+			TArray<int32, TInlineAllocator<MaxHeld>> Held;
+			for (int32 Op = 0; Op < OpsPerThread; ++Op)
+			{
+				if (Held.Num() < MaxHeld && (Held.Num() == 0 || Random.RandRange(0, 1) == 0))
+				{
+					const int32 Name = Random.RandRange(0, NumNames - 1);
+					int32 Count = 0;
+					Registry.Acquire(Names[Name].GetData(), FSpoutConsumerTable::NowMs(), &Count);
+					BadCounts += Count < static_cast<int32>(Algo::Count(Held, Name)) + 1 ? 1 : 0;
+					Unlisted += Private.Directory->Find(Names[Name].GetData()) == INDEX_NONE ? 1 : 0;
+					Held.Add(Name);
+				}
+				else
+				{
+					const int32 Index = Random.RandRange(0, Held.Num() - 1);
+					const int32 Name = Held[Index];
+					Held.RemoveAtSwap(Index);
+					BadCounts += Registry.Release(Names[Name].GetData()) < static_cast<int32>(Algo::Count(Held, Name)) ? 1 : 0;
+				}
+			}
+
+			for (const int32 Name : Held)
+				Registry.Release(Names[Name].GetData());
+		});
+	}
+	for (std::thread& Thread : Threads)
+		Thread.join();
+
+	TestEqual(TEXT("counts never below this thread's references"), BadCounts.load(), 0);
+	TestEqual(TEXT("held names always listed"), Unlisted.load(), 0);
+	TestEqual(TEXT("nothing left in the registry"), Registry.Num(), 0);
+	TestEqual(TEXT("nothing left in the directory"), Private.Directory->Num(), 0);
+	for (const TArray<ANSICHAR>& Name : Names)
+	{
+		TestEqual(TEXT("no references left"), Registry.GetCount(Name.GetData()), 0);
+	}
+	return true;
+}
+
+#endif
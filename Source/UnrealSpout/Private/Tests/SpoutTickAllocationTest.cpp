@@ -0,0 +1,152 @@
+#include "Misc/AutomationTest.h"
+#include "DynamicRHI.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+
+#include "SpoutRHI.h"
+#include "SpoutSenderName.h"
+
+#include <atomic>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/**
+	 * Forwards to the allocator it replaces and counts the allocations made on one thread.
+	 * Installed over GMalloc only for the scope of a measurement. Never freed: another
+	 * thread may still be inside it after GMalloc is restored.
+	 */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInner)
+			: Inner(InInner)
+		{}
+
+		void Begin()
+		{
+			Count = 0;
+			ThreadId = FPlatformTLS::GetCurrentThreadId();
+		}
+
+		int32 End()
+		{
+			ThreadId = 0;
+			return Count.load();
+		}
+
+		virtual void* Malloc(SIZE_T Size, uint32 Alignment) override
+		{
+			Tally();
+			return Inner->Malloc(Size, Alignment);
+		}
+
+		virtual void* TryMalloc(SIZE_T Size, uint32 Alignment) override
+		{
+			Tally();
+			return Inner->TryMalloc(Size, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Size, uint32 Alignment) override
+		{
+			Tally();
+			return Inner->Realloc(Original, Size, Alignment);
+		}
+
+		virtual void* TryRealloc(void* Original, SIZE_T Size, uint32 Alignment) override
+		{
+			Tally();
+			return Inner->TryRealloc(Original, Size, Alignment);
+		}
+
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+	private:
+		void Tally()
+		{
+			if (ThreadId.load(std::memory_order_relaxed) == FPlatformTLS::GetCurrentThreadId())
+				++Count;
+		}
+
+		FMalloc* Inner;
+		std::atomic<uint32> ThreadId { 0 };
+		std::atomic<int32> Count { 0 };
+	};
+
+	/** Heap allocations Function makes on the calling thread. */
+	template <typename FunctionType>
+	int32 CountAllocations(FunctionType Function)
+	{
+		FMalloc* const Original = GMalloc;
+		FCountingMalloc* Counter = new FCountingMalloc(Original);
+
+		GMalloc = Counter;
+		Counter->Begin();
+		Function();
+		const int32 Count = Counter->End();
+		GMalloc = Original;
+		return Count;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutTickAllocationTest, "UnrealSpout.Tick.NoAllocations", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutTickAllocationTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumTicks = 1000;
+
+	// The counter has to see allocations at all, or zero below would prove nothing.
+	const int32 Control = CountAllocations([]() { TArray<int32> Array; Array.Add(1); });
+	if (!TestTrue(TEXT("the counter sees allocations"), Control > 0))
+		return false;
+
+	// First uses resolve and convert; later ticks must not.
+	FName Cached;
+	TArray<ANSICHAR> Buffer;
+	const FName Sender(TEXT("Stage Camera"));
+	TestTrue(TEXT("first update converts"), SpoutSenderName::Update(Sender, Cached, Buffer));
+	TestEqual(TEXT("converted name"), FString(ANSI_TO_TCHAR(Buffer.GetData())), FString(TEXT("Stage Camera")));
+	if (GDynamicRHI)
+		SpoutRHI::GetBackend();
+
+	int32 NumChanged = 0;
+	const int32 NamedTicks = CountAllocations([&]()
+	{
+		for (int32 Tick = 0; Tick < NumTicks; ++Tick)
+		{
+			NumChanged += SpoutSenderName::Update(Sender, Cached, Buffer) ? 1 : 0;
+			if (GDynamicRHI)
+				SpoutRHI::GetBackend();
+		}
+	});
+	TestEqual(TEXT("allocations over steady ticks"), NamedTicks, 0);
+	TestEqual(TEXT("an unchanged name is not converted again"), NumChanged, 0);
+
+	// Following the active sender: FindSender writes its name into the buffer, which must be
+	// cleared again every tick, still without allocating.
+	TestTrue(TEXT("switch to None"), SpoutSenderName::Update(NAME_None, Cached, Buffer));
+	TestEqual(TEXT("None is an empty name"), Buffer[0], ANSICHAR('\0'));
+	const int32 ActiveTicks = CountAllocations([&]()
+	{
+		for (int32 Tick = 0; Tick < NumTicks; ++Tick)
+		{
+			FCStringAnsi::Strncpy(Buffer.GetData(), "Found Sender", SpoutSenderName::MaxLength);
+			SpoutSenderName::Update(NAME_None, Cached, Buffer);
+			NumChanged += Buffer[0] == '\0' ? 0 : 1;
+		}
+	});
+	TestEqual(TEXT("allocations while following the active sender"), ActiveTicks, 0);
+	TestEqual(TEXT("the found name is cleared every tick"), NumChanged, 0);
+	TestEqual(TEXT("buffer keeps the SDK's size"), Buffer.Num(), SpoutSenderName::MaxLength);
+	return true;
+}
+
+#endif
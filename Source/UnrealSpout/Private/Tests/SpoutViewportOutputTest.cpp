@@ -0,0 +1,82 @@
+#include "Misc/AutomationTest.h"
+#include "SpoutConversion.h"
+#include "ViewportSpoutSender.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * AViewportSpoutSender's output: ResolveOutputSize picks the published extent and
+ * FSpoutCopyViewExtension::AddOutputPass reduces the capture into it with the actor's
+ * OutputConversion. The pass itself needs a GPU, so it is checked through ConvertReference.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutViewportOutputSizeTest, "UnrealSpout.Viewport.OutputSize", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutViewportOutputSizeTest::RunTest(const FString& Parameters)
+{
+	const FIntPoint Viewport(1920, 1080);
+
+	TestEqual(TEXT("0 x 0 keeps the viewport size"), SpoutConversion::ResolveOutputSize(Viewport, 0, 0), Viewport);
+	TestEqual(TEXT("explicit size"), SpoutConversion::ResolveOutputSize(Viewport, 640, 480), FIntPoint(640, 480));
+	TestEqual(TEXT("height derived from width"), SpoutConversion::ResolveOutputSize(Viewport, 960, 0), FIntPoint(960, 540));
+	TestEqual(TEXT("width derived from height"), SpoutConversion::ResolveOutputSize(Viewport, 0, 720), FIntPoint(1280, 720));
+	TestEqual(TEXT("derived side is rounded"), SpoutConversion::ResolveOutputSize(FIntPoint(1000, 333), 100, 0), FIntPoint(100, 33));
+	TestEqual(TEXT("negative requests count as 0"), SpoutConversion::ResolveOutputSize(Viewport, -5, -5), Viewport);
+	TestEqual(TEXT("never below 1x1"), SpoutConversion::ResolveOutputSize(FIntPoint(4000, 1), 2, 0), FIntPoint(2, 1));
+	TestEqual(TEXT("empty source"), SpoutConversion::ResolveOutputSize(FIntPoint::ZeroValue, 0, 0), FIntPoint(1, 1));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpoutViewportOutputConversionTest, "UnrealSpout.Viewport.OutputConversion", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpoutViewportOutputConversionTest::RunTest(const FString& Parameters)
+{
+	const FSpoutConversionSettings& Defaults = GetDefault<AViewportSpoutSender>()->GetOutputConversion();
+	TestEqual(TEXT("reductions default to the box filter"), Defaults.Filter, ESpoutResampleFilter::Box);
+	TestTrue(TEXT("default conversion only resamples"), Defaults.IsColorIdentity());
+
+	// An 8x4 capture published at half height: 4x2, each output texel the mean of a 2x2 block.
+	const FIntPoint Capture(8, 4);
+	const FIntPoint Output = SpoutConversion::ResolveOutputSize(Capture, 0, 2);
+	if (!TestEqual(TEXT("half-height output"), Output, FIntPoint(4, 2)))
+		return false;
+
+	TArray<FLinearColor> Src;
+	for (int32 Y = 0; Y < Capture.Y; ++Y)
+	{
+		for (int32 X = 0; X < Capture.X; ++X)
+		{
+			Src.Add(FLinearColor(float(X), float(Y), 0.0f, 1.0f));
+		}
+	}
+
+	TArray<FLinearColor> Dst;
+	Dst.SetNumZeroed(Output.X * Output.Y);
+	SpoutConversion::ConvertReference(Src, Capture, Dst, Output, Defaults);
+	for (int32 Y = 0; Y < Output.Y; ++Y)
+	{
+		for (int32 X = 0; X < Output.X; ++X)
+		{
+			const FLinearColor Expected(X * 2.0f + 0.5f, Y * 2.0f + 0.5f, 0.0f, 1.0f);
+			TestTrue(FString::Printf(TEXT("box texel (%d, %d)"), X, Y), Dst[Y * Output.X + X].Equals(Expected, 1e-5f));
+		}
+	}
+
+	// The settings users change most on top: BGRA output, display-referred, flipped for GL receivers.
+	FSpoutConversionSettings Settings = Defaults;
+	Settings.bSwapRedBlue = true;
+	Settings.ColorConversion = ESpoutColorConversion::LinearToSRGB;
+	Settings.bFlipVertically = true;
+	TestFalse(TEXT("swap, encode and flip need the pass at any size"), Settings.IsColorIdentity());
+
+	const TArray<FLinearColor> Flat = { FLinearColor(0.5f, 0.0f, 0.0f, 1.0f), FLinearColor(0.5f, 0.0f, 0.0f, 1.0f), FLinearColor(0.0f, 0.0f, 0.25f, 1.0f), FLinearColor(0.0f, 0.0f, 0.25f, 1.0f) };
+	TArray<FLinearColor> Converted;
+	Converted.SetNumZeroed(2);
+	SpoutConversion::ConvertReference(Flat, FIntPoint(2, 2), Converted, SpoutConversion::ResolveOutputSize(FIntPoint(2, 2), 1, 0), Settings);
+
+	// 2x2 -> 1x1 averages both rows before the swap and the encode: red 0.25, blue 0.125.
+	const FLinearColor Expected(SpoutConversion::LinearToSRGB(0.125f), 0.0f, SpoutConversion::LinearToSRGB(0.25f), 1.0f);
+	TestTrue(TEXT("swap and encode after the box"), Converted[0].Equals(Expected, 1e-5f));
+	return true;
+}
+
+#endif
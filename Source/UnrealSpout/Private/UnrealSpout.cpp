@@ -5,8 +5,12 @@
 #include "ShaderCore.h"
 #include "Interfaces/IPluginManager.h"
 
+#include "SpoutSharedTexturePool.h"
+
 #define LOCTEXT_NAMESPACE "FUnrealSpoutModule"
 
+DEFINE_LOG_CATEGORY(LogUnrealSpout);
+
 void FUnrealSpoutModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
@@ -18,7 +22,7 @@ void FUnrealSpoutModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
-	
+	FSpoutSharedTexturePool::Get().Empty();
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -1,10 +1,27 @@
 #include "ViewportSpoutSender.h"
+#include "SpoutConversion.h"
+#include "SpoutFormats.h"
+#include "SpoutResizeDetector.h"
 #include "SpoutSenderActorComponent.h"
+#include "SpoutSubsystem.h"
 #include "Components/SceneCaptureComponent2D.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "Kismet/GameplayStatics.h"
 #include "Camera/PlayerCameraManager.h"
 #include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+
+namespace
+{
+   FIntPoint GetGameViewportSize()
+   {
+      if (!GEngine || !GEngine->GameViewport) return FIntPoint::ZeroValue;
+
+      FVector2D Size;
+      GEngine->GameViewport->GetViewportSize(Size);
+      return FIntPoint(FMath::TruncToInt(Size.X), FMath::TruncToInt(Size.Y));
+   }
+}
 
 AViewportSpoutSender::AViewportSpoutSender()
 {
@@ -18,33 +35,115 @@ AViewportSpoutSender::AViewportSpoutSender()
    SceneCapture->CaptureSource     = ESceneCaptureSource::SCS_FinalColorHDR;
 
    SpoutSender = CreateDefaultSubobject<USpoutSenderActorComponent>(TEXT("SpoutSender"));
+
+   // Reductions are mostly downscales, where bilinear would alias.
+   OutputConversion.Filter = ESpoutResampleFilter::Box;
 }
 
 void AViewportSpoutSender::BeginPlay()
 {
    Super::BeginPlay();
+
+   ResizeDetector = MakeShared<FSpoutResizeDetector>(ResizeSettleFrames);
+   ResizeDetector->Update(GetGameViewportSize());
    ValidateOrCreateRT();
-   SceneCapture->bCaptureEveryFrame = true;
-   SceneCapture->bCaptureOnMovement = true;
+
+   // The extension fills ViewRT from the player's own view; a second scene render would be wasted.
+   const bool bUseSceneCapture = Source == ESpoutViewportSource::SceneCapture;
+   SceneCapture->bCaptureEveryFrame = bUseSceneCapture && bAutoCapture;
+   SceneCapture->bCaptureOnMovement = bUseSceneCapture && bAutoCapture;
+   SceneCapture->SetActive(bUseSceneCapture);
+   if (!bUseSceneCapture)
+   {
+      SceneCapture->TextureTarget = nullptr;
+   }
+
    SpoutSender->PublishName  = PublishName;
-   SpoutSender->OutputTexture = ViewRT;
+   SpoutSender->OutputTexture = OutputRT ? OutputRT : ViewRT;
    if (!ViewExt.IsValid())
    {
-       ViewExt = FSceneViewExtensions::NewExtension<FSpoutCopyViewExtension>(this);
+       ViewExt = FSceneViewExtensions::NewExtension<FSpoutCopyViewExtension>();
+   }
+
+   if (Source == ESpoutViewportSource::Backbuffer && GEngine && GEngine->GameViewport)
+   {
+      ViewExt->BindBackBuffer(GEngine->GameViewport->GetWindow().Get());
    }
 }
 
 void AViewportSpoutSender::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+   if (ViewExt.IsValid())
+   {
+      ViewExt->UnbindBackBuffer();
+   }
    ViewExt.Reset();
-   if (ViewRT)
+   ReleaseRTs();
+   if (SpoutSender)
    {
-      ViewRT->ConditionalBeginDestroy();
-      ViewRT = nullptr;
+      SpoutSender->OutputTexture = nullptr;
    }
    Super::EndPlay(EndPlayReason);
 }
 
+void AViewportSpoutSender::Tick(float DeltaSeconds)
+{
+   Super::Tick(DeltaSeconds);
+
+   // Reallocate once a resize has settled rather than on every frame of a window drag.
+   if (ResizeDetector.IsValid())
+   {
+      ResizeDetector->SetSettleTicks(ResizeSettleFrames);
+      if (ResizeDetector->Update(GetGameViewportSize()))
+      {
+         ValidateOrCreateRT();
+      }
+   }
+
+   // Demand-driven: stop rendering the capture while nobody is receiving.
+   const bool bConsumed = !SpoutSender || !SpoutSender->bOnlySendWhenConsumed || SpoutSender->GetConsumerCount() > 0;
+   bPublishing = bConsumed && (!SpoutSender || SpoutSender->ShouldCaptureThisFrame());
+
+   if (Source == ESpoutViewportSource::SceneCapture && SceneCapture)
+   {
+      if (bAutoCapture)
+      {
+         SceneCapture->bCaptureEveryFrame = bConsumed;
+      }
+      else
+      {
+         // Render the capture only on the frames the schedule sends.
+         SceneCapture->bCaptureEveryFrame = false;
+         if (bPublishing)
+         {
+            SceneCapture->CaptureScene();
+         }
+      }
+   }
+
+   // ViewRT is rewritten on every scheduled frame, so a dirty-tracking sender must send them all.
+   if (bPublishing && SpoutSender)
+   {
+      SpoutSender->MarkDirty();
+   }
+
+   UpdateViewExtension();
+}
+
+void AViewportSpoutSender::UpdateViewExtension() const
+{
+   if (!ViewExt.IsValid())
+      return;
+
+   FSpoutCopyViewExtension::FTargets Targets;
+   Targets.bPublishing = bPublishing;
+   Targets.Source = Source;
+   Targets.ViewRT = ViewRT ? ViewRT->GameThread_GetRenderTargetResource() : nullptr;
+   Targets.OutputRT = OutputRT ? OutputRT->GameThread_GetRenderTargetResource() : nullptr;
+   Targets.OutputConversion = OutputConversion;
+   ViewExt->SetTargets(Targets);
+}
+
 void AViewportSpoutSender::SyncToPlayerCamera() const
 {
    APlayerCameraManager* PCM = UGameplayStatics::GetPlayerCameraManager(GetWorld(), 0);
@@ -54,25 +153,60 @@ void AViewportSpoutSender::SyncToPlayerCamera() const
    SceneCapture->FOVAngle = PCM->GetFOVAngle();
 }
 
-void AViewportSpoutSender::ValidateOrCreateRT()
+void AViewportSpoutSender::ReleaseRTs()
 {
-   if (!GEngine || !GEngine->GameViewport) return;
+   // Pooled rather than destroyed, so going back to an earlier size reuses the allocation.
+   USpoutSubsystem* Subsystem = USpoutSubsystem::Get();
+   if (ViewRT && SceneCapture && SceneCapture->TextureTarget == ViewRT)
+   {
+      // Another sender may get it from the pool next; this capture must not keep drawing into it.
+      SceneCapture->TextureTarget = nullptr;
+   }
+   if (ViewRT && Subsystem)
+   {
+      Subsystem->ReleaseRenderTarget(ViewRT);
+   }
+   if (OutputRT && Subsystem)
+   {
+      Subsystem->ReleaseRenderTarget(OutputRT);
+   }
+   ViewRT = nullptr;
+   OutputRT = nullptr;
+}
 
-   FVector2D Size;
-   GEngine->GameViewport->GetViewportSize(Size);
+void AViewportSpoutSender::ValidateOrCreateRT()
+{
+   USpoutSubsystem* Subsystem = USpoutSubsystem::Get();
+   if (!Subsystem || !ResizeDetector.IsValid()) return;
 
-   const int32 W = FMath::TruncToInt(Size.X);
-   const int32 H = FMath::TruncToInt(Size.Y);
+   const int32 W = ResizeDetector->GetSize().X;
+   const int32 H = ResizeDetector->GetSize().Y;
 
+   if (W <= 0 || H <= 0) return;
    if (ViewRT && W == LastW && H == LastH) return;
 
    LastW = W;  LastH = H;
 
-   ViewRT = NewObject<UTextureRenderTarget2D>(this);
-   ViewRT->ClearColor = FLinearColor::Black;
-   ViewRT->InitCustomFormat(LastW, LastH, PF_FloatRGBA, true);
-   ViewRT->UpdateResourceImmediate(true);
+   ReleaseRTs();
+   ViewRT = Subsystem->AcquireRenderTarget(FIntPoint(W, H), PF_FloatRGBA);
+
+   if (Source == ESpoutViewportSource::SceneCapture)
+   {
+      SceneCapture->TextureTarget = ViewRT;
+   }
+
+   // Publish a reduced copy only when it differs from the capture; otherwise ViewRT goes out untouched.
+   const FIntPoint OutSize = SpoutConversion::ResolveOutputSize(FIntPoint(W, H), OutputWidth, OutputHeight);
+   const EPixelFormat OutPF = SpoutFormats::ToPixelFormat(OutputFormat);
+
+   if (OutSize == FIntPoint(W, H) && OutPF == PF_FloatRGBA && OutputConversion.IsColorIdentity())
+   {
+      OutputRT = nullptr;
+   }
+   else
+   {
+      OutputRT = Subsystem->AcquireRenderTarget(OutSize, OutPF);
+   }
 
-   SceneCapture->TextureTarget = ViewRT;
-   SpoutSender ->OutputTexture = ViewRT;
+   SpoutSender ->OutputTexture = OutputRT ? OutputRT : ViewRT;
 } 
\ No newline at end of file
@@ -4,23 +4,53 @@
 #include "SceneViewExtension.h"
 #include "RenderGraphBuilder.h"
 #include "RenderGraphUtils.h"
+#include "SpoutTypes.h"
+
+#include <atomic>
 
-class AViewportSpoutSender;
 class FSceneTextureUniformParameters;
+class FTextureRenderTargetResource;
+class SWindow;
+struct FPostProcessMaterialInputs;
+struct FScreenPassTexture;
 
 /**
- * Copies the ViewportSpoutSender's render-target into Spout's shared texture
- * each frame on the render thread via RDG.  Lives as long as its owning actor.
+ * Fills a ViewportSpoutSender's render-targets on the render thread via RDG: its
+ * reduced output from the SceneCapture, or, depending on Source, its capture
+ * render-target from the main view after tonemapping or from the game window's
+ * back buffer, so no SceneCapture render is needed. Lives as long as its owning actor.
+ *
+ * It never writes Spout's shared textures; the owner's sender component copies
+ * the output into its ring in the Spout batch, behind its frame sync.
  */
 class FSpoutCopyViewExtension final : public FSceneViewExtensionBase
 {
 public:
-    explicit FSpoutCopyViewExtension(const FAutoRegister& AutoRegister,
-                                     AViewportSpoutSender* InOwner)
+    explicit FSpoutCopyViewExtension(const FAutoRegister& AutoRegister)
         : FSceneViewExtensionBase(AutoRegister)
-        , Owner(InOwner)
     {}
 
+    /** The owner's state for the coming frame; sent every tick. */
+    struct FTargets
+    {
+        /** False on frames nothing is sent, so nothing is drawn either. */
+        bool bPublishing = false;
+        ESpoutViewportSource Source = ESpoutViewportSource::SceneCapture;
+        FTextureRenderTargetResource* ViewRT = nullptr;
+        /** Reduced copy of ViewRT that is published, or null when ViewRT is sent as-is. */
+        FTextureRenderTargetResource* OutputRT = nullptr;
+        FSpoutConversionSettings OutputConversion;
+    };
+
+    /** Hands Targets to the render-thread hooks. Game thread. */
+    void SetTargets(const FTargets& Targets);
+
+    /** Starts grabbing Window's back buffer before each present. Game thread. */
+    void BindBackBuffer(SWindow* Window);
+
+    /** Stops the back buffer grab; call before releasing the extension. Game thread. */
+    void UnbindBackBuffer();
+
     /* -------- ISceneViewExtension required stubs -------- */
     virtual void SetupViewFamily          (FSceneViewFamily&)                       override {}
     virtual void SetupView               (FSceneViewFamily&, FSceneView&)          override {}
@@ -38,6 +68,36 @@ public:
         FRHICommandList& RHICmdList,
         FSceneView& InView) override;
 
+    /* -------- Post-tonemap grab -------- */
+    virtual void SubscribeToPostProcessingPass(
+        EPostProcessingPass Pass,
+        const FSceneView& InView,
+        FAfterPassCallbackDelegateArray& InOutPassCallbacks,
+        bool bIsPassEnabled) override;
+
 private:
-    AViewportSpoutSender* Owner = nullptr;
-}; 
\ No newline at end of file
+    /** Converts Src into the owner's output RT when it has one. Returns what the sender publishes. */
+    FRDGTextureRef AddOutputPass(FRDGBuilder& GraphBuilder, FRDGTextureRef Src) const;
+
+    /** Draws Input into the owner's capture RT and, if it has one, its output RT. False if there is nothing to draw to. */
+    bool Grab(FRDGBuilder& GraphBuilder, const FScreenPassTexture& Input) const;
+
+    FScreenPassTexture AfterTonemap_RenderThread(FRDGBuilder& GraphBuilder, const FSceneView& View, const FPostProcessMaterialInputs& Inputs);
+
+    void OnBackBufferReady_RenderThread(SWindow& Window, const FTextureRHIRef& BackBuffer);
+
+    /** FTargets as of the render thread's current frame. Render thread only. */
+    struct FRenderTargets
+    {
+        bool bPublishing = false;
+        ESpoutViewportSource Source = ESpoutViewportSource::SceneCapture;
+        FTextureRHIRef View;
+        FTextureRHIRef Output;
+        FSpoutConversionSettings OutputConversion;
+    };
+    FRenderTargets RenderTargets;
+
+    /** Window whose back buffer is grabbed; compared only, never dereferenced. */
+    std::atomic<SWindow*> BackBufferWindow { nullptr };
+    FDelegateHandle BackBufferHandle;
+};
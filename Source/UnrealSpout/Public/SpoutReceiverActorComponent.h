@@ -6,6 +6,7 @@
 #include "Engine.h"
 #include "Components/ActorComponent.h"
 #include "RHIResources.h"
+#include "SpoutTypes.h"
 
 #include "SpoutReceiverActorComponent.generated.h"
 
@@ -17,19 +18,81 @@ class UNREALSPOUT_API USpoutReceiverActorComponent : public UActorComponent
 	struct SpoutReceiverContext;
 	TSharedPtr<SpoutReceiverContext> context;
 
-	/** Temporary RT used to receive the shared texture (sized and re-created on demand) */
+	/** Temporary RT used to receive the shared texture; taken from the subsystem's pool and replaced when the sender changes size or format */
 	UPROPERTY()
 	UTextureRenderTarget2D* IntermediateTextureResource = nullptr;
 
-	/** Cached SRV for the RT above – reused every frame to avoid re-allocating */
-	FShaderResourceViewRHIRef IntermediateTextureParameterSRV;
+	/** Sender size/format/handle as of the last tick, and what changed since */
+	TSharedPtr<class FSpoutReceiverState> ReceiverState;
 
-	void Tick_RenderThread(FRHICommandListImmediate& RHICmdList, void* hSharehandle, FTextureRenderTargetResource* OutputRenderTargetResource);
+	/** Swaps IntermediateTextureResource for a pooled one of the given size and format, and drops the context bound to the old one */
+	void ReallocateIntermediate(uint32 Width, uint32 Height, EPixelFormat Format);
+	void ReleaseIntermediate();
+
+	/** CPU readback stage while bEnableReadback is set; the context gets its own reference */
+	TSharedPtr<class FSpoutReadback, ESPMode::ThreadSafe> Readback;
+	FSpoutReadbackCallback ReadbackCallback;
+	bool bReadbackBound = false;
+
+	/** SubscribeName converted once for the Spout SDK, refreshed only when the name changes */
+	FName CachedSubscribeName;
+	TArray<ANSICHAR> SubscribeNameAnsi;
+
+	/** OutputRenderTarget resource the context currently writes to; compared only, never dereferenced */
+	FRHITexture* BoundOutputRHI = nullptr;
+
+	/** Conversion last handed to the context */
+	FSpoutConversionSettings BoundConversion;
+
+	/** Reads the sender's published frame number so unchanged frames are not copied again */
+	TSharedPtr<class FSpoutFramePoller> FramePoller;
+
+	/** SubscribeName's lock-free sender record, when its sender publishes one; used instead of FindSender */
+	TSharedPtr<class FSpoutSenderRecordReader> SenderRecord;
+	/** Sender directory generation SenderRecord was last looked for at */
+	uint64 SenderRecordGeneration = MAX_uint64;
+
+	/** bEventDrivenReceive's thread, and the context it stages frames into (shared with it, under its lock) */
+	TSharedPtr<class FSpoutReceiveWorker> ReceiveWorker;
+	struct FReceiveTarget;
+	TSharedPtr<FReceiveTarget, ESPMode::ThreadSafe> ReceiveTarget;
+
+	/** Starts the worker for SubscribeName if needed and points it at the current context */
+	void UpdateReceiveWorker(bool bCopyDropped);
+	void StopReceiveWorker();
+
+	/** Our slot in the sender's consumer table, refreshed every tick so demand-driven senders keep sending */
+	TSharedPtr<class FSpoutConsumerTable> ConsumerTable;
+	TArray<ANSICHAR> ConsumerTableSender;
+	int64 ConsumerId = 0;
+	int32 ConsumerSlot = INDEX_NONE;
+
+	/** SubscribeName's memory share while bMemoryShare is set; its frames are read on the render thread */
+	struct FMemoryShareState;
+	TSharedPtr<FMemoryShareState, ESPMode::ThreadSafe> MemoryShare;
+	FName MemoryShareSender;
+
+	/** bMemoryShare's tick: uploads the newest memory-share frame into OutputRenderTarget */
+	void TickMemoryShare();
+
+	/** Opens SenderName's consumer table if needed and claims or refreshes our slot */
+	void UpdateConsumerRegistration(const ANSICHAR* SenderName);
+	void UnregisterConsumer();
 
 public:	
 	
 	USpoutReceiverActorComponent();
 
+	/** Times the intermediate texture was replaced because the sender changed size or format. */
+	UFUNCTION(BlueprintPure, Category = "Spout")
+	int32 GetReallocationCount() const;
+
+	/** Runs Callback on a worker thread for every frame read back. Null hands frames to DequeueReadback instead. */
+	void SetReadbackCallback(FSpoutReadbackCallback Callback);
+
+	/** Oldest frame read back and not taken yet. Call from a single thread. */
+	bool DequeueReadback(TSharedPtr<FSpoutReadbackFrame, ESPMode::ThreadSafe>& OutFrame);
+
 protected:
 	
 	virtual void BeginPlay() override;
@@ -44,4 +107,58 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout")
 	UTextureRenderTarget2D* OutputRenderTarget = nullptr;
+
+	/** How the receiver tracks its copies on the GPU. A new copy is skipped while the previous one is still in flight. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout")
+	ESpoutSyncMode SyncMode = ESpoutSyncMode::Fence;
+
+	/**
+	 * Only copy when the sender has published a new frame. Needs a sender from this plugin
+	 * (others are copied every tick as before) and a non-empty SubscribeName.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout")
+	bool bOnlyCopyNewFrames = true;
+
+	/**
+	 * Stage frames on a worker thread that sleeps until the sender signals one, instead of
+	 * polling once per tick; each Spout batch copies the newest frame published before it.
+	 * Needs a sender from this plugin and a non-empty SubscribeName; otherwise, and while
+	 * the sender is not found, frames are received on the tick as before.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout")
+	bool bEventDrivenReceive = false;
+
+	/**
+	 * Scaling and colour conversion done on the GPU while writing OutputRenderTarget. Any
+	 * size or format difference is handled here; bit depth follows OutputRenderTarget's format.
+	 * Senders of _SRGB textures are read as their raw encoded values.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout")
+	FSpoutConversionSettings Conversion;
+
+	/**
+	 * Receive the sender's CPU memory share instead of its shared texture, for hosts
+	 * without GPU texture sharing. Needs a sender from this plugin with bMemoryShare and
+	 * a non-empty SubscribeName. OutputRenderTarget is resized to the sender's frames;
+	 * formats that differ are converted on the CPU where a pixel kernel exists, and
+	 * Conversion and readback do not apply.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout")
+	bool bMemoryShare = false;
+
+	/** Also copy every received frame, as written to OutputRenderTarget, back to the CPU. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout|Readback")
+	bool bEnableReadback = false;
+
+	/** Staging textures the readback rotates through. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout|Readback", meta = (ClampMin = "3", ClampMax = "8", EditCondition = "bEnableReadback"))
+	int32 NumReadbackBuffers = 3;
+
+	/** Frames between a readback copy and its map, so the render thread does not wait on the GPU. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout|Readback", meta = (ClampMin = "1", ClampMax = "7", EditCondition = "bEnableReadback"))
+	int32 ReadbackLatency = 2;
+
+	/** Convert 8-bit BGRA, half-float and 10-bit frames to RGBA8 on the CPU as they are read back. Other formats stay as they are. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout|Readback", meta = (EditCondition = "bEnableReadback"))
+	bool bReadbackToRGBA8 = false;
 };
@@ -7,6 +7,7 @@
 #include "Components/ActorComponent.h"
 #include "RHIResources.h"
 #include "RHI.h"
+#include "SpoutTypes.h"
 #include "SpoutSenderActorComponent.generated.h"
 
 // Forward-declare to avoid pulling heavy headers in most translation units
@@ -20,24 +21,80 @@ class UNREALSPOUT_API USpoutSenderActorComponent : public UActorComponent
 	struct SpoutSenderContext;
 	TSharedPtr<SpoutSenderContext> context;
 
+	struct SpoutSenderCounters;
+	TSharedPtr<SpoutSenderCounters, ESPMode::ThreadSafe> counters;
+
+	/** Set by MarkDirty, cleared once the copy has been queued */
+	bool bDirty = true;
+
 public:	
 	// Sets default values for this component's properties
 	USpoutSenderActorComponent();
 
-	/** Access the native texture that Spout broadcasts to. */
+	/**
+	 * Native texture holding the latest frame Spout broadcasts. For reading only: the sender
+	 * writes the other slots of its ring, and this one again once a newer frame is published.
+	 * Game thread.
+	 */
 	ID3D11Texture2D* GetSharedDX11Texture() const;
 
-	/** Same texture wrapped as an RHI resource for RDG. Created on-demand. */
-	FTextureRHIRef GetSharedTextureRHI();
+	/** Same texture as an RHI resource for RDG, wrapped once per slot. Same rules as GetSharedDX11Texture. */
+	FTextureRHIRef GetSharedTextureRHI() const;
+
+	/** Tells the sender OutputTexture has new content. Only needed when bOnlySendWhenDirty is set. */
+	UFUNCTION(BlueprintCallable, Category = "Spout")
+	void MarkDirty();
+
+	/** Frames copied to the shared texture so far. */
+	UFUNCTION(BlueprintPure, Category = "Spout")
+	int64 GetFramesSent() const;
+
+	/** Ticks that did not copy, because nothing changed, nobody was receiving or every shared texture was still in flight. */
+	UFUNCTION(BlueprintPure, Category = "Spout")
+	int64 GetFramesSkipped() const;
+
+	/** Receivers from this plugin currently registered for PublishName. Other Spout receivers are not counted. */
+	UFUNCTION(BlueprintPure, Category = "Spout")
+	int32 GetConsumerCount() const;
+
+	/** Whether Capture lets this sender capture and send this frame. Stable for the rest of the frame. */
+	UFUNCTION(BlueprintCallable, Category = "Spout")
+	bool ShouldCaptureThisFrame();
+
+	/** Runs Callback on a worker thread for every frame read back. Null hands frames to DequeueReadback instead. */
+	void SetReadbackCallback(FSpoutReadbackCallback Callback);
+
+	/** Oldest frame read back and not taken yet. Call from a single thread. */
+	bool DequeueReadback(TSharedPtr<FSpoutReadbackFrame, ESPMode::ThreadSafe>& OutFrame);
 
 private:
-	mutable ID3D11Texture2D* CachedDX11 = nullptr;
-	mutable FTextureRHIRef CachedRHI;
+	/** PublishName's consumer table, opened on first use */
+	mutable TSharedPtr<class FSpoutConsumerTable> ConsumerTable;
+	mutable FName ConsumerTableName;
+
+	/** Handle in the subsystem's capture scheduler; INDEX_NONE while Capture is every frame */
+	int32 CaptureHandle = INDEX_NONE;
+	FSpoutCaptureSettings RegisteredCapture;
+
+	void UnregisterCapture();
+
+	/** CPU readback stage while bEnableReadback is set; the context gets its own reference */
+	TSharedPtr<class FSpoutReadback, ESPMode::ThreadSafe> Readback;
+	FSpoutReadbackCallback ReadbackCallback;
+	bool bReadbackBound = false;
+
+	/** CPU memory share for PublishName while bMemoryShare is set, fed by Readback */
+	TSharedPtr<class FSpoutMemoryShareWriter, ESPMode::ThreadSafe> MemoryShare;
+	FName MemoryShareName;
+
+	/** Opens or drops MemoryShare to match bMemoryShare and PublishName, and hands it to Readback */
+	void UpdateMemoryShare();
 
 protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void OnUnregister() override;
 
 public:	
 	// Called every frame
@@ -48,4 +105,67 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout")
 	UTexture* OutputTexture;
+
+	/** Number of shared textures the sender rotates through, so receivers never read the one being written. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout", meta = (ClampMin = "2", ClampMax = "4"))
+	int32 NumBuffers = 3;
+
+	/** How the sender finds out a copy has finished before advertising it, instead of flushing every frame. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout")
+	ESpoutSyncMode SyncMode = ESpoutSyncMode::Fence;
+
+	/**
+	 * Skip the copy and the sender info update unless MarkDirty was called since the last send.
+	 * For static layers or paused captures; a new OutputTexture resource always sends once.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout")
+	bool bOnlySendWhenDirty = false;
+
+	/**
+	 * Skip the copy while no receiver is registered in this sender's consumer table.
+	 * Only receivers from this plugin register, so leave this off when third-party
+	 * Spout apps need the stream.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout")
+	bool bOnlySendWhenConsumed = false;
+
+	/**
+	 * Capture rate, frame divider and phase. Senders with a rate share one scheduler that
+	 * spreads their captures over different frames; frames off the schedule send nothing.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout")
+	FSpoutCaptureSettings Capture;
+
+	/**
+	 * Also publish every sent frame through CPU shared memory ("<PublishName>_memshare"),
+	 * for receivers that cannot open shared textures. Uses the readback stage, so frames
+	 * arrive ReadbackLatency frames late, in OutputTexture's format.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout")
+	bool bMemoryShare = false;
+
+	/** Also copy every sent frame back to the CPU, for SetReadbackCallback or DequeueReadback. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout|Readback")
+	bool bEnableReadback = false;
+
+	/** Staging textures the readback rotates through. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout|Readback", meta = (ClampMin = "3", ClampMax = "8", EditCondition = "bEnableReadback || bMemoryShare"))
+	int32 NumReadbackBuffers = 3;
+
+	/** Frames between a readback copy and its map, so the render thread does not wait on the GPU. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout|Readback", meta = (ClampMin = "1", ClampMax = "7", EditCondition = "bEnableReadback || bMemoryShare"))
+	int32 ReadbackLatency = 2;
+
+	/** Convert 8-bit BGRA, half-float and 10-bit frames to RGBA8 on the CPU as they are read back. Other formats stay as they are. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout|Readback", meta = (EditCondition = "bEnableReadback"))
+	bool bReadbackToRGBA8 = false;
+
+	/**
+	 * D3D12 RHI: copy on the engine's own command list into the shared textures opened on
+	 * its D3D12 device, tracked with a D3D12 fence, instead of going through 11on12.
+	 * Receivers still get a regular DX11 share handle. Falls back to 11on12 when the driver
+	 * cannot open the shared textures on D3D12.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout", AdvancedDisplay)
+	bool bPreferNativeD3D12 = false;
 };
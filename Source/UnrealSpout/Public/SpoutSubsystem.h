@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "Tickable.h"
+
+#include "SpoutSubsystem.generated.h"
+
+class ISpoutStream;
+class FSpoutCaptureScheduler;
+class FSpoutRenderTargetPool;
+class UTextureRenderTarget2D;
+struct FSpoutCaptureSettings;
+
+/**
+ * Collects every Spout sender and receiver that has work this frame and services
+ * them in a single render command, with one submit per device queue instead of one
+ * render command and one flush per component. Also owns the capture scheduler that
+ * paces senders with their own frame rate, and the render target pool streams
+ * reallocate from.
+ */
+UCLASS()
+class UNREALSPOUT_API USpoutSubsystem : public UEngineSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	static USpoutSubsystem* Get();
+
+	/** Schedules the stream for this frame's batch. Game thread only. */
+	void QueueStream(const TSharedRef<ISpoutStream, ESPMode::ThreadSafe>& Stream);
+
+	/** Adds a sender to the capture scheduler and returns its handle. Game thread only. */
+	int32 RegisterCapture(const FSpoutCaptureSettings& Settings);
+	void UpdateCapture(int32 Handle, const FSpoutCaptureSettings& Settings);
+	void UnregisterCapture(int32 Handle);
+
+	/** Whether the sender captures this frame. The first query of a frame schedules it. */
+	bool ShouldCapture(int32 Handle);
+
+	/** A render target of this size and format, reused from an earlier release when possible. Game thread only. */
+	UTextureRenderTarget2D* AcquireRenderTarget(const FIntPoint& Size, EPixelFormat Format);
+
+	/** Hands a render target from AcquireRenderTarget back to the pool. Stop using it first. */
+	void ReleaseRenderTarget(UTextureRenderTarget2D* RenderTarget);
+
+	/** Names of the senders from this plugin running on this machine, in any process. Read from the shared sender directory only when it changed. */
+	UFUNCTION(BlueprintCallable, Category = "Spout")
+	TArray<FName> GetSenderNames();
+
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
+	virtual void Deinitialize() override;
+
+	/* -------- FTickableGameObject -------- */
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	/** Conditional so the class default object, which is never initialized, does not tick. */
+	virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Conditional; }
+	virtual bool IsTickable() const override { return !HasAnyFlags(RF_ClassDefaultObject); }
+	virtual bool IsTickableInEditor() const override { return true; }
+	virtual bool IsTickableWhenPaused() const override { return true; }
+
+private:
+	/** Sends everything queued so far to the render thread as one batch. */
+	void FlushBatch();
+
+	TArray<TSharedRef<ISpoutStream, ESPMode::ThreadSafe>> PendingStreams;
+
+	TSharedPtr<FSpoutCaptureScheduler> CaptureScheduler;
+	uint64 ScheduledFrame = MAX_uint64;
+
+	TSharedPtr<FSpoutRenderTargetPool> RenderTargetPool;
+
+	/** GetSenderNames' last answer and the directory generation it was read at */
+	TArray<FName> SenderNames;
+	uint64 SenderNamesGeneration = MAX_uint64;
+};
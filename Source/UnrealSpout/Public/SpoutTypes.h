@@ -0,0 +1,157 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PixelFormat.h"
+
+#include "SpoutTypes.generated.h"
+
+/** How a Spout context tells that the GPU has finished a frame, instead of flushing every tick. */
+UENUM(BlueprintType)
+enum class ESpoutSyncMode : uint8
+{
+	/** ID3D11Fence signalled with the frame number. Falls back to EventQuery if the device has no fence support. */
+	Fence,
+	/** D3D11 event query polled without flushing. Works on every D3D11 device. */
+	EventQuery,
+	/** Assume the copy is done as soon as it has been queued. */
+	None,
+};
+
+/** Pixel format a sender publishes. Smaller formats cut shared-texture size and copy bandwidth. */
+UENUM(BlueprintType)
+enum class ESpoutOutputFormat : uint8
+{
+	/** 16-bit float RGBA, 8 bytes per pixel. Keeps HDR. */
+	RGBA16F,
+	/** 8-bit BGRA, 4 bytes per pixel. Values are stored as-is; use LinearToSRGB for display-referred output. */
+	BGRA8,
+	/** 10-bit RGB with 2-bit alpha, 4 bytes per pixel. */
+	RGB10A2,
+};
+
+/** Where AViewportSpoutSender takes its frames from. */
+UENUM(BlueprintType)
+enum class ESpoutViewportSource : uint8
+{
+	/** Renders the scene a second time through the actor's SceneCapture component. */
+	SceneCapture,
+	/** The player's own view right after tonemapping, before the UI. No second render. */
+	PostTonemap,
+	/** The game window's back buffer, UI included, just before it is presented. No second render. */
+	Backbuffer,
+};
+
+/** How a Spout conversion pass samples the source when input and output sizes differ. */
+UENUM(BlueprintType)
+enum class ESpoutResampleFilter : uint8
+{
+	/** Nearest texel. */
+	Point,
+	/** Hardware bilinear filtering. Fine for upscaling and small reductions. */
+	Bilinear,
+	/** Averages every source texel under the output pixel (up to 8x8). Use for large downscales. */
+	Box,
+};
+
+/** Transfer-function change applied by a Spout conversion pass. */
+UENUM(BlueprintType)
+enum class ESpoutColorConversion : uint8
+{
+	None,
+	/** Decode sRGB-encoded values to linear. */
+	SRGBToLinear,
+	/** Encode linear values as sRGB. */
+	LinearToSRGB,
+};
+
+/**
+ * Per-stream conversion done in a single GPU pass. Bit depth (8-bit / 16f / 32f) follows
+ * the destination texture's format; the render target write converts it.
+ */
+USTRUCT(BlueprintType)
+struct FSpoutConversionSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout")
+	ESpoutResampleFilter Filter = ESpoutResampleFilter::Bilinear;
+
+	/** Swap red and blue, i.e. BGRA <-> RGBA. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout")
+	bool bSwapRedBlue = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout")
+	ESpoutColorConversion ColorConversion = ESpoutColorConversion::None;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout")
+	bool bFlipVertically = false;
+
+	/** True when the pass would only resample; same-size, same-format streams can then use a plain copy. */
+	bool IsColorIdentity() const
+	{
+		return !bSwapRedBlue && ColorConversion == ESpoutColorConversion::None && !bFlipVertically;
+	}
+
+	bool operator==(const FSpoutConversionSettings& Other) const
+	{
+		return Filter == Other.Filter
+			&& bSwapRedBlue == Other.bSwapRedBlue
+			&& ColorConversion == Other.ColorConversion
+			&& bFlipVertically == Other.bFlipVertically;
+	}
+
+	bool operator!=(const FSpoutConversionSettings& Other) const { return !(*this == Other); }
+};
+
+/** When a sender captures and sends, independent of the game frame rate. */
+USTRUCT(BlueprintType)
+struct FSpoutCaptureSettings
+{
+	GENERATED_BODY()
+
+	/** Captures per second. 0 = every frame the other settings allow. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout", meta = (ClampMin = "0"))
+	float TargetFps = 0.0f;
+
+	/** Only consider every Nth game frame. 1 = every frame. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout", meta = (ClampMin = "1"))
+	int32 EveryNth = 1;
+
+	/** Let the scheduler pick the phase, spreading senders with the same rate over different frames. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout")
+	bool bAutoPhase = true;
+
+	/** Offset within the capture period, as a fraction of it. Used when bAutoPhase is off. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spout", meta = (ClampMin = "0", ClampMax = "1", EditCondition = "!bAutoPhase"))
+	float PhaseOffset = 0.0f;
+
+	/** Captures on every frame: the scheduler can be bypassed. */
+	bool IsEveryFrame() const { return TargetFps <= 0.0f && EveryNth <= 1; }
+
+	bool operator==(const FSpoutCaptureSettings& Other) const
+	{
+		return TargetFps == Other.TargetFps
+			&& EveryNth == Other.EveryNth
+			&& bAutoPhase == Other.bAutoPhase
+			&& PhaseOffset == Other.PhaseOffset;
+	}
+
+	bool operator!=(const FSpoutCaptureSettings& Other) const { return !(*this == Other); }
+};
+
+/** A frame copied back to the CPU by a Spout readback. Reused once every reference to it is dropped. */
+struct FSpoutReadbackFrame
+{
+	/** Rows of RowPitch bytes each, Size.Y of them. */
+	TArray<uint8> Data;
+	uint32 RowPitch = 0;
+	FIntPoint Size = FIntPoint::ZeroValue;
+	EPixelFormat Format = PF_Unknown;
+	/** Counts readback copies, so gaps show dropped frames. */
+	uint64 FrameNumber = 0;
+};
+
+using FSpoutReadbackFrameRef = TSharedRef<FSpoutReadbackFrame, ESPMode::ThreadSafe>;
+
+/** Receives readback frames on a worker thread, one call at a time, in frame order. */
+using FSpoutReadbackCallback = TFunction<void(const FSpoutReadbackFrameRef&)>;
@@ -4,6 +4,8 @@
 
 #include "Modules/ModuleManager.h"
 
+DECLARE_LOG_CATEGORY_EXTERN(LogUnrealSpout, Log, All);
+
 class FUnrealSpoutModule : public IModuleInterface
 {
 public:
@@ -4,6 +4,7 @@
 #include "GameFramework/Actor.h"
 #include "SceneViewExtension.h"
 #include "SpoutCopyViewExtension.h"
+#include "SpoutTypes.h"
 #include "ViewportSpoutSender.generated.h"
 
 class USceneCaptureComponent2D;
@@ -23,15 +24,27 @@ public:
    AViewportSpoutSender();
 
    UTextureRenderTarget2D* GetCaptureRenderTarget() const { return ViewRT; }
+   /** Reduced copy of ViewRT that is actually published, or null when ViewRT is sent as-is. */
+   UTextureRenderTarget2D* GetOutputRenderTarget() const { return OutputRT; }
+   const FSpoutConversionSettings& GetOutputConversion() const { return OutputConversion; }
+   ESpoutViewportSource GetSource() const { return Source; }
+   /** False on frames nothing is sent: nobody is receiving a demand-driven sender, or its capture schedule skips the frame. */
+   bool IsPublishing() const { return bPublishing; }
    USpoutSenderActorComponent* GetSpoutSender() const { return SpoutSender; }
 
 protected:
    virtual void BeginPlay() override;
    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
+public:
+   virtual void Tick(float DeltaSeconds) override;
+
 private:
    void ValidateOrCreateRT();
+   void ReleaseRTs();
    void SyncToPlayerCamera() const;
+   /** Sends this frame's render-targets and publishing state to ViewExt's render-thread hooks. */
+   void UpdateViewExtension() const;
 
    UPROPERTY(VisibleAnywhere)
    USceneComponent* Root;
@@ -45,16 +58,48 @@ private:
    UPROPERTY(Transient)
    UTextureRenderTarget2D* ViewRT = nullptr;
 
+   UPROPERTY(Transient)
+   UTextureRenderTarget2D* OutputRT = nullptr;
+
    UPROPERTY(EditAnywhere, Category="Spout")
    FName PublishName = TEXT("Viewport");
 
-   /** If true the SceneCapture component captures every frame internally.
-       If false we call CaptureScene() manually in Tick.  */
+   /** Where frames come from. PostTonemap and Backbuffer reuse the player's view and switch the SceneCapture off. */
+   UPROPERTY(EditAnywhere, Category="Spout")
+   ESpoutViewportSource Source = ESpoutViewportSource::SceneCapture;
+
+   /** Published width. 0 = viewport width, or derived from OutputHeight keeping the aspect ratio. */
+   UPROPERTY(EditAnywhere, Category="Spout", meta=(ClampMin="0"))
+   int32 OutputWidth = 0;
+
+   /** Published height. 0 = viewport height, or derived from OutputWidth keeping the aspect ratio. */
+   UPROPERTY(EditAnywhere, Category="Spout", meta=(ClampMin="0"))
+   int32 OutputHeight = 0;
+
+   /** Published pixel format. The capture itself stays RGBA16F. */
+   UPROPERTY(EditAnywhere, Category="Spout")
+   ESpoutOutputFormat OutputFormat = ESpoutOutputFormat::RGBA16F;
+
+   /** Applied while reducing the capture to the published size and format. */
+   UPROPERTY(EditAnywhere, Category="Spout")
+   FSpoutConversionSettings OutputConversion;
+
+   /** Frames a new viewport size must hold before the render targets are reallocated. */
+   UPROPERTY(EditAnywhere, Category="Spout", meta=(ClampMin="1"))
+   int32 ResizeSettleFrames = 8;
+
+   /** If true the SceneCapture component captures every frame internally and the
+       sender's capture schedule only paces the sends.
+       If false we call CaptureScene() manually in Tick, only on scheduled frames.  */
    UPROPERTY(EditAnywhere, Category="Capture")
    bool bAutoCapture = true;
 
+   bool bPublishing = true;
+
    int32 LastW = 0;
    int32 LastH = 0;
 
+   TSharedPtr<class FSpoutResizeDetector> ResizeDetector;
+
    TSharedPtr<FSpoutCopyViewExtension, ESPMode::ThreadSafe> ViewExt;
 }; 
\ No newline at end of file
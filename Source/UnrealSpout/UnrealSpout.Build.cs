@@ -85,9 +85,11 @@ public class UnrealSpout : ModuleRules
 				"Slate",
 				"SlateCore",
 				"RenderCore",
+				"Renderer",
 				"RHI",
 				"Projects",
 				"D3D11RHI",
+				"D3D12RHI",
 				"Media",
 				// ... add private dependencies that you statically link with here ...	
 			}
@@ -104,6 +106,11 @@ public class UnrealSpout : ModuleRules
 		if ((Target.Platform == UnrealTargetPlatform.Win64))
 		{
 			string PlatformString = (Target.Platform == UnrealTargetPlatform.Win64) ? "amd64" : "x86";
+
+			// ID3D11DynamicRHI/ID3D12DynamicRHI to wrap shared textures as RHI textures
+			AddEngineThirdPartyPrivateStaticDependencies(Target, "DX11");
+			AddEngineThirdPartyPrivateStaticDependencies(Target, "DX12");
+
 			PublicAdditionalLibraries.Add(Path.Combine(ThirdPartyPath, "Spout/lib", PlatformString, "Spout.lib"));
 
 			string pluginDLLPath = Path.Combine(ThirdPartyPath, "Spout/lib", PlatformString, "Spout.dll");